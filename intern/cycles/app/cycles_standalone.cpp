@@ -8,6 +8,7 @@
 #include "scene/camera.h"
 #include "scene/integrator.h"
 #include "scene/scene.h"
+#include "scene/stats.h"
 #include "session/buffers.h"
 #include "session/session.h"
 
@@ -48,6 +49,7 @@ struct Options {
   bool show_help, interactive, pause;
   string output_filepath;
   string output_pass;
+  string profile_json_filepath;
 } options;
 
 static void session_print(const string &str)
@@ -164,9 +166,28 @@ static void session_init()
   options.session->start();
 }
 
+static void session_print_statistics()
+{
+  RenderStats stats;
+  options.session->collect_statistics(&stats);
+
+  if (!options.profile_json_filepath.empty()) {
+    string report = stats.json_report();
+    if (!path_write_text(options.profile_json_filepath, report)) {
+      fprintf(stderr, "Failed to write statistics to %s\n", options.profile_json_filepath.c_str());
+    }
+  }
+  else {
+    printf("\nRender statistics:\n%s\n", stats.full_report().c_str());
+  }
+}
+
 static void session_exit()
 {
   if (options.session) {
+    if (options.session_params.use_profiling) {
+      session_print_statistics();
+    }
     options.session.reset();
   }
 
@@ -442,6 +463,9 @@ static void options_parse(const int argc, const char **argv)
   });
   ap.arg("--list-devices", &list).help("List information about all available devices");
   ap.arg("--profile", &profile).help("Enable profile logging");
+  ap.arg("--profile-json %s:FILE")
+      .help("Enable profiling and write render statistics as JSON to file")
+      .action([&](auto argv) { parse_string(argv, &options.profile_json_filepath); });
 #ifdef WITH_CYCLES_LOGGING
   ap.arg("--debug", &debug).help("Enable debug logging");
   ap.arg("--verbose %d:VERBOSE").help("Set verbosity of the logger").action([&](auto argv) {
@@ -484,7 +508,7 @@ static void options_parse(const int argc, const char **argv)
     exit(EXIT_SUCCESS);
   }
 
-  options.session_params.use_profiling = profile;
+  options.session_params.use_profiling = profile || !options.profile_json_filepath.empty();
 
   if (ssname == "osl") {
     options.scene_params.shadingsystem = SHADINGSYSTEM_OSL;
@@ -926,6 +926,12 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         description="Use compact BVH structure (uses less ram but renders slower)",
         default=False,
     )
+    debug_use_bvh_disk_cache: BoolProperty(
+        name="Use BVH Disk Cache",
+        description="Store BVHs on disk and reuse them in later renders of the same geometry and objects, "
+        "to reduce synchronization time for static scenes. Only used when Cycles builds its own BVH",
+        default=False,
+    )
     debug_bvh_time_steps: IntProperty(
         name="BVH Time Steps",
         description="Split BVH primitives by this number of time steps to speed up render time in cost of memory",
@@ -1014,6 +1020,22 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         items=enum_texture_limit
     )
 
+    texture_memory_limit: IntProperty(
+        name="Viewport Texture Memory Limit",
+        default=0,
+        description="Downscale the largest image textures used by viewport rendering until they fit "
+        "in this amount of memory in megabytes, reducing their quality. 0 means unlimited",
+        min=0,
+    )
+
+    texture_memory_limit_render: IntProperty(
+        name="Render Texture Memory Limit",
+        default=0,
+        description="Downscale the largest image textures used by final rendering until they fit "
+        "in this amount of memory in megabytes, reducing their quality. 0 means unlimited",
+        min=0,
+    )
+
     use_fast_gi: BoolProperty(
         name="Fast GI Approximation",
         description="Approximate diffuse indirect light with background tinted ambient occlusion. "
@@ -1053,6 +1075,13 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         description="",
         min=8, max=8192,
     )
+    use_half_float_tiles: BoolProperty(
+        name="Half Float Tile Files",
+        description="Store light and color passes of tiles cached to disk at half float precision, "
+        "reducing the disk space and write time of tiled renders with many passes. "
+        "Render buffers in memory keep full float precision",
+        default=False,
+    )
 
     # Various fine-tuning debug flags
 
@@ -1061,6 +1090,7 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         scene = context.scene.as_pointer()
         return _cycles.debug_flags_update(scene)
 
+    debug_use_cpu_avx512: BoolProperty(name="AVX512", default=True)
     debug_use_cpu_avx2: BoolProperty(name="AVX2", default=True)
     debug_use_cpu_sse42: BoolProperty(name="SSE42", default=True)
     debug_bvh_layout: EnumProperty(
@@ -1068,6 +1098,12 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         items=enum_bvh_layouts,
         default='EMBREE',
     )
+    debug_use_cpu_wavefront: BoolProperty(
+        name="Wavefront",
+        description="Advance batches of paths one kernel at a time, sorted by kernel and shader, "
+        "instead of tracing every path to completion",
+        default=False,
+    )
 
     adaptive_compile_description = "Compile the Cycles GPU kernel with only the feature set required for the current scene"
 
@@ -861,6 +861,7 @@ SceneParams BlenderSync::get_scene_params(BL::Scene &b_scene,
   params.use_bvh_spatial_split = RNA_boolean_get(&cscene, "debug_use_spatial_splits");
   params.use_bvh_compact_structure = RNA_boolean_get(&cscene, "debug_use_compact_bvh");
   params.use_bvh_unaligned_nodes = RNA_boolean_get(&cscene, "debug_use_hair_bvh");
+  params.use_bvh_disk_cache = RNA_boolean_get(&cscene, "debug_use_bvh_disk_cache");
   params.num_bvh_time_steps = RNA_int_get(&cscene, "debug_bvh_time_steps");
 
   PointerRNA csscene = RNA_pointer_get(&b_scene.ptr, "cycles_curves");
@@ -869,11 +870,14 @@ SceneParams BlenderSync::get_scene_params(BL::Scene &b_scene,
       csscene, "shape", CURVE_NUM_SHAPE_TYPES, CURVE_THICK);
 
   int texture_limit;
+  int texture_memory_limit;
   if (background) {
     texture_limit = RNA_enum_get(&cscene, "texture_limit_render");
+    texture_memory_limit = get_int(cscene, "texture_memory_limit_render");
   }
   else {
     texture_limit = RNA_enum_get(&cscene, "texture_limit");
+    texture_memory_limit = get_int(cscene, "texture_memory_limit");
   }
   if (texture_limit > 0 && b_scene.render().use_simplify()) {
     params.texture_limit = 1 << (texture_limit + 6);
@@ -881,6 +885,12 @@ SceneParams BlenderSync::get_scene_params(BL::Scene &b_scene,
   else {
     params.texture_limit = 0;
   }
+  if (texture_memory_limit > 0 && b_scene.render().use_simplify()) {
+    params.texture_memory_limit = size_t(texture_memory_limit) * 1024 * 1024;
+  }
+  else {
+    params.texture_memory_limit = 0;
+  }
 
   params.bvh_layout = DebugFlags().cpu.bvh_layout;
 
@@ -985,6 +995,7 @@ SessionParams BlenderSync::get_session_params(BL::RenderEngine &b_engine,
   if (background) {
     params.use_auto_tile = RNA_boolean_get(&cscene, "use_auto_tile");
     params.tile_size = max(get_int(cscene, "tile_size"), 8);
+    params.use_half_float_tile_passes = RNA_boolean_get(&cscene, "use_half_float_tiles");
   }
   else {
     params.use_auto_tile = false;
@@ -6,6 +6,8 @@
  * Adapted code from NVIDIA Corporation. */
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 
 #include "bvh/bvh2.h"
 
@@ -18,10 +20,304 @@
 #include "bvh/node.h"
 #include "bvh/unaligned.h"
 
+#include "util/log.h"
+#include "util/md5.h"
+#include "util/path.h"
 #include "util/progress.h"
+#include "util/system.h"
 
 CCL_NAMESPACE_BEGIN
 
+/* Persistent BVH Cache
+ *
+ * Geometry level BVHs are stored on disk, keyed by a hash of the geometry and build parameters,
+ * so that renders of the same static geometry can skip the build. */
+
+/* Increase when the file layout or packed node format changes. */
+static const uint32_t BVH2_CACHE_VERSION = 2;
+/* Maximum number of cached BVHs, least recently used ones are removed first. */
+static const size_t BVH2_CACHE_MAX_FILES = 1024;
+/* Whether files were added to the cache since old ones were last removed. */
+static std::atomic<bool> bvh2_cache_written = false;
+
+struct BVH2CacheHeader {
+  char magic[4];
+  uint32_t version;
+  int32_t root_index;
+  uint32_t pad;
+  uint64_t sizes[8];
+};
+
+template<typename T> static void bvh2_cache_hash_array(MD5Hash &md5, const T &data)
+{
+  const uint64_t size = data.size();
+  md5.append((const uint8_t *)&size, sizeof(size));
+
+  /* MD5Hash::append takes an int size, so hash large arrays in chunks. */
+  const uint8_t *bytes = (const uint8_t *)data.data();
+  const size_t num_bytes = data.size() * sizeof(*data.data());
+  const size_t chunk_size = 1 << 30;
+  for (size_t offset = 0; offset < num_bytes; offset += chunk_size) {
+    md5.append(bytes + offset, int(min(chunk_size, num_bytes - offset)));
+  }
+}
+
+template<typename T> static void bvh2_cache_hash_value(MD5Hash &md5, const T value)
+{
+  md5.append((const uint8_t *)&value, sizeof(value));
+}
+
+static void bvh2_cache_hash_params(MD5Hash &md5, const BVHParams &params)
+{
+  bvh2_cache_hash_value(md5, BVH2_CACHE_VERSION);
+
+  bvh2_cache_hash_value(md5, params.top_level);
+  bvh2_cache_hash_value(md5, params.use_spatial_split);
+  bvh2_cache_hash_value(md5, params.spatial_split_alpha);
+  bvh2_cache_hash_value(md5, params.unaligned_split_threshold);
+  bvh2_cache_hash_value(md5, params.sah_node_cost);
+  bvh2_cache_hash_value(md5, params.sah_primitive_cost);
+  bvh2_cache_hash_value(md5, params.min_leaf_size);
+  bvh2_cache_hash_value(md5, params.max_triangle_leaf_size);
+  bvh2_cache_hash_value(md5, params.max_motion_triangle_leaf_size);
+  bvh2_cache_hash_value(md5, params.max_curve_leaf_size);
+  bvh2_cache_hash_value(md5, params.max_motion_curve_leaf_size);
+  bvh2_cache_hash_value(md5, params.max_point_leaf_size);
+  bvh2_cache_hash_value(md5, params.max_motion_point_leaf_size);
+  bvh2_cache_hash_value(md5, params.use_unaligned_nodes);
+  bvh2_cache_hash_value(md5, params.num_motion_triangle_steps);
+  bvh2_cache_hash_value(md5, params.num_motion_curve_steps);
+  bvh2_cache_hash_value(md5, params.num_motion_point_steps);
+  bvh2_cache_hash_value(md5, params.curve_subdivisions);
+  bvh2_cache_hash_value(md5, params.bvh_layout);
+}
+
+static void bvh2_cache_hash_geometry(MD5Hash &md5, const Geometry *geom)
+{
+  bvh2_cache_hash_value(md5, geom->geometry_type);
+  bvh2_cache_hash_value(md5, geom->has_motion_blur());
+  bvh2_cache_hash_value(md5, geom->get_motion_steps());
+
+  if (geom->is_mesh() || geom->is_volume()) {
+    const Mesh *mesh = static_cast<const Mesh *>(geom);
+    bvh2_cache_hash_array(md5, mesh->get_verts());
+    bvh2_cache_hash_array(md5, mesh->get_triangles());
+  }
+  else if (geom->is_hair()) {
+    const Hair *hair = static_cast<const Hair *>(geom);
+    bvh2_cache_hash_value(md5, hair->curve_shape);
+    bvh2_cache_hash_array(md5, hair->get_curve_keys());
+    bvh2_cache_hash_array(md5, hair->get_curve_radius());
+    bvh2_cache_hash_array(md5, hair->get_curve_first_key());
+  }
+  else if (geom->is_pointcloud()) {
+    const PointCloud *pointcloud = static_cast<const PointCloud *>(geom);
+    bvh2_cache_hash_array(md5, pointcloud->get_points());
+    bvh2_cache_hash_array(md5, pointcloud->get_radius());
+  }
+
+  if (geom->has_motion_blur()) {
+    const Attribute *attr_mP = geom->attributes.find(ATTR_STD_MOTION_VERTEX_POSITION);
+    if (attr_mP) {
+      bvh2_cache_hash_array(md5, attr_mP->buffer);
+    }
+  }
+}
+
+/* The key covers everything which ends up in the packed arrays: the build parameters, the
+ * primitives of the geometry and the objects, whose index and visibility are stored in the
+ * primitive and node data. */
+static string bvh2_cache_key(const BVHParams &params,
+                             Geometry *geom,
+                             const vector<Object *> &objects)
+{
+  MD5Hash md5;
+  bvh2_cache_hash_params(md5, params);
+
+  bvh2_cache_hash_value(md5, uint64_t(objects.size()));
+  for (const Object *object : objects) {
+    bvh2_cache_hash_value(md5, object->get_geometry() == geom);
+    bvh2_cache_hash_value(md5, object->visibility_for_tracing());
+  }
+
+  bvh2_cache_hash_geometry(md5, geom);
+
+  return md5.get_hex();
+}
+
+/* The top level BVH contains the primitives of geometry with the object transform applied, the
+ * bounds of instanced objects and a copy of the BVH of every instanced geometry. The object
+ * transforms only enter through the bounds and the transformed primitives, so they don't need to
+ * be hashed separately. Returns an empty key if the BVH of an instanced geometry is not cached
+ * itself, since its packed arrays would have to be hashed then. */
+static string bvh2_cache_top_level_key(const BVHParams &params,
+                                       const vector<Geometry *> &geometry,
+                                       const vector<Object *> &objects)
+{
+  MD5Hash md5;
+  bvh2_cache_hash_params(md5, params);
+
+  unordered_map<const Geometry *, int> geometry_index;
+  bvh2_cache_hash_value(md5, uint64_t(geometry.size()));
+  for (size_t i = 0; i < geometry.size(); i++) {
+    const Geometry *geom = geometry[i];
+    geometry_index[geom] = int(i);
+    bvh2_cache_hash_value(md5, geom->prim_offset);
+    bvh2_cache_hash_value(md5, geom->is_instanced());
+    if (geom->need_build_bvh(params.bvh_layout)) {
+      const BVH2 *bvh = static_cast<const BVH2 *>(geom->bvh.get());
+      if (bvh == nullptr || bvh->disk_cache_key.empty()) {
+        return "";
+      }
+      md5.append(bvh->disk_cache_key);
+    }
+    else {
+      bvh2_cache_hash_geometry(md5, geom);
+    }
+  }
+
+  bvh2_cache_hash_value(md5, uint64_t(objects.size()));
+  for (const Object *object : objects) {
+    bvh2_cache_hash_value(md5, geometry_index[object->get_geometry()]);
+    bvh2_cache_hash_value(md5, object->is_traceable());
+    bvh2_cache_hash_value(md5, object->visibility_for_tracing());
+    /* Hash the components, #float3 may have an uninitialized padding value. */
+    for (const float3 &co : {object->bounds.min, object->bounds.max}) {
+      bvh2_cache_hash_value(md5, co.x);
+      bvh2_cache_hash_value(md5, co.y);
+      bvh2_cache_hash_value(md5, co.z);
+    }
+  }
+
+  return md5.get_hex();
+}
+
+template<typename T> static void bvh2_cache_write_array(vector<uint8_t> &binary, const array<T> &data)
+{
+  const uint8_t *bytes = (const uint8_t *)data.data();
+  binary.insert(binary.end(), bytes, bytes + data.size() * sizeof(T));
+}
+
+template<typename T>
+static bool bvh2_cache_read_array(const vector<uint8_t> &binary,
+                                  size_t &offset,
+                                  const uint64_t size,
+                                  array<T> &data)
+{
+  const size_t num_bytes = size * sizeof(T);
+  if (offset + num_bytes > binary.size()) {
+    return false;
+  }
+  data.resize(size);
+  if (num_bytes) {
+    memcpy(data.data(), binary.data() + offset, num_bytes);
+  }
+  offset += num_bytes;
+  return true;
+}
+
+static bool bvh2_cache_read(const string &filepath, PackedBVH &pack)
+{
+  vector<uint8_t> binary;
+  if (!path_cache_kernel_exists_and_mark_used(filepath) || !path_read_binary(filepath, binary)) {
+    return false;
+  }
+
+  BVH2CacheHeader header;
+  if (binary.size() < sizeof(header)) {
+    return false;
+  }
+  memcpy(&header, binary.data(), sizeof(header));
+  if (memcmp(header.magic, "BVH2", 4) != 0 || header.version != BVH2_CACHE_VERSION) {
+    return false;
+  }
+
+  size_t offset = sizeof(header);
+  PackedBVH cached_pack;
+  cached_pack.root_index = header.root_index;
+  if (!(bvh2_cache_read_array(binary, offset, header.sizes[0], cached_pack.nodes) &&
+        bvh2_cache_read_array(binary, offset, header.sizes[1], cached_pack.leaf_nodes) &&
+        bvh2_cache_read_array(binary, offset, header.sizes[2], cached_pack.object_node) &&
+        bvh2_cache_read_array(binary, offset, header.sizes[3], cached_pack.prim_type) &&
+        bvh2_cache_read_array(binary, offset, header.sizes[4], cached_pack.prim_visibility) &&
+        bvh2_cache_read_array(binary, offset, header.sizes[5], cached_pack.prim_index) &&
+        bvh2_cache_read_array(binary, offset, header.sizes[6], cached_pack.prim_object) &&
+        bvh2_cache_read_array(binary, offset, header.sizes[7], cached_pack.prim_time)) ||
+      offset != binary.size())
+  {
+    /* Truncated or otherwise corrupt file, rebuild and overwrite it. */
+    VLOG_WARNING << "Ignoring invalid BVH cache file " << filepath;
+    return false;
+  }
+
+  pack = std::move(cached_pack);
+  return true;
+}
+
+static void bvh2_cache_write(const string &filepath, const PackedBVH &pack)
+{
+  BVH2CacheHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, "BVH2", 4);
+  header.version = BVH2_CACHE_VERSION;
+  header.root_index = pack.root_index;
+  header.sizes[0] = pack.nodes.size();
+  header.sizes[1] = pack.leaf_nodes.size();
+  header.sizes[2] = pack.object_node.size();
+  header.sizes[3] = pack.prim_type.size();
+  header.sizes[4] = pack.prim_visibility.size();
+  header.sizes[5] = pack.prim_index.size();
+  header.sizes[6] = pack.prim_object.size();
+  header.sizes[7] = pack.prim_time.size();
+
+  vector<uint8_t> binary;
+  binary.insert(binary.end(), (const uint8_t *)&header, (const uint8_t *)(&header + 1));
+  bvh2_cache_write_array(binary, pack.nodes);
+  bvh2_cache_write_array(binary, pack.leaf_nodes);
+  bvh2_cache_write_array(binary, pack.object_node);
+  bvh2_cache_write_array(binary, pack.prim_type);
+  bvh2_cache_write_array(binary, pack.prim_visibility);
+  bvh2_cache_write_array(binary, pack.prim_index);
+  bvh2_cache_write_array(binary, pack.prim_object);
+  bvh2_cache_write_array(binary, pack.prim_time);
+
+  /* Write to a unique temporary file outside of the cache directory, then move it in place with
+   * an atomic rename. Concurrent renders reading the cache only ever see complete files, and the
+   * removal of old files in #BVH2::disk_cache_clear_old never touches a file which is still being
+   * written.
+   *
+   * A file removed while another render is reading it stays readable on POSIX systems, and fails
+   * to be removed on Windows; when it is removed before being opened the read fails and that
+   * render rebuilds the BVH. */
+  static std::atomic<uint64_t> temp_file_counter = 0;
+  const string temp_filepath = path_cache_get(
+      path_join("bvh_tmp",
+                path_filename(filepath) + "." + to_string(system_self_process_id()) + "." +
+                    to_string(temp_file_counter++)));
+
+  if (!path_write_binary(temp_filepath, binary)) {
+    path_remove(temp_filepath);
+    return;
+  }
+  path_create_directories(filepath);
+  if (!path_rename(temp_filepath, filepath)) {
+    path_remove(temp_filepath);
+    return;
+  }
+
+  path_cache_kernel_exists_and_mark_used(filepath);
+  bvh2_cache_written = true;
+}
+
+void BVH2::disk_cache_clear_old()
+{
+  /* Scanning the cache directory is slow with many files, so it is only done once after all BVHs
+   * of a scene were built, and only if any of them was added to the cache. */
+  if (bvh2_cache_written.exchange(false)) {
+    path_cache_clear_old(path_cache_get("bvh"), BVH2_CACHE_MAX_FILES);
+  }
+}
+
 BVHStackEntry::BVHStackEntry(const BVHNode *n, const int i) : node(n), idx(i) {}
 
 int BVHStackEntry::encodeIdx() const
@@ -38,6 +334,27 @@ BVH2::BVH2(const BVHParams &params_,
 
 void BVH2::build(Progress &progress, Stats * /*unused*/)
 {
+  string cache_filepath;
+  disk_cache_key.clear();
+  if (params.use_disk_cache) {
+    progress.set_substatus("Looking up BVH in cache");
+    if (params.top_level) {
+      disk_cache_key = bvh2_cache_top_level_key(params, geometry, objects);
+    }
+    else if (geometry.size() == 1) {
+      disk_cache_key = bvh2_cache_key(params, geometry[0], objects);
+    }
+  }
+  if (!disk_cache_key.empty()) {
+    cache_filepath = path_cache_get(path_join("bvh", disk_cache_key));
+
+    if (bvh2_cache_read(cache_filepath, pack)) {
+      VLOG_WORK << "Loaded " << (params.top_level ? "scene" : geometry[0]->name.c_str())
+                << " BVH from cache " << cache_filepath;
+      return;
+    }
+  }
+
   progress.set_substatus("Building BVH");
 
   /* build nodes */
@@ -73,10 +390,17 @@ void BVH2::build(Progress &progress, Stats * /*unused*/)
   /* pack nodes */
   progress.set_substatus("Packing BVH nodes");
   pack_nodes(root.get());
+
+  if (!cache_filepath.empty() && !progress.get_cancel()) {
+    bvh2_cache_write(cache_filepath, pack);
+  }
 }
 
 void BVH2::refit(Progress &progress)
 {
+  /* The refitted BVH no longer matches the cached one. */
+  disk_cache_key.clear();
+
   progress.set_substatus("Packing BVH primitives");
   pack_primitives();
 
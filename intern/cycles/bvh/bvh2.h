@@ -10,6 +10,7 @@
 #include "bvh/bvh.h"
 #include "bvh/params.h"
 
+#include "util/string.h"
 #include "util/types.h"
 #include "util/unique_ptr.h"
 #include "util/vector.h"
@@ -44,8 +45,15 @@ class BVH2 : public BVH {
   void build(Progress &progress, Stats *stats);
   void refit(Progress &progress);
 
+  /* Remove the least recently used BVHs from the disk cache, if any were added since the last
+   * call. Called after all BVHs of a scene were built. */
+  static void disk_cache_clear_old();
+
   PackedBVH pack;
 
+  /* Key of the BVH in the disk cache, empty if it is not cached. */
+  string disk_cache_key;
+
  protected:
   /* Building process. */
   virtual unique_ptr<BVHNode> widen_children_nodes(unique_ptr<BVHNode> &&root);
@@ -107,6 +107,9 @@ class BVHParams {
   /* These are needed for Embree. */
   int curve_subdivisions;
 
+  /* Store BVH2 on disk, and reuse it for identical geometry and objects in later renders. */
+  bool use_disk_cache;
+
   /* fixed parameters */
   enum { MAX_DEPTH = 64, MAX_SPATIAL_DEPTH = 48, NUM_SPATIAL_BINS = 32 };
 
@@ -139,6 +142,8 @@ class BVHParams {
     num_motion_triangle_steps = 0;
     num_motion_point_steps = 0;
 
+    use_disk_cache = false;
+
     bvh_type = 0;
 
     curve_subdivisions = 4;
@@ -49,8 +49,9 @@ void device_cpu_info(vector<DeviceInfo> &devices)
 string device_cpu_capabilities()
 {
   string capabilities;
-  capabilities += system_cpu_support_avx2() ? "AVX2" : "";
-  if (capabilities[capabilities.size() - 1] == ' ') {
+  capabilities += system_cpu_support_avx2() ? "AVX2 " : "";
+  capabilities += system_cpu_support_avx512() ? "AVX512 " : "";
+  if (!capabilities.empty() && capabilities[capabilities.size() - 1] == ' ') {
     capabilities.resize(capabilities.size() - 1);
   }
   return capabilities;
@@ -16,9 +16,11 @@ CCL_NAMESPACE_BEGIN
  * For example, on a computer which only has AVX2 the kernel_avx2 will be used. */
 template<typename FunctionType> class CPUKernelFunction {
  public:
-  CPUKernelFunction(FunctionType kernel_default, FunctionType kernel_avx2)
+  CPUKernelFunction(FunctionType kernel_default,
+                    FunctionType kernel_avx2,
+                    FunctionType kernel_avx512)
   {
-    kernel_info_ = get_best_kernel_info(kernel_default, kernel_avx2);
+    kernel_info_ = get_best_kernel_info(kernel_default, kernel_avx2, kernel_avx512);
   }
 
   template<typename... Args> auto operator()(Args... args) const
@@ -51,10 +53,19 @@ template<typename FunctionType> class CPUKernelFunction {
     FunctionType kernel;
   };
 
-  KernelInfo get_best_kernel_info(FunctionType kernel_default, FunctionType kernel_avx2)
+  KernelInfo get_best_kernel_info(FunctionType kernel_default,
+                                  FunctionType kernel_avx2,
+                                  FunctionType kernel_avx512)
   {
     /* Silence warnings about unused variables when compiling without some architectures. */
     (void)kernel_avx2;
+    (void)kernel_avx512;
+
+#ifdef WITH_CYCLES_OPTIMIZED_KERNEL_AVX512
+    if (DebugFlags().cpu.has_avx512() && system_cpu_support_avx512()) {
+      return KernelInfo("AVX512", kernel_avx512);
+    }
+#endif
 
 #ifdef WITH_CYCLES_OPTIMIZED_KERNEL_AVX2
     if (DebugFlags().cpu.has_avx2() && system_cpu_support_avx2()) {
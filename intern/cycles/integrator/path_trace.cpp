@@ -1028,27 +1028,80 @@ void PathTrace::process_full_buffer_from_disk(string_view filename)
 
   progress_set_status("Reading full buffer from disk");
 
-  RenderBuffers full_frame_buffers(cpu_device_.get());
-
+  BufferParams full_frame_params;
   DenoiseParams denoise_params;
-  if (!tile_manager_.read_full_buffer_from_disk(filename, &full_frame_buffers, &denoise_params)) {
-    const string error_message = "Error reading tiles from file";
-    if (progress_) {
-      progress_->set_error(error_message);
-      progress_->set_cancel(error_message);
-    }
-    else {
-      LOG(ERROR) << error_message;
+  if (!tile_manager_.read_full_buffer_params_from_disk(
+          filename, &full_frame_params, &denoise_params))
+  {
+    process_full_buffer_set_error();
+    return;
+  }
+
+  /* Process the frame in chunks of the render tile size, so that the peak memory usage does not
+   * depend on the image resolution. */
+  const int2 tile_size = tile_manager_.get_tile_size();
+  const int chunk_size = int(align_up(
+      max(max(tile_size.x, tile_size.y), TileManager::IMAGE_TILE_SIZE), TileManager::IMAGE_TILE_SIZE));
+
+  if (tile_size.x == 0 || tile_size.y == 0 ||
+      (full_frame_params.width <= chunk_size && full_frame_params.height <= chunk_size))
+  {
+    RenderBuffers full_frame_buffers(cpu_device_.get());
+    if (!tile_manager_.read_full_buffer_from_disk(filename, &full_frame_buffers, &denoise_params))
+    {
+      process_full_buffer_set_error();
+      return;
     }
+
+    process_full_buffer(&full_frame_buffers, denoise_params, make_int2(0, 0), "");
     return;
   }
 
-  const string layer_view_name = get_layer_view_name(full_frame_buffers);
+  const int num_chunks_x = int(divide_up(full_frame_params.width, chunk_size));
+  const int num_chunks_y = int(divide_up(full_frame_params.height, chunk_size));
+  const int num_chunks = num_chunks_x * num_chunks_y;
+
+  VLOG_WORK << "Processing full frame in " << num_chunks << " chunks of " << chunk_size
+            << " pixels.";
+
+  for (int chunk_index = 0; chunk_index < num_chunks; ++chunk_index) {
+    if (progress_->get_cancel()) {
+      return;
+    }
+
+    const int2 offset = make_int2((chunk_index % num_chunks_x) * chunk_size,
+                                  (chunk_index / num_chunks_x) * chunk_size);
+    const int2 size = make_int2(min(chunk_size, full_frame_params.width - offset.x),
+                                min(chunk_size, full_frame_params.height - offset.y));
+
+    /* The border gives the denoiser enough context to avoid seams between chunks. */
+    RenderBuffers chunk_buffers(cpu_device_.get());
+    if (!tile_manager_.read_buffer_region_from_disk(
+            filename, offset, size, TileManager::IMAGE_TILE_SIZE, &chunk_buffers))
+    {
+      process_full_buffer_set_error();
+      return;
+    }
+
+    process_full_buffer(&chunk_buffers,
+                        denoise_params,
+                        offset,
+                        string_printf("tile %d/%d", chunk_index + 1, num_chunks));
+  }
+}
+
+void PathTrace::process_full_buffer(RenderBuffers *buffers,
+                                    DenoiseParams denoise_params,
+                                    const int2 offset,
+                                    const string &chunk_name)
+{
+  const string layer_view_name = get_layer_view_name(*buffers);
+  const string chunk_suffix = chunk_name.empty() ? "" : " " + chunk_name;
 
   render_state_.has_denoised_result = false;
 
   if (denoise_params.use && denoiser_ && !progress_->get_cancel()) {
-    progress_set_status(layer_view_name, "Denoising");
+    progress_set_status(layer_view_name, "Denoising" + chunk_suffix);
 
     /* If GPU should be used is not based on file metadata. */
     denoise_params.use_gpu = render_scheduler_.is_denoiser_gpu_used();
@@ -1062,20 +1115,34 @@ void PathTrace::process_full_buffer_from_disk(string_view filename)
     set_denoiser_params(denoise_params);
 
     /* Number of samples doesn't matter too much, since the samples count pass will be used. */
-    denoiser_->denoise_buffer(full_frame_buffers.params, &full_frame_buffers, 0, false);
+    denoiser_->denoise_buffer(buffers->params, buffers, 0, false);
 
     render_state_.has_denoised_result = true;
   }
 
-  full_frame_state_.render_buffers = &full_frame_buffers;
+  full_frame_state_.render_buffers = buffers;
+  full_frame_state_.offset = offset;
 
-  progress_set_status(layer_view_name, "Finishing");
+  progress_set_status(layer_view_name, "Finishing" + chunk_suffix);
 
-  /* Write the full result pretending that there is a single tile.
+  /* Write the result pretending that there is a single tile.
    * Requires some state change, but allows to use same communication API with the software. */
   tile_buffer_write();
 
   full_frame_state_.render_buffers = nullptr;
+  full_frame_state_.offset = make_int2(0, 0);
+}
+
+void PathTrace::process_full_buffer_set_error()
+{
+  const string error_message = "Error reading tiles from file";
+  if (progress_) {
+    progress_->set_error(error_message);
+    progress_->set_cancel(error_message);
+  }
+  else {
+    LOG(ERROR) << error_message;
+  }
 }
 
 int PathTrace::get_num_render_tile_samples() const
@@ -1148,7 +1215,7 @@ int2 PathTrace::get_render_tile_size() const
 int2 PathTrace::get_render_tile_offset() const
 {
   if (full_frame_state_.render_buffers) {
-    return make_int2(0, 0);
+    return full_frame_state_.offset;
   }
 
   const Tile &tile = tile_manager_.get_current_tile();
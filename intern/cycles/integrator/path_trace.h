@@ -241,6 +241,14 @@ class PathTrace {
   /* Write current tile into the file on disk. */
   void tile_buffer_write_to_disk();
 
+  /* Denoise buffers of the full frame or a part of it, and write the window of the buffers to
+   * the software at the given offset. */
+  void process_full_buffer(RenderBuffers *buffers,
+                           DenoiseParams denoise_params,
+                           const int2 offset,
+                           const string &chunk_name);
+  void process_full_buffer_set_error();
+
   /* Run the progress_update_cb callback if it is needed. */
   void progress_update_if_needed(const RenderWork &render_work);
 
@@ -355,6 +363,9 @@ class PathTrace {
   /* State of the full frame processing and writing to the software. */
   struct {
     RenderBuffers *render_buffers = nullptr;
+
+    /* Offset of the buffers window in the full frame. */
+    int2 offset = make_int2(0, 0);
   } full_frame_state_;
 };
 
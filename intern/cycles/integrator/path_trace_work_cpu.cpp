@@ -2,6 +2,8 @@
  *
  * SPDX-License-Identifier: Apache-2.0 */
 
+#include <algorithm>
+
 #include "integrator/path_trace_work_cpu.h"
 
 #include "device/cpu/kernel.h"
@@ -19,6 +21,7 @@
 #include "scene/scene.h"
 #include "session/buffers.h"
 
+#include "util/debug.h"
 #include "util/tbb.h"
 
 CCL_NAMESPACE_BEGIN
@@ -43,6 +46,51 @@ static inline ThreadKernelGlobalsCPU *kernel_thread_globals_get(
   return &kernel_thread_globals[thread_index];
 }
 
+/* Number of paths kept in flight by each thread in the wavefront mode. Large enough to find
+ * several paths executing the same kernel and shader. The CPU path state is tens of kilobytes
+ * due to the shadow intersection arrays, and every path needs two of them, so this is kept
+ * relatively small to bound the per-thread memory. */
+static constexpr int WAVEFRONT_BATCH_SIZE = 64;
+
+/* Order in which the paths of a wavefront batch are advanced. */
+struct WavefrontSortKey {
+  uint32_t kernel;
+  uint32_t shader;
+  int state_index;
+
+  bool operator<(const WavefrontSortKey &other) const
+  {
+    if (kernel != other.kernel) {
+      return kernel < other.kernel;
+    }
+    if (shader != other.shader) {
+      return shader < other.shader;
+    }
+    return state_index < other.state_index;
+  }
+};
+
+/* Get the kernel which the megakernel step executes next for the given state, or 0 if the path
+ * is terminated. Mirrors the priorities of integrator_megakernel_step(). */
+static inline uint32_t wavefront_next_kernel(const IntegratorStateCPU &state)
+{
+  if (state.shadow.shadow_path.queued_kernel) {
+    return state.shadow.shadow_path.queued_kernel;
+  }
+  if (state.ao.shadow_path.queued_kernel) {
+    return state.ao.shadow_path.queued_kernel;
+  }
+  return state.path.queued_kernel;
+}
+
+static inline bool wavefront_kernel_uses_shader_sort(const uint32_t kernel)
+{
+  return kernel == DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE ||
+         kernel == DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE_RAYTRACE ||
+         kernel == DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE_MNEE ||
+         kernel == DEVICE_KERNEL_INTEGRATOR_SHADE_VOLUME;
+}
+
 PathTraceWorkCPU::PathTraceWorkCPU(Device *device,
                                    Film *film,
                                    DeviceScene *device_scene,
@@ -66,7 +114,6 @@ void PathTraceWorkCPU::render_samples(RenderStatistics &statistics,
 {
   const int64_t image_width = effective_buffer_params_.width;
   const int64_t image_height = effective_buffer_params_.height;
-  const int64_t total_pixels_num = image_width * image_height;
 
   if (device_->profiler.active()) {
     for (ThreadKernelGlobalsCPU &kernel_globals : kernel_thread_globals_) {
@@ -74,30 +121,84 @@ void PathTraceWorkCPU::render_samples(RenderStatistics &statistics,
     }
   }
 
+  /* The wavefront scheduling needs its own path states, and does not support collecting path
+   * guiding training data or baking, which rely on finishing one path before the next. */
+  bool use_wavefront = DebugFlags().cpu.wavefront && !device_scene_->data.bake.use;
+#ifdef WITH_PATH_GUIDING
+  for (const ThreadKernelGlobalsCPU &kernel_globals : kernel_thread_globals_) {
+    if (kernel_globals.data.integrator.train_guiding) {
+      use_wavefront = false;
+    }
+  }
+#endif
+  if (use_wavefront) {
+    wavefront_thread_states_.resize(kernel_thread_globals_.size());
+  }
+  else {
+    wavefront_thread_states_.clear();
+  }
+
+  /* Schedule small square tiles of pixels rather than individual pixels in scanline order, so
+   * that the paths traced in a row by each thread start from neighboring pixels. Their rays
+   * tend to visit the same BVH nodes, shaders and texture regions, which keeps them in cache.
+   * In the wavefront mode the tiles are larger to keep the batch of paths filled. */
+  const int64_t tile_size = use_wavefront ? 16 : 8;
+  const int64_t tiles_x = divide_up(image_width, tile_size);
+  const int64_t tiles_y = divide_up(image_height, tile_size);
+  const int64_t total_tiles_num = tiles_x * tiles_y;
+
   tbb::task_arena local_arena = local_tbb_arena_create(device_);
   local_arena.execute([&]() {
-    parallel_for(int64_t(0), total_pixels_num, [&](int64_t work_index) {
+    parallel_for(int64_t(0), total_tiles_num, [&](int64_t tile_index) {
       if (is_cancel_requested()) {
         return;
       }
 
-      const int y = work_index / image_width;
-      const int x = work_index - y * image_width;
-
-      KernelWorkTile work_tile;
-      work_tile.x = effective_buffer_params_.full_x + x;
-      work_tile.y = effective_buffer_params_.full_y + y;
-      work_tile.w = 1;
-      work_tile.h = 1;
-      work_tile.start_sample = start_sample;
-      work_tile.sample_offset = sample_offset;
-      work_tile.num_samples = 1;
-      work_tile.offset = effective_buffer_params_.offset;
-      work_tile.stride = effective_buffer_params_.stride;
+      const int64_t tile_y = tile_index / tiles_x;
+      const int64_t tile_x = tile_index - tile_y * tiles_x;
+      const int64_t x_start = tile_x * tile_size;
+      const int64_t y_start = tile_y * tile_size;
+      const int64_t x_end = std::min(x_start + tile_size, image_width);
+      const int64_t y_end = std::min(y_start + tile_size, image_height);
 
       ThreadKernelGlobalsCPU *kernel_globals = kernel_thread_globals_get(kernel_thread_globals_);
 
-      render_samples_full_pipeline(kernel_globals, work_tile, samples_num);
+      if (use_wavefront) {
+        KernelWorkTile work_tile;
+        work_tile.x = effective_buffer_params_.full_x + x_start;
+        work_tile.y = effective_buffer_params_.full_y + y_start;
+        work_tile.w = x_end - x_start;
+        work_tile.h = y_end - y_start;
+        work_tile.start_sample = start_sample;
+        work_tile.sample_offset = sample_offset;
+        work_tile.num_samples = samples_num;
+        work_tile.offset = effective_buffer_params_.offset;
+        work_tile.stride = effective_buffer_params_.stride;
+
+        render_samples_wavefront(kernel_globals, work_tile, samples_num);
+        return;
+      }
+
+      for (int64_t y = y_start; y < y_end; y++) {
+        for (int64_t x = x_start; x < x_end; x++) {
+          if (is_cancel_requested()) {
+            return;
+          }
+
+          KernelWorkTile work_tile;
+          work_tile.x = effective_buffer_params_.full_x + x;
+          work_tile.y = effective_buffer_params_.full_y + y;
+          work_tile.w = 1;
+          work_tile.h = 1;
+          work_tile.start_sample = start_sample;
+          work_tile.sample_offset = sample_offset;
+          work_tile.num_samples = 1;
+          work_tile.offset = effective_buffer_params_.offset;
+          work_tile.stride = effective_buffer_params_.stride;
+
+          render_samples_full_pipeline(kernel_globals, work_tile, samples_num);
+        }
+      }
     });
   });
   if (device_->profiler.active()) {
@@ -165,6 +266,93 @@ void PathTraceWorkCPU::render_samples_full_pipeline(ThreadKernelGlobalsCPU *kern
   }
 }
 
+void PathTraceWorkCPU::render_samples_wavefront(ThreadKernelGlobalsCPU *kernel_globals,
+                                                const KernelWorkTile &work_tile,
+                                                const int samples_num)
+{
+  const int thread_index = tbb::this_task_arena::current_thread_index();
+  vector<IntegratorStateCPU> &states = wavefront_thread_states_[thread_index];
+
+  /* Every path owns two consecutive states: the second one receives the shadow catcher split of
+   * the first one, see integrator_state_shadow_catcher_split(). */
+  if (states.empty()) {
+    states.resize(WAVEFRONT_BATCH_SIZE * 2);
+    for (IntegratorStateCPU &state : states) {
+      path_state_init_queues(&state);
+    }
+  }
+
+  const int64_t pixels_num = int64_t(work_tile.w) * work_tile.h;
+  const int64_t work_size = pixels_num * samples_num;
+  int64_t work_index = 0;
+
+  float *render_buffer = buffers_->buffer.data();
+
+  const int states_num = states.size();
+  vector<WavefrontSortKey> sort_keys;
+  sort_keys.reserve(states_num);
+
+  while (true) {
+    /* Start new paths in the slots where both states are terminated. Consecutive work items
+     * trace the same sample of neighboring pixels, which are likely to be coherent. */
+    if (!is_cancel_requested()) {
+      for (int slot = 0; slot < WAVEFRONT_BATCH_SIZE && work_index < work_size; slot++) {
+        IntegratorStateCPU *state = &states[slot * 2];
+        if (wavefront_next_kernel(state[0]) || wavefront_next_kernel(state[1])) {
+          continue;
+        }
+
+        /* Pixels which have converged are skipped by the initialization, so keep trying until a
+         * path is started or the work is exhausted. */
+        while (work_index < work_size) {
+          const int64_t sample = work_index / pixels_num;
+          const int64_t pixel = work_index - sample * pixels_num;
+          work_index++;
+
+          KernelWorkTile sample_work_tile = work_tile;
+          sample_work_tile.x = work_tile.x + pixel % work_tile.w;
+          sample_work_tile.y = work_tile.y + pixel / work_tile.w;
+          sample_work_tile.w = 1;
+          sample_work_tile.h = 1;
+          sample_work_tile.start_sample = work_tile.start_sample + sample;
+          sample_work_tile.num_samples = 1;
+
+          if (kernels_.integrator_init_from_camera(
+                  kernel_globals, state, &sample_work_tile, render_buffer))
+          {
+            break;
+          }
+        }
+      }
+    }
+
+    /* Advance every path in flight by one kernel, grouped by kernel and then by shader so that
+     * consecutive steps share code, BVH nodes and shader data in the caches. */
+    sort_keys.clear();
+    for (int state_index = 0; state_index < states_num; state_index++) {
+      const uint32_t kernel = wavefront_next_kernel(states[state_index]);
+      if (kernel) {
+        const uint32_t shader = wavefront_kernel_uses_shader_sort(kernel) ?
+                                    states[state_index].path.shader_sort_key :
+                                    0;
+        sort_keys.push_back({kernel, shader, state_index});
+      }
+    }
+
+    if (sort_keys.empty()) {
+      /* All paths are terminated, and either the work is done or cancel was requested. */
+      break;
+    }
+
+    std::sort(sort_keys.begin(), sort_keys.end());
+
+    for (const WavefrontSortKey &key : sort_keys) {
+      kernels_.integrator_megakernel_step(
+          kernel_globals, &states[key.state_index], render_buffer);
+    }
+  }
+}
+
 void PathTraceWorkCPU::copy_to_display(PathTraceDisplay *display,
                                        PassMode pass_mode,
                                        const int num_samples)
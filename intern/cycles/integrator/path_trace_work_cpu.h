@@ -74,6 +74,13 @@ class PathTraceWorkCPU : public PathTraceWork {
                                     const KernelWorkTile &work_tile,
                                     const int samples_num);
 
+  /* Wavefront alternative to the full pipeline: renders all samples of the pixels in the given
+   * work tile by keeping a batch of paths in flight and advancing them one kernel at a time,
+   * grouped by the kernel and shader they execute next. */
+  void render_samples_wavefront(ThreadKernelGlobalsCPU *kernel_globals,
+                                const KernelWorkTile &work_tile,
+                                const int samples_num);
+
   /* CPU kernels. */
   const CPUKernels &kernels_;
 
@@ -83,6 +90,10 @@ class PathTraceWorkCPU : public PathTraceWork {
    * accessing it, but some "localization" is required to decouple from kernel globals stored
    * on the device level. */
   vector<ThreadKernelGlobalsCPU> kernel_thread_globals_;
+
+  /* Per-thread batch of path states used by the wavefront scheduling. Every path is followed by
+   * the state which receives the shadow catcher split of it. */
+  vector<vector<IntegratorStateCPU>> wavefront_thread_states_;
 };
 
 CCL_NAMESPACE_END
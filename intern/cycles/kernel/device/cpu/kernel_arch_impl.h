@@ -95,6 +95,7 @@ CCL_NAMESPACE_BEGIN
 DEFINE_INTEGRATOR_INIT_KERNEL(init_from_camera)
 DEFINE_INTEGRATOR_INIT_KERNEL(init_from_bake)
 DEFINE_INTEGRATOR_SHADE_KERNEL(megakernel)
+DEFINE_INTEGRATOR_SHADE_KERNEL(megakernel_step)
 
 /* --------------------------------------------------------------------
  * Shader evaluation.
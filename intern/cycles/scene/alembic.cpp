@@ -4,6 +4,8 @@
 
 #include "scene/alembic.h"
 
+#include <atomic>
+
 #include "scene/alembic_read.h"
 #include "scene/camera.h"
 #include "scene/curves.h"
@@ -17,6 +19,8 @@
 #include "util/log.h"
 #include "util/progress.h"
 #include "util/set.h"
+#include "util/task.h"
+#include "util/tbb.h"
 #include "util/transform.h"
 #include "util/vector.h"
 
@@ -881,6 +885,8 @@ void AlembicProcedural::generate(Scene *scene, Progress &progress)
   if (!archive.valid() || filepath_is_modified() || layers_is_modified()) {
     Alembic::AbcCoreFactory::IFactory factory;
     factory.setPolicy(Alembic::Abc::ErrorHandler::kQuietNoopPolicy);
+    /* Allow the caches of different objects to be read from the archive concurrently. */
+    factory.setOgawaNumStreams(TaskScheduler::max_concurrency());
 
     std::vector<std::string> filenames;
     filenames.emplace_back(filepath.c_str());
@@ -933,6 +939,26 @@ void AlembicProcedural::generate(Scene *scene, Progress &progress)
     }
   }
 
+  /* Without prefetching the caches only hold a few frames, so data that looks constant in them
+   * may still be animated and has to be reloaded when the frame leaves that range. Objects which
+   * are constant in the whole archive keep their cache. */
+  if (use_prefetch) {
+    cache_start_frame = 0.0f;
+    cache_end_frame = -1.0f;
+  }
+  else if (frame < cache_start_frame || frame > cache_end_frame) {
+    for (Node *node : nodes) {
+      AlembicObject *object = static_cast<AlembicObject *>(node);
+      if (object->has_data_loaded() && !object->data_is_constant_in_archive) {
+        object->clear_cache();
+        object->cache_frames_changed = true;
+      }
+    }
+
+    cache_start_frame = frame;
+    cache_end_frame = max(frame, min(frame + 1.0f, end_frame));
+  }
+
   if (prefetch_cache_size_is_modified()) {
     /* Check whether the current memory usage fits in the new requested size,
      * abort the render if it is any higher. */
@@ -958,8 +984,8 @@ void AlembicProcedural::generate(Scene *scene, Progress &progress)
     }
 
     /* skip constant objects */
-    if (object->is_constant() && !object->is_modified() && !object->need_shader_update &&
-        !scale_is_modified())
+    if (object->is_constant() && !object->cache_frames_changed && !object->is_modified() &&
+        !object->need_shader_update && !scale_is_modified())
     {
       continue;
     }
@@ -978,6 +1004,7 @@ void AlembicProcedural::generate(Scene *scene, Progress &progress)
     }
 
     object->need_shader_update = false;
+    object->cache_frames_changed = false;
     object->clear_modified();
   }
 
@@ -990,6 +1017,18 @@ void AlembicProcedural::tag_update(Scene *scene)
   scene->procedural_manager->tag_update();
 }
 
+void AlembicProcedural::get_cache_frame_range(float &start, float &end) const
+{
+  if (use_prefetch) {
+    start = start_frame;
+    end = end_frame;
+  }
+  else {
+    start = cache_start_frame;
+    end = cache_end_frame;
+  }
+}
+
 AlembicObject *AlembicProcedural::get_or_create_object(const ustring &path)
 {
   for (Node *node : nodes) {
@@ -1487,83 +1526,120 @@ void AlembicProcedural::walk_hierarchy(
   }
 }
 
-void AlembicProcedural::build_caches(Progress &progress)
+/* Check whether all the properties in the compound, including nested ones, have a single value
+ * for the whole archive. This only reads the property headers and sample counts. */
+static bool compound_property_is_constant(const ICompoundProperty &compound)
 {
-  size_t memory_used = 0;
+  for (size_t i = 0; i < compound.getNumProperties(); ++i) {
+    const PropertyHeader &header = compound.getPropertyHeader(i);
 
-  for (Node *node : nodes) {
-    AlembicObject *object = static_cast<AlembicObject *>(node);
-
-    if (progress.get_cancel()) {
-      return;
-    }
-
-    if (object->schema_type == AlembicObject::POLY_MESH) {
-      if (!object->has_data_loaded()) {
-        IPolyMesh polymesh(object->iobject, Alembic::Abc::kWrapExisting);
-        IPolyMeshSchema schema = polymesh.getSchema();
-        object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
-      }
-      else if (object->need_shader_update) {
-        IPolyMesh polymesh(object->iobject, Alembic::Abc::kWrapExisting);
-        const IPolyMeshSchema schema = polymesh.getSchema();
-        read_attributes(this,
-                        object->get_cached_data(),
-                        schema,
-                        schema.getUVsParam(),
-                        object->get_requested_attributes(),
-                        progress);
+    if (header.isCompound()) {
+      if (!compound_property_is_constant(ICompoundProperty(compound, header.getName()))) {
+        return false;
       }
     }
-    else if (object->schema_type == AlembicObject::CURVES) {
-      if (!object->has_data_loaded() || default_radius_is_modified() ||
-          object->radius_scale_is_modified())
-      {
-        ICurves curves(object->iobject, Alembic::Abc::kWrapExisting);
-        const ICurvesSchema schema = curves.getSchema();
-        object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
-      }
-    }
-    else if (object->schema_type == AlembicObject::POINTS) {
-      if (!object->has_data_loaded() || default_radius_is_modified() ||
-          object->radius_scale_is_modified())
-      {
-        IPoints points(object->iobject, Alembic::Abc::kWrapExisting);
-        const IPointsSchema schema = points.getSchema();
-        object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
+    else if (header.isArray()) {
+      if (!IArrayProperty(compound, header.getName()).isConstant()) {
+        return false;
       }
     }
-    else if (object->schema_type == AlembicObject::SUBD) {
-      if (!object->has_data_loaded()) {
-        ISubD subd_mesh(object->iobject, Alembic::Abc::kWrapExisting);
-        ISubDSchema schema = subd_mesh.getSchema();
-        object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
-      }
-      else if (object->need_shader_update) {
-        ISubD subd_mesh(object->iobject, Alembic::Abc::kWrapExisting);
-        const ISubDSchema schema = subd_mesh.getSchema();
-        read_attributes(this,
-                        object->get_cached_data(),
-                        schema,
-                        schema.getUVsParam(),
-                        object->get_requested_attributes(),
-                        progress);
-      }
+    else if (!IScalarProperty(compound, header.getName()).isConstant()) {
+      return false;
     }
+  }
+
+  return true;
+}
+
+void AlembicProcedural::build_cache(AlembicObject *object, Progress &progress)
+{
+  if (!object->has_data_loaded() && !use_prefetch) {
+    object->data_is_constant_in_archive = compound_property_is_constant(
+        object->iobject.getProperties());
+  }
 
-    if (scale_is_modified() || object->get_cached_data().transforms.size() == 0) {
-      object->setup_transform_cache(object->get_cached_data(), scale);
+  if (object->schema_type == AlembicObject::POLY_MESH) {
+    if (!object->has_data_loaded()) {
+      IPolyMesh polymesh(object->iobject, Alembic::Abc::kWrapExisting);
+      IPolyMeshSchema schema = polymesh.getSchema();
+      object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
     }
+    else if (object->need_shader_update) {
+      IPolyMesh polymesh(object->iobject, Alembic::Abc::kWrapExisting);
+      const IPolyMeshSchema schema = polymesh.getSchema();
+      read_attributes(this,
+                      object->get_cached_data(),
+                      schema,
+                      schema.getUVsParam(),
+                      object->get_requested_attributes(),
+                      progress);
+    }
+  }
+  else if (object->schema_type == AlembicObject::CURVES) {
+    if (!object->has_data_loaded() || default_radius_is_modified() ||
+        object->radius_scale_is_modified())
+    {
+      ICurves curves(object->iobject, Alembic::Abc::kWrapExisting);
+      const ICurvesSchema schema = curves.getSchema();
+      object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
+    }
+  }
+  else if (object->schema_type == AlembicObject::POINTS) {
+    if (!object->has_data_loaded() || default_radius_is_modified() ||
+        object->radius_scale_is_modified())
+    {
+      IPoints points(object->iobject, Alembic::Abc::kWrapExisting);
+      const IPointsSchema schema = points.getSchema();
+      object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
+    }
+  }
+  else if (object->schema_type == AlembicObject::SUBD) {
+    if (!object->has_data_loaded()) {
+      ISubD subd_mesh(object->iobject, Alembic::Abc::kWrapExisting);
+      ISubDSchema schema = subd_mesh.getSchema();
+      object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
+    }
+    else if (object->need_shader_update) {
+      ISubD subd_mesh(object->iobject, Alembic::Abc::kWrapExisting);
+      const ISubDSchema schema = subd_mesh.getSchema();
+      read_attributes(this,
+                      object->get_cached_data(),
+                      schema,
+                      schema.getUVsParam(),
+                      object->get_requested_attributes(),
+                      progress);
+    }
+  }
+
+  if (scale_is_modified() || object->get_cached_data().transforms.size() == 0) {
+    object->setup_transform_cache(object->get_cached_data(), scale);
+  }
+}
+
+void AlembicProcedural::build_caches(Progress &progress)
+{
+  /* Objects are read from the archive in parallel, each one only writes to its own cache. */
+  std::atomic<size_t> memory_used = 0;
+
+  parallel_for(blocked_range<size_t>(0, nodes.size(), 1), [&](const blocked_range<size_t> &r) {
+    for (size_t i = r.begin(); i != r.end(); i++) {
+      AlembicObject *object = static_cast<AlembicObject *>(nodes[i]);
+
+      if (progress.get_cancel()) {
+        return;
+      }
+
+      build_cache(object, progress);
 
-    memory_used += object->get_cached_data().memory_used();
+      memory_used += object->get_cached_data().memory_used();
 
-    if (use_prefetch) {
+      /* The limit applies to the frames cached without prefetching as well. */
       if (memory_used > get_prefetch_cache_size_in_bytes()) {
         progress.set_error("Error: Alembic Procedural memory limit reached");
         return;
       }
     }
-  }
+  });
 
   VLOG_WORK << "AlembicProcedural memory usage : " << string_human_readable_size(memory_used);
 }
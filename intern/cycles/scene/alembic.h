@@ -437,12 +437,21 @@ class AlembicObject : public Node {
   void clear_cache()
   {
     cached_data_.clear();
+    data_loaded = false;
   }
 
   Object *object = nullptr;
 
   bool data_loaded = false;
 
+  /* Set when every property of the IObject has a single sample in the archive. The cache of such
+   * objects does not depend on the frames it was loaded for. */
+  bool data_is_constant_in_archive = false;
+
+  /* Set when the cache was reloaded for a new frame range, so the data has to be copied to the
+   * Cycles nodes again even if it looks constant in the cache. */
+  bool cache_frames_changed = false;
+
   CachedData cached_data_;
 
   void setup_transform_cache(CachedData &cached_data, const float scale);
@@ -457,7 +466,8 @@ class AlembicObject : public Node {
  *
  * This procedural will load the data set for the entire animation in memory on the first frame,
  * and directly set the data for the new frames on the created Nodes if needed. This allows for
- * faster updates between frames as it avoids reseeking the data on disk.
+ * faster updates between frames as it avoids reseeking the data on disk. When prefetching is
+ * disabled, only the current and next frames are loaded.
  */
 class AlembicProcedural : public Procedural {
   Alembic::AbcGeom::IArchive archive;
@@ -465,6 +475,10 @@ class AlembicProcedural : public Procedural {
   bool objects_modified = false;
   Scene *scene_ = nullptr;
 
+  /* Frames for which animated data is in the caches when prefetching is disabled. */
+  float cache_start_frame = 0.0f;
+  float cache_end_frame = -1.0f;
+
  public:
   NODE_DECLARE
 
@@ -525,6 +539,11 @@ class AlembicProcedural : public Procedural {
    * Returns a pointer to an existing or a newly created AlembicObject for the given path. */
   AlembicObject *get_or_create_object(const ustring &path);
 
+  /* Range of frames to read data for: the entire animation when prefetching, otherwise the
+   * current frame and the one after it, so that playing the animation only has to wait for the
+   * disk every other frame. */
+  void get_cache_frame_range(float &start, float &end) const;
+
  private:
   /* Load the data for all the objects whose data has not yet been loaded. */
   void load_objects(Progress &progress);
@@ -554,6 +573,10 @@ class AlembicProcedural : public Procedural {
    * Object Nodes in the Cycles scene if none exist yet. */
   void read_subd(AlembicObject *abc_object, Alembic::AbcGeom::Abc::chrono_t frame_time);
 
+  /* Read the data of a single object into its cache if it is missing or outdated. */
+  void build_cache(AlembicObject *object, Progress &progress);
+
+  /* Fill the caches of all objects, in parallel. */
   void build_caches(Progress &progress);
 
   size_t get_prefetch_cache_size_in_bytes() const
@@ -31,6 +31,7 @@
 #include "util/log.h"
 #include "util/progress.h"
 #include "util/task.h"
+#include "util/time.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -786,6 +787,10 @@ void GeometryManager::device_update(Device *device,
                                    dicing_camera->get_full_height());
     dicing_camera->update(scene);
 
+    /* Meshes are tessellated independently of each other, so run them in parallel. Each mesh
+     * further dices its patches in parallel. */
+    TaskPool pool;
+
     size_t i = 0;
     for (Geometry *geom : scene->geometry) {
       if (!(geom->is_modified() && geom->is_mesh())) {
@@ -803,20 +808,29 @@ void GeometryManager::device_update(Device *device,
               "%s %u/%u", mesh->name.c_str(), (uint)(i + 1), (uint)total_tess_needed);
         }
 
-        progress.set_status("Updating Mesh", msg);
-
         mesh->subd_params->camera = dicing_camera;
-        DiagSplit dsplit(*mesh->subd_params);
-        mesh->tessellate(&dsplit);
 
-        i++;
+        pool.push([mesh, msg, &progress] {
+          if (progress.get_cancel()) {
+            return;
+          }
 
-        if (progress.get_cancel()) {
-          return;
-        }
+          progress.set_status("Updating Mesh", msg);
+
+          const double start_time = time_dt();
+          DiagSplit dsplit(*mesh->subd_params);
+          mesh->tessellate(&dsplit);
+
+          VLOG_WORK << "Tessellated mesh " << mesh->name << " into " << mesh->num_triangles()
+                    << " triangles in " << time_dt() - start_time << " seconds.";
+        });
+
+        i++;
       }
     }
 
+    pool.wait_work();
+
     if (progress.get_cancel()) {
       return;
     }
@@ -81,6 +81,7 @@ void Geometry::compute_bvh(Device *device,
       bparams.num_motion_point_steps = params->num_bvh_time_steps;
       bparams.bvh_type = params->bvh_type;
       bparams.curve_subdivisions = params->curve_subdivisions();
+      bparams.use_disk_cache = params->use_bvh_disk_cache;
 
       bvh = BVH::create(bparams, geometry, objects, device);
       MEM_GUARDED_CALL(progress, device->build_bvh, bvh.get(), *progress, false);
@@ -111,6 +112,7 @@ void GeometryManager::device_update_bvh(Device *device,
   bparams.num_motion_point_steps = scene->params.num_bvh_time_steps;
   bparams.bvh_type = scene->params.bvh_type;
   bparams.curve_subdivisions = scene->params.curve_subdivisions();
+  bparams.use_disk_cache = scene->params.use_bvh_disk_cache;
 
   VLOG_INFO << "Using " << bvh_layout_name(bparams.bvh_layout) << " layout.";
 
@@ -132,6 +134,10 @@ void GeometryManager::device_update_bvh(Device *device,
 
   const bool has_bvh2_layout = (bparams.bvh_layout == BVH_LAYOUT_BVH2);
 
+  if (has_bvh2_layout && bparams.use_disk_cache) {
+    BVH2::disk_cache_clear_old();
+  }
+
   PackedBVH pack;
   if (has_bvh2_layout) {
     pack = std::move(static_cast<BVH2 *>(bvh)->pack);
@@ -2,6 +2,8 @@
  *
  * SPDX-License-Identifier: Apache-2.0 */
 
+#include <queue>
+
 #include "scene/image.h"
 #include "device/device.h"
 #include "scene/colorspace.h"
@@ -60,6 +62,36 @@ const char *name_from_type(ImageDataType type)
   return "";
 }
 
+/* Size of a single pixel in device memory, or zero for sparse volume types. */
+size_t pixel_byte_size(ImageDataType type)
+{
+  switch (type) {
+    case IMAGE_DATA_TYPE_FLOAT4:
+      return sizeof(float4);
+    case IMAGE_DATA_TYPE_BYTE4:
+      return sizeof(uchar4);
+    case IMAGE_DATA_TYPE_HALF4:
+      return sizeof(half4);
+    case IMAGE_DATA_TYPE_FLOAT:
+      return sizeof(float);
+    case IMAGE_DATA_TYPE_BYTE:
+      return sizeof(uchar);
+    case IMAGE_DATA_TYPE_HALF:
+      return sizeof(half);
+    case IMAGE_DATA_TYPE_USHORT4:
+      return sizeof(ushort4);
+    case IMAGE_DATA_TYPE_USHORT:
+      return sizeof(uint16_t);
+    case IMAGE_DATA_TYPE_NANOVDB_FLOAT:
+    case IMAGE_DATA_TYPE_NANOVDB_FLOAT3:
+    case IMAGE_DATA_TYPE_NANOVDB_FPN:
+    case IMAGE_DATA_TYPE_NANOVDB_FP16:
+    case IMAGE_DATA_NUM_TYPES:
+      break;
+  }
+  return 0;
+}
+
 }  // namespace
 
 /* Image Handle */
@@ -481,6 +513,7 @@ size_t ImageManager::add_image_slot(unique_ptr<ImageLoader> &&loader,
   img->need_metadata = true;
   img->need_load = !(osl_texture_system && !img->loader->osl_filepath().empty());
   img->builtin = builtin;
+  img->memory_texture_limit = 0;
   img->users = 1;
   img->mem = nullptr;
 
@@ -706,7 +739,11 @@ void ImageManager::device_load_image(Device *device,
 
   progress.set_status("Updating Images", "Loading " + img->loader->name());
 
-  const int texture_limit = scene->params.texture_limit;
+  int texture_limit = scene->params.texture_limit;
+  if (img->memory_texture_limit > 0) {
+    texture_limit = (texture_limit > 0) ? min(texture_limit, img->memory_texture_limit) :
+                                          img->memory_texture_limit;
+  }
 
   load_image_metadata(img);
   const ImageDataType type = img->metadata.type;
@@ -857,6 +894,91 @@ void ImageManager::device_free_image(Device * /*unused*/, size_t slot)
   images[slot].reset();
 }
 
+void ImageManager::update_texture_memory_limit(Scene *scene)
+{
+  const size_t memory_limit = scene->params.texture_memory_limit;
+  const int texture_limit = scene->params.texture_limit;
+
+  /* Images that are loaded by us, as opposed to the OSL texture system. */
+  vector<Image *> limited_images;
+  for (const unique_ptr<Image> &img : images) {
+    if (img && img->users > 0 && (img->need_load || img->mem)) {
+      limited_images.push_back(img.get());
+    }
+  }
+
+  /* Number of times the resolution of each image is halved to fit the limit. */
+  vector<int> levels(limited_images.size(), 0);
+  vector<size_t> max_sizes(limited_images.size(), 0);
+
+  if (memory_limit > 0) {
+    TaskPool pool;
+    for (Image *img : limited_images) {
+      pool.push([this, img] { load_image_metadata(img); });
+    }
+    pool.wait_work();
+
+    /* Queue of scalable images, ordered by memory usage and then slot for determinism. */
+    std::priority_queue<std::pair<size_t, size_t>> queue;
+    size_t total_memory = 0;
+
+    for (size_t i = 0; i < limited_images.size(); i++) {
+      const Image *img = limited_images[i];
+      const ImageMetaData &metadata = img->metadata;
+      const size_t pixel_size = pixel_byte_size(metadata.type);
+      size_t max_size = max(max(metadata.width, metadata.height), metadata.depth);
+      size_t memory = metadata.width * metadata.height * metadata.depth * pixel_size;
+
+      /* Builtin images can't be reloaded after the Blender data is freed, and volumes are not
+       * scaled either. They still count towards the limit. */
+      if (img->builtin || pixel_size == 0 || metadata.depth > 1 || max_size == 0) {
+        total_memory += (pixel_size == 0) ? metadata.byte_size : memory;
+        continue;
+      }
+
+      if (texture_limit > 0) {
+        while (max_size > size_t(texture_limit)) {
+          max_size = divide_up(max_size, 2);
+          memory /= 4;
+        }
+      }
+      max_sizes[i] = max_size;
+      total_memory += memory;
+      queue.emplace(memory, i);
+    }
+
+    /* Halve the resolution of the image that uses the most memory, until the total fits the
+     * limit. Images are not scaled below a minimum size, so the limit may still be exceeded. */
+    const size_t min_size = 16;
+    while (total_memory > memory_limit && !queue.empty()) {
+      const auto [memory, i] = queue.top();
+      queue.pop();
+      if ((max_sizes[i] >> levels[i]) <= min_size) {
+        continue;
+      }
+      levels[i]++;
+      total_memory -= memory - memory / 4;
+      queue.emplace(memory / 4, i);
+    }
+  }
+
+  for (size_t i = 0; i < limited_images.size(); i++) {
+    Image *img = limited_images[i];
+    const int memory_texture_limit = (levels[i] > 0) ?
+                                         int(divide_up(max_sizes[i], size_t(1) << levels[i])) :
+                                         0;
+    if (img->memory_texture_limit != memory_texture_limit) {
+      if (memory_texture_limit > 0) {
+        VLOG_WORK << "Scaling image " << img->loader->name() << " to " << memory_texture_limit
+                  << " pixels to fit texture memory limit of "
+                  << string_human_readable_size(memory_limit) << ".";
+      }
+      img->memory_texture_limit = memory_texture_limit;
+      img->need_load = true;
+    }
+  }
+}
+
 void ImageManager::device_update(Device *device, Scene *scene, Progress &progress)
 {
   if (!need_update()) {
@@ -869,6 +991,8 @@ void ImageManager::device_update(Device *device, Scene *scene, Progress &progres
     }
   });
 
+  update_texture_memory_limit(scene);
+
   TaskPool pool;
   for (size_t slot = 0; slot < images.size(); slot++) {
     Image *img = images[slot].get();
@@ -951,6 +1075,9 @@ void ImageManager::collect_statistics(RenderStats *stats)
     }
     stats->image.textures.add_entry(
         NamedSizeEntry(image->loader->name(), image->mem->memory_size()));
+    if (image->memory_texture_limit > 0) {
+      stats->image.num_memory_limit_scaled++;
+    }
   }
 }
 
@@ -200,6 +200,9 @@ class ImageManager {
     bool need_load;
     bool builtin;
 
+    /* Maximum resolution chosen to fit the texture memory limit, 0 if unlimited. */
+    int memory_texture_limit;
+
     string mem_name;
     unique_ptr<device_texture> mem;
 
@@ -227,6 +230,7 @@ class ImageManager {
   Image *get_image_slot(const size_t slot);
 
   void load_image_metadata(Image *img);
+  void update_texture_memory_limit(Scene *scene);
 
   template<TypeDesc::BASETYPE FileFormat, typename StorageType>
   bool file_load_image(Image *img, const int texture_limit);
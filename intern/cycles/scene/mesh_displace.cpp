@@ -11,9 +11,11 @@
 #include "scene/scene.h"
 #include "scene/shader.h"
 
+#include "util/log.h"
 #include "util/map.h"
 #include "util/progress.h"
 #include "util/set.h"
+#include "util/time.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -170,6 +172,8 @@ bool GeometryManager::displace(Device *device, Scene *scene, Mesh *mesh, Progres
   const string msg = string_printf("Computing Displacement %s", mesh->name.c_str());
   progress.set_status("Updating Mesh", msg);
 
+  const double start_time = time_dt();
+
   /* find object index. todo: is arbitrary */
   size_t object_index = OBJECT_NONE;
 
@@ -403,6 +407,9 @@ bool GeometryManager::displace(Device *device, Scene *scene, Mesh *mesh, Progres
     }
   }
 
+  VLOG_WORK << "Displaced mesh " << mesh->name << " with " << num_verts << " vertices in "
+            << time_dt() - start_time << " seconds.";
+
   return true;
 }
 
@@ -2080,6 +2080,39 @@ void MappingNode::constant_fold(const ConstantFolder &folder)
   }
 }
 
+/* Constant Mapping folding: with constant location, rotation and scale the point, texture and
+ * vector mappings are affine and compile to a single matrix. Normal mapping normalizes its result
+ * and is left to NODE_MAPPING. */
+static bool mapping_constant_transform(const NodeMappingType type,
+                                       const float3 location,
+                                       const float3 rotation,
+                                       const float3 scale,
+                                       Transform *tfm)
+{
+  const Transform rmat = euler_to_transform(rotation);
+
+  switch (type) {
+    case NODE_MAPPING_TYPE_POINT:
+      *tfm = transform_translate(location) * rmat * transform_scale(scale);
+      return true;
+    case NODE_MAPPING_TYPE_VECTOR:
+      *tfm = rmat * transform_scale(scale);
+      return true;
+    case NODE_MAPPING_TYPE_TEXTURE: {
+      /* Inverse rotation is the transpose, zero scale maps to zero like safe_divide(). */
+      Transform rmat_transposed;
+      rmat_transposed.x = make_float4(rmat.x.x, rmat.y.x, rmat.z.x, 0.0f);
+      rmat_transposed.y = make_float4(rmat.x.y, rmat.y.y, rmat.z.y, 0.0f);
+      rmat_transposed.z = make_float4(rmat.x.z, rmat.y.z, rmat.z.z, 0.0f);
+      *tfm = transform_scale(safe_divide(one_float3(), scale)) * rmat_transposed *
+             transform_translate(-location);
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
 void MappingNode::compile(SVMCompiler &compiler)
 {
   ShaderInput *vector_in = input("Vector");
@@ -2088,6 +2121,18 @@ void MappingNode::compile(SVMCompiler &compiler)
   ShaderInput *scale_in = input("Scale");
   ShaderOutput *vector_out = output("Vector");
 
+  Transform tfm;
+  if (!location_in->link && !rotation_in->link && !scale_in->link &&
+      mapping_constant_transform(mapping_type, location, rotation, scale, &tfm))
+  {
+    compiler.add_node(
+        NODE_TEXTURE_MAPPING, compiler.stack_assign(vector_in), compiler.stack_assign(vector_out));
+    compiler.add_node(tfm.x);
+    compiler.add_node(tfm.y);
+    compiler.add_node(tfm.z);
+    return;
+  }
+
   const int vector_stack_offset = compiler.stack_assign(vector_in);
   const int location_stack_offset = compiler.stack_assign(location_in);
   const int rotation_stack_offset = compiler.stack_assign(rotation_in);
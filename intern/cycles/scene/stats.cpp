@@ -39,6 +39,33 @@ bool namedSampleCountPairComparator(const NamedSampleCountPair &a, const NamedSa
   return a.samples > b.samples;
 }
 
+string json_string(const string &str)
+{
+  string result = "\"";
+  for (const char c : str) {
+    switch (c) {
+      case '"':
+        result += "\\\"";
+        break;
+      case '\\':
+        result += "\\\\";
+        break;
+      case '\n':
+        result += "\\n";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          result += string_printf("\\u%04x", c);
+        }
+        else {
+          result += c;
+        }
+        break;
+    }
+  }
+  return result + "\"";
+}
+
 }  // namespace
 
 NamedSizeEntry::NamedSizeEntry() : size(0) {}
@@ -95,16 +122,20 @@ string NamedTimeStats::full_report(const int indent_level)
 
 /* Named time sample statistics. */
 
-NamedNestedSampleStats::NamedNestedSampleStats() : self_samples(0), sum_samples(0) {}
+NamedNestedSampleStats::NamedNestedSampleStats() : self_samples(0), sum_samples(0), hits(0) {}
 
-NamedNestedSampleStats::NamedNestedSampleStats(const string &name, const uint64_t samples)
-    : name(name), self_samples(samples), sum_samples(samples)
+NamedNestedSampleStats::NamedNestedSampleStats(const string &name,
+                                               const uint64_t samples,
+                                               const uint64_t hits)
+    : name(name), self_samples(samples), sum_samples(samples), hits(hits)
 {
 }
 
-NamedNestedSampleStats &NamedNestedSampleStats::add_entry(const string &name_, uint64_t samples_)
+NamedNestedSampleStats &NamedNestedSampleStats::add_entry(const string &name_,
+                                                          uint64_t samples_,
+                                                          uint64_t hits_)
 {
-  entries.push_back(NamedNestedSampleStats(name_, samples_));
+  entries.push_back(NamedNestedSampleStats(name_, samples_, hits_));
   return entries[entries.size() - 1];
 }
 
@@ -131,13 +162,16 @@ string NamedNestedSampleStats::full_report(const int indent_level, uint64_t tota
   const double sum_seconds = sum_samples * 0.001;
   const double self_percent = 100 * ((double)self_samples) / total_samples;
   const double self_seconds = self_samples * 0.001;
-  const string info = string_printf("%-32s: Total %3.2f%% (%.2fs), Self %3.2f%% (%.2fs)\n",
-                                    name.c_str(),
-                                    sum_percent,
-                                    sum_seconds,
-                                    self_percent,
-                                    self_seconds);
-  string result = indent + info;
+  string info = string_printf("%-32s: Total %3.2f%% (%.2fs), Self %3.2f%% (%.2fs)",
+                              name.c_str(),
+                              sum_percent,
+                              sum_seconds,
+                              self_percent,
+                              self_seconds);
+  if (hits) {
+    info += ", Calls " + string_human_readable_number(hits);
+  }
+  string result = indent + info + "\n";
 
   sort(entries.begin(), entries.end(), namedTimeSampleEntryComparator);
   for (NamedNestedSampleStats &entry : entries) {
@@ -146,6 +180,30 @@ string NamedNestedSampleStats::full_report(const int indent_level, uint64_t tota
   return result;
 }
 
+string NamedNestedSampleStats::json_report()
+{
+  update_sum();
+
+  string result = string_printf("{\"name\": %s, \"total_seconds\": %.3f, \"self_seconds\": %.3f",
+                                json_string(name).c_str(),
+                                sum_samples * 0.001,
+                                self_samples * 0.001);
+  result += ", \"calls\": " + to_string(hits);
+
+  if (!entries.empty()) {
+    sort(entries.begin(), entries.end(), namedTimeSampleEntryComparator);
+
+    result += ", \"entries\": [";
+    for (size_t i = 0; i < entries.size(); i++) {
+      result += (i == 0) ? "" : ", ";
+      result += entries[i].json_report();
+    }
+    result += "]";
+  }
+
+  return result + "}";
+}
+
 /* Named sample count pairs. */
 
 NamedSampleCountPair::NamedSampleCountPair(const ustring &name,
@@ -201,6 +259,28 @@ string NamedSampleCountStats::full_report(const int indent_level)
   return result;
 }
 
+string NamedSampleCountStats::json_report()
+{
+  vector<NamedSampleCountPair> sorted_entries;
+  sorted_entries.reserve(entries.size());
+  for (entry_map::const_reference entry : entries) {
+    sorted_entries.push_back(entry.second);
+  }
+
+  sort(sorted_entries.begin(), sorted_entries.end(), namedSampleCountPairComparator);
+
+  string result = "[";
+  for (size_t i = 0; i < sorted_entries.size(); i++) {
+    const NamedSampleCountPair &entry = sorted_entries[i];
+    result += (i == 0) ? "" : ", ";
+    result += string_printf("{\"name\": %s, \"seconds\": %.3f, \"hits\": ",
+                            json_string(entry.name.string()).c_str(),
+                            entry.samples * 0.001);
+    result += to_string(entry.hits) + "}";
+  }
+  return result + "]";
+}
+
 /* Mesh statistics. */
 
 MeshStats::MeshStats() = default;
@@ -222,6 +302,10 @@ string ImageStats::full_report(const int indent_level)
   const string indent(indent_level * kIndentNumSpaces, ' ');
   string result;
   result += indent + "Textures:\n" + textures.full_report(indent_level + 1);
+  if (num_memory_limit_scaled > 0) {
+    result += indent +
+              string_printf("Downscaled to fit memory limit: %d\n", num_memory_limit_scaled);
+  }
   return result;
 }
 
@@ -237,36 +321,44 @@ void RenderStats::collect_profiling(Scene *scene, Profiler &prof)
   has_profiling = true;
 
   kernel = NamedNestedSampleStats("Total render time", prof.get_event(PROFILING_UNKNOWN));
-  kernel.add_entry("Ray setup", prof.get_event(PROFILING_RAY_SETUP));
-  kernel.add_entry("Intersect Closest", prof.get_event(PROFILING_INTERSECT_CLOSEST));
-  kernel.add_entry("Intersect Shadow", prof.get_event(PROFILING_INTERSECT_SHADOW));
-  kernel.add_entry("Intersect Subsurface", prof.get_event(PROFILING_INTERSECT_SUBSURFACE));
-  kernel.add_entry("Intersect Volume Stack", prof.get_event(PROFILING_INTERSECT_VOLUME_STACK));
-  kernel.add_entry("Intersect Blocked Light", prof.get_event(PROFILING_INTERSECT_DEDICATED_LIGHT));
+
+  /* Sampled time and exact number of calls of an event. */
+  auto add_event = [&prof](NamedNestedSampleStats &parent,
+                           const string &name,
+                           const ProfilingEvent event) {
+    parent.add_entry(name, prof.get_event(event), prof.get_event_hits(event));
+  };
+
+  add_event(kernel, "Ray setup", PROFILING_RAY_SETUP);
+  add_event(kernel, "Intersect Closest", PROFILING_INTERSECT_CLOSEST);
+  add_event(kernel, "Intersect Shadow", PROFILING_INTERSECT_SHADOW);
+  add_event(kernel, "Intersect Subsurface", PROFILING_INTERSECT_SUBSURFACE);
+  add_event(kernel, "Intersect Volume Stack", PROFILING_INTERSECT_VOLUME_STACK);
+  add_event(kernel, "Intersect Blocked Light", PROFILING_INTERSECT_DEDICATED_LIGHT);
 
   NamedNestedSampleStats &surface = kernel.add_entry("Shade Surface", 0);
-  surface.add_entry("Setup", prof.get_event(PROFILING_SHADE_SURFACE_SETUP));
-  surface.add_entry("Shader Evaluation", prof.get_event(PROFILING_SHADE_SURFACE_EVAL));
-  surface.add_entry("Render Passes", prof.get_event(PROFILING_SHADE_SURFACE_PASSES));
-  surface.add_entry("Direct Light", prof.get_event(PROFILING_SHADE_SURFACE_DIRECT_LIGHT));
-  surface.add_entry("Indirect Light", prof.get_event(PROFILING_SHADE_SURFACE_INDIRECT_LIGHT));
-  surface.add_entry("Ambient Occlusion", prof.get_event(PROFILING_SHADE_SURFACE_AO));
+  add_event(surface, "Setup", PROFILING_SHADE_SURFACE_SETUP);
+  add_event(surface, "Shader Evaluation", PROFILING_SHADE_SURFACE_EVAL);
+  add_event(surface, "Render Passes", PROFILING_SHADE_SURFACE_PASSES);
+  add_event(surface, "Direct Light", PROFILING_SHADE_SURFACE_DIRECT_LIGHT);
+  add_event(surface, "Indirect Light", PROFILING_SHADE_SURFACE_INDIRECT_LIGHT);
+  add_event(surface, "Ambient Occlusion", PROFILING_SHADE_SURFACE_AO);
 
   NamedNestedSampleStats &volume = kernel.add_entry("Shade Volume", 0);
-  volume.add_entry("Setup", prof.get_event(PROFILING_SHADE_VOLUME_SETUP));
-  volume.add_entry("Integrate", prof.get_event(PROFILING_SHADE_VOLUME_INTEGRATE));
-  volume.add_entry("Direct Light", prof.get_event(PROFILING_SHADE_VOLUME_DIRECT_LIGHT));
-  volume.add_entry("Indirect Light", prof.get_event(PROFILING_SHADE_VOLUME_INDIRECT_LIGHT));
+  add_event(volume, "Setup", PROFILING_SHADE_VOLUME_SETUP);
+  add_event(volume, "Integrate", PROFILING_SHADE_VOLUME_INTEGRATE);
+  add_event(volume, "Direct Light", PROFILING_SHADE_VOLUME_DIRECT_LIGHT);
+  add_event(volume, "Indirect Light", PROFILING_SHADE_VOLUME_INDIRECT_LIGHT);
 
   NamedNestedSampleStats &shadow = kernel.add_entry("Shade Shadow", 0);
-  shadow.add_entry("Setup", prof.get_event(PROFILING_SHADE_SHADOW_SETUP));
-  shadow.add_entry("Surface", prof.get_event(PROFILING_SHADE_SHADOW_SURFACE));
-  shadow.add_entry("Volume", prof.get_event(PROFILING_SHADE_SHADOW_VOLUME));
-  shadow.add_entry("Blocked Light", prof.get_event(PROFILING_SHADE_DEDICATED_LIGHT));
+  add_event(shadow, "Setup", PROFILING_SHADE_SHADOW_SETUP);
+  add_event(shadow, "Surface", PROFILING_SHADE_SHADOW_SURFACE);
+  add_event(shadow, "Volume", PROFILING_SHADE_SHADOW_VOLUME);
+  add_event(shadow, "Blocked Light", PROFILING_SHADE_DEDICATED_LIGHT);
 
   NamedNestedSampleStats &light = kernel.add_entry("Shade Light", 0);
-  light.add_entry("Setup", prof.get_event(PROFILING_SHADE_LIGHT_SETUP));
-  light.add_entry("Shader Evaluation", prof.get_event(PROFILING_SHADE_LIGHT_EVAL));
+  add_event(light, "Setup", PROFILING_SHADE_LIGHT_SETUP);
+  add_event(light, "Shader Evaluation", PROFILING_SHADE_LIGHT_EVAL);
 
   shaders.entries.clear();
   for (Shader *shader : scene->shaders) {
@@ -303,6 +395,19 @@ string RenderStats::full_report()
   return result;
 }
 
+string RenderStats::json_report()
+{
+  string result = "{";
+  result += "\"mesh\": {\"memory\": " + to_string(mesh.geometry.total_size) + "}, ";
+  result += "\"image\": {\"memory\": " + to_string(image.textures.total_size) + "}";
+  if (has_profiling) {
+    result += ", \"kernel\": " + kernel.json_report();
+    result += ", \"shaders\": " + shaders.json_report();
+    result += ", \"objects\": " + objects.json_report();
+  }
+  return result + "}";
+}
+
 NamedTimeStats::NamedTimeStats() : total_time(0.0) {}
 
 string UpdateTimeStats::full_report(const int indent_level)
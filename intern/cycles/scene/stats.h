@@ -91,14 +91,17 @@ class NamedTimeStats {
 class NamedNestedSampleStats {
  public:
   NamedNestedSampleStats();
-  NamedNestedSampleStats(const string &name, const uint64_t samples);
+  NamedNestedSampleStats(const string &name, const uint64_t samples, const uint64_t hits = 0);
 
-  NamedNestedSampleStats &add_entry(const string &name, const uint64_t samples);
+  NamedNestedSampleStats &add_entry(const string &name,
+                                    const uint64_t samples,
+                                    const uint64_t hits = 0);
 
   /* Updates sum_samples recursively. */
   void update_sum();
 
   string full_report(const int indent_level = 0, const uint64_t total_samples = 0);
+  string json_report();
 
   string name;
 
@@ -106,6 +109,9 @@ class NamedNestedSampleStats {
    * while sum_samples also includes the samples of all sub-entries. */
   uint64_t self_samples, sum_samples;
 
+  /* Exact number of times the event was entered, zero if unknown. */
+  uint64_t hits;
+
   vector<NamedNestedSampleStats> entries;
 };
 
@@ -127,6 +133,7 @@ class NamedSampleCountStats {
   NamedSampleCountStats();
 
   string full_report(const int indent_level = 0);
+  string json_report();
   void add(const ustring &name, const uint64_t samples, const uint64_t hits);
 
   using entry_map = unordered_map<ustring, NamedSampleCountPair>;
@@ -157,6 +164,8 @@ class ImageStats {
   string full_report(const int indent_level = 0);
 
   NamedSizeStats textures;
+  /* Number of textures loaded at lower resolution to fit the texture memory limit. */
+  int num_memory_limit_scaled = 0;
 };
 
 /* Render process statistics. */
@@ -167,6 +176,9 @@ class RenderStats {
   /* Return full report as string. */
   string full_report();
 
+  /* Return report as JSON object, for processing by external tools. */
+  string json_report();
+
   /* Collect kernel sampling information from Stats. */
   void collect_profiling(Scene *scene, Profiler &prof);
 
@@ -45,6 +45,7 @@ NODE_DEFINE(BufferPass)
   SOCKET_STRING(name, "Name", ustring());
   SOCKET_BOOLEAN(include_albedo, "Include Albedo", false);
   SOCKET_STRING(lightgroup, "Light Group", ustring());
+  SOCKET_BOOLEAN(use_half_float, "Use Half Float", false);
 
   SOCKET_INT(offset, "Offset", -1);
 
@@ -68,6 +69,23 @@ PassInfo BufferPass::get_info() const
   return Pass::get_info(type, include_albedo, !lightgroup.empty());
 }
 
+bool BufferPass::supports_half_float() const
+{
+  switch (type) {
+    case PASS_DIFFUSE_COLOR:
+    case PASS_GLOSSY_COLOR:
+    case PASS_TRANSMISSION_COLOR:
+    case PASS_AOV_COLOR:
+      return true;
+    default:
+      break;
+  }
+
+  /* Light passes. Data passes such as depth, position, object IDs, cryptomatte and sample count
+   * need full precision. */
+  return get_info().use_exposure;
+}
+
 /* --------------------------------------------------------------------
  * Buffer Params.
  */
@@ -31,6 +31,10 @@ class BufferPass : public Node {
   bool include_albedo = false;
   ustring lightgroup;
 
+  /* Store the pass as half float in the on-disk tile file. Accumulation always happens in full
+   * precision render buffers. */
+  bool use_half_float = false;
+
   int offset = -1;
 
   BufferPass();
@@ -46,11 +50,15 @@ class BufferPass : public Node {
 
   PassInfo get_info() const;
 
+  /* Check whether the pass holds color data which can be stored as half float without visible
+   * loss of precision. */
+  bool supports_half_float() const;
+
   bool operator==(const BufferPass &other) const
   {
     return type == other.type && mode == other.mode && name == other.name &&
            include_albedo == other.include_albedo && lightgroup == other.lightgroup &&
-           offset == other.offset;
+           use_half_float == other.use_half_float && offset == other.offset;
   }
   bool operator!=(const BufferPass &other) const
   {
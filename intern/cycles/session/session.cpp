@@ -555,6 +555,11 @@ void Session::do_delayed_reset()
 
   /* Update for new state of scene and passes. */
   buffer_params_.update_passes(scene->passes);
+  if (params.use_half_float_tile_passes) {
+    for (BufferPass &pass : buffer_params_.passes) {
+      pass.use_half_float = pass.supports_half_float();
+    }
+  }
   tile_manager_.update(buffer_params_, scene.get());
 
   /* Update temp directory on reset.
@@ -61,6 +61,10 @@ class SessionParams {
   bool use_auto_tile;
   int tile_size;
 
+  /* Store light and color passes as half float in the on-disk tile file, to reduce its size.
+   * Does not affect the precision or memory usage of the render buffers. */
+  bool use_half_float_tile_passes;
+
   bool use_resolution_divider;
 
   ShadingSystem shadingsystem;
@@ -87,6 +91,8 @@ class SessionParams {
     use_auto_tile = true;
     tile_size = 2048;
 
+    use_half_float_tile_passes = false;
+
     use_resolution_divider = true;
 
     shadingsystem = SHADINGSYSTEM_SVM;
@@ -100,7 +106,8 @@ class SessionParams {
              background == params.background && experimental == params.experimental &&
              pixel_size == params.pixel_size && threads == params.threads &&
              use_profiling == params.use_profiling && shadingsystem == params.shadingsystem &&
-             use_auto_tile == params.use_auto_tile && tile_size == params.tile_size);
+             use_auto_tile == params.use_auto_tile && tile_size == params.tile_size &&
+             use_half_float_tile_passes == params.use_half_float_tile_passes);
   }
 };
 
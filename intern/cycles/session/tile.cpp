@@ -18,6 +18,7 @@
 #include "util/path.h"
 #include "util/string.h"
 #include "util/system.h"
+#include "util/tbb.h"
 #include "util/time.h"
 #include "util/types.h"
 
@@ -70,6 +71,89 @@ static std::vector<std::string> exr_channel_names_for_passes(const BufferParams
   return channel_names;
 }
 
+/* Passes are only stored as half float when the per-pixel sample count is known, so that the
+ * accumulated values can be normalized to stay within the half float range. */
+static bool buffer_params_use_half_float(const BufferParams &buffer_params)
+{
+  if (buffer_params.get_pass_offset(PASS_SAMPLE_COUNT) == PASS_UNUSED) {
+    return false;
+  }
+
+  for (const BufferPass &pass : buffer_params.passes) {
+    if (pass.offset != PASS_UNUSED && pass.use_half_float) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/* Per-channel formats of the tile file, in the same order as the channel names. */
+static std::vector<TypeDesc> exr_channel_formats_for_passes(const BufferParams &buffer_params)
+{
+  std::vector<TypeDesc> channel_formats;
+  for (const BufferPass &pass : buffer_params.passes) {
+    if (pass.offset == PASS_UNUSED) {
+      continue;
+    }
+
+    const PassInfo pass_info = pass.get_info();
+    const TypeDesc format = pass.use_half_float ? TypeDesc::HALF : TypeDesc::FLOAT;
+
+    for (int i = 0; i < pass_info.num_components; ++i) {
+      channel_formats.push_back(format);
+    }
+  }
+
+  return channel_formats;
+}
+
+/* Largest finite value representable as half float. */
+static constexpr float HALF_FLOAT_MAX = 65504.0f;
+
+/* Divide (or multiply back when reading) half float passes by the per-pixel sample count.
+ *
+ * Normalized values are clamped to the half float range, so that very bright pixels such as
+ * directly visible lights are stored as the largest finite half rather than as infinity. */
+static void buffer_scale_half_float_passes(const BufferParams &buffer_params,
+                                           float *pixels,
+                                           const int64_t num_pixels,
+                                           const bool normalize)
+{
+  const int pass_sample_count = buffer_params.get_pass_offset(PASS_SAMPLE_COUNT);
+  const int64_t pass_stride = buffer_params.pass_stride;
+
+  parallel_for(int64_t(0), num_pixels, [&](const int64_t pixel_index) {
+    float *pixel = pixels + pixel_index * pass_stride;
+
+    const uint sample_count = __float_as_uint(pixel[pass_sample_count]);
+    if (sample_count == 0) {
+      return;
+    }
+
+    const float scale = normalize ? 1.0f / sample_count : float(sample_count);
+
+    for (const BufferPass &pass : buffer_params.passes) {
+      if (pass.offset == PASS_UNUSED || !pass.use_half_float) {
+        continue;
+      }
+
+      const int num_components = pass.get_info().num_components;
+      if (normalize) {
+        for (int i = 0; i < num_components; ++i) {
+          pixel[pass.offset + i] = clamp(
+              pixel[pass.offset + i] * scale, -HALF_FLOAT_MAX, HALF_FLOAT_MAX);
+        }
+      }
+      else {
+        for (int i = 0; i < num_components; ++i) {
+          pixel[pass.offset + i] *= scale;
+        }
+      }
+    }
+  });
+}
+
 inline string node_socket_attribute_name(const SocketType &socket, const string &attr_name_prefix)
 {
   return attr_name_prefix + string(socket.name);
@@ -287,6 +371,10 @@ static bool configure_image_spec_from_buffer(ImageSpec *image_spec,
 
   image_spec->channelnames = std::move(channel_names);
 
+  if (buffer_params_use_half_float(buffer_params)) {
+    image_spec->channelformats = exr_channel_formats_for_passes(buffer_params);
+  }
+
   if (!buffer_params_to_image_spec_atttributes(image_spec, buffer_params)) {
     return false;
   }
@@ -366,6 +454,22 @@ void TileManager::update(const BufferParams &params, const Scene *scene)
     node_to_image_spec_atttributes(
         &write_state_.image_spec, &denoise_params, ATTR_DENOISE_SOCKET_PREFIX);
 
+    if (!write_state_.image_spec.channelformats.empty()) {
+      int num_half_channels = 0;
+      for (const TypeDesc &format : write_state_.image_spec.channelformats) {
+        if (format == TypeDesc::HALF) {
+          ++num_half_channels;
+        }
+      }
+
+      const size_t num_pixels = size_t(buffer_params_.width) * buffer_params_.height;
+      VLOG_INFO << "Storing " << num_half_channels << " of "
+                << write_state_.image_spec.nchannels
+                << " tile file channels as half float, saving "
+                << string_human_readable_size(num_pixels * num_half_channels * sizeof(half))
+                << ".";
+    }
+
     /* Not adaptive sampling overscan yet for baking, would need overscan also
      * for buffers read from the output driver. */
     if (adaptive_sampling.use && !scene->bake_manager->get_baking()) {
@@ -515,13 +619,17 @@ bool TileManager::write_tile(const RenderBuffers &tile_buffers)
   const float *pixels = tile_buffers.buffer.data() + tile_params.window_x * pass_stride +
                         tile_params.window_y * tile_row_stride;
 
+  const bool use_half_float = buffer_params_use_half_float(buffer_params_);
+
   /* If there is an overscan used for the tile copy pixels into single continuous block of memory
    * without any "gaps".
    * This is a workaround for bug in OIIO (https://github.com/OpenImageIO/oiio/pull/3176).
-   * Our task reference: #93008. */
+   * Our task reference: #93008.
+   *
+   * Half float passes are normalized in place, which also requires a copy. */
   if (tile_params.window_x || tile_params.window_y ||
       tile_params.window_width != tile_params.width ||
-      tile_params.window_height != tile_params.height)
+      tile_params.window_height != tile_params.height || use_half_float)
   {
     pixel_storage.resize(pass_stride * tile_params.window_width * tile_params.window_height);
     float *pixels_continuous = pixel_storage.data();
@@ -536,6 +644,13 @@ bool TileManager::write_tile(const RenderBuffers &tile_buffers)
     }
 
     pixels = pixel_storage.data();
+
+    if (use_half_float) {
+      buffer_scale_half_float_passes(buffer_params_,
+                                     pixel_storage.data(),
+                                     int64_t(tile_params.window_width) * tile_params.window_height,
+                                     true);
+    }
   }
 
   VLOG_WORK << "Write tile at " << tile_x << ", " << tile_y;
@@ -625,34 +740,139 @@ void TileManager::finish_write_tiles()
   write_state_.filename = "";
 }
 
-bool TileManager::read_full_buffer_from_disk(const string_view filename,
-                                             RenderBuffers *buffers,
+/* Open tiles file and read the buffer and denoise parameters stored in its metadata. */
+static unique_ptr<ImageInput> open_tile_file(const string_view filename,
+                                             BufferParams *buffer_params,
                                              DenoiseParams *denoise_params)
 {
   unique_ptr<ImageInput> in(ImageInput::open(filename));
   if (!in) {
     LOG(ERROR) << "Error opening tile file " << filename;
-    return false;
+    return nullptr;
   }
 
   const ImageSpec &image_spec = in->spec();
 
+  if (!buffer_params_from_image_spec_atttributes(buffer_params, image_spec)) {
+    return nullptr;
+  }
+
+  if (denoise_params &&
+      !node_from_image_spec_atttributes(denoise_params, image_spec, ATTR_DENOISE_SOCKET_PREFIX))
+  {
+    return nullptr;
+  }
+
+  return in;
+}
+
+bool TileManager::read_full_buffer_from_disk(const string_view filename,
+                                             RenderBuffers *buffers,
+                                             DenoiseParams *denoise_params)
+{
   BufferParams buffer_params;
-  if (!buffer_params_from_image_spec_atttributes(&buffer_params, image_spec)) {
+  unique_ptr<ImageInput> in = open_tile_file(filename, &buffer_params, denoise_params);
+  if (!in) {
     return false;
   }
+
   buffers->reset(buffer_params);
 
-  if (!node_from_image_spec_atttributes(denoise_params, image_spec, ATTR_DENOISE_SOCKET_PREFIX)) {
+  const int num_channels = in->spec().nchannels;
+  if (!in->read_image(0, 0, 0, num_channels, TypeDesc::FLOAT, buffers->buffer.data())) {
+    LOG(ERROR) << "Error reading pixels from the tile file " << in->geterror();
     return false;
   }
 
+  if (buffer_params_use_half_float(buffer_params)) {
+    buffer_scale_half_float_passes(buffer_params,
+                                   buffers->buffer.data(),
+                                   int64_t(buffer_params.width) * buffer_params.height,
+                                   false);
+  }
+
+  if (!in->close()) {
+    LOG(ERROR) << "Error closing tile file " << in->geterror();
+    return false;
+  }
+
+  return true;
+}
+
+bool TileManager::read_full_buffer_params_from_disk(const string_view filename,
+                                                    BufferParams *buffer_params,
+                                                    DenoiseParams *denoise_params)
+{
+  unique_ptr<ImageInput> in = open_tile_file(filename, buffer_params, denoise_params);
+  if (!in) {
+    return false;
+  }
+
+  in->close();
+
+  return true;
+}
+
+bool TileManager::read_buffer_region_from_disk(const string_view filename,
+                                               const int2 offset,
+                                               const int2 size,
+                                               const int border,
+                                               RenderBuffers *buffers)
+{
+  DCHECK_EQ(offset.x % IMAGE_TILE_SIZE, 0);
+  DCHECK_EQ(offset.y % IMAGE_TILE_SIZE, 0);
+  DCHECK_EQ(border % IMAGE_TILE_SIZE, 0);
+
+  BufferParams full_params;
+  unique_ptr<ImageInput> in = open_tile_file(filename, &full_params, nullptr);
+  if (!in) {
+    return false;
+  }
+
+  /* Region extended by the border, clamped to the image. Stays aligned to the file tiles. */
+  const int x_begin = max(offset.x - border, 0);
+  const int y_begin = max(offset.y - border, 0);
+  const int x_end = min(offset.x + size.x + border, full_params.width);
+  const int y_end = min(offset.y + size.y + border, full_params.height);
+
+  BufferParams buffer_params = full_params;
+  buffer_params.width = x_end - x_begin;
+  buffer_params.height = y_end - y_begin;
+  buffer_params.full_x = full_params.full_x + x_begin;
+  buffer_params.full_y = full_params.full_y + y_begin;
+  buffer_params.window_x = offset.x - x_begin;
+  buffer_params.window_y = offset.y - y_begin;
+  buffer_params.window_width = min(size.x, full_params.width - offset.x);
+  buffer_params.window_height = min(size.y, full_params.height - offset.y);
+  buffer_params.update_offset_stride();
+
+  buffers->reset(buffer_params);
+
   const int num_channels = in->spec().nchannels;
-  if (!in->read_image(0, 0, 0, num_channels, TypeDesc::FLOAT, buffers->buffer.data())) {
+  if (!in->read_tiles(0,
+                      0,
+                      x_begin,
+                      x_end,
+                      y_begin,
+                      y_end,
+                      0,
+                      1,
+                      0,
+                      num_channels,
+                      TypeDesc::FLOAT,
+                      buffers->buffer.data()))
+  {
     LOG(ERROR) << "Error reading pixels from the tile file " << in->geterror();
     return false;
   }
 
+  if (buffer_params_use_half_float(buffer_params)) {
+    buffer_scale_half_float_passes(buffer_params,
+                                   buffers->buffer.data(),
+                                   int64_t(buffer_params.width) * buffer_params.height,
+                                   false);
+  }
+
   if (!in->close()) {
     LOG(ERROR) << "Error closing tile file " << in->geterror();
     return false;
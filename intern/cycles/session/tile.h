@@ -83,6 +83,11 @@ class TileManager {
   const Tile &get_current_tile() const;
   int2 get_size() const;
 
+  int2 get_tile_size() const
+  {
+    return tile_size_;
+  }
+
   /* Write render buffer of a tile to a file on disk.
    *
    * Opens file for write when first tile is written.
@@ -107,6 +112,28 @@ class TileManager {
                                   RenderBuffers *buffers,
                                   DenoiseParams *denoise_params);
 
+  /* Read parameters of the full frame render buffer stored in tiles file, without reading its
+   * pixels.
+   *
+   * Returns true on success. */
+  bool read_full_buffer_params_from_disk(string_view filename,
+                                         BufferParams *buffer_params,
+                                         DenoiseParams *denoise_params);
+
+  /* Read region of the full frame render buffer from tiles file on disk, so that the full frame
+   * can be processed without having all of it in memory.
+   *
+   * The region is extended by the border on all sides where possible, and the window of the
+   * buffers is set to the region itself. The offset and border are to be multiple of the
+   * IMAGE_TILE_SIZE.
+   *
+   * Returns true on success. */
+  bool read_buffer_region_from_disk(string_view filename,
+                                    const int2 offset,
+                                    const int2 size,
+                                    const int border,
+                                    RenderBuffers *buffers);
+
   /* Compute valid tile size compatible with image saving. */
   int compute_render_tile_size(const int suggested_tile_size) const;
 
@@ -36,6 +36,20 @@ void EdgeDice::reserve(const int num_verts, const int num_triangles)
   mesh->resize_mesh(mesh->get_verts().size() + num_verts, mesh->num_triangles());
   mesh->reserve_mesh(mesh->get_verts().size() + num_verts, mesh->num_triangles() + num_triangles);
 
+  /* Triangles are written at precomputed indices so subpatches can be diced in parallel. */
+  const size_t num_tris = tri_offset + num_triangles;
+  mesh->triangles.resize(num_tris * 3);
+  mesh->shader.resize(num_tris);
+  mesh->smooth.resize(num_tris);
+  mesh->tag_triangles_modified();
+  mesh->tag_shader_modified();
+  mesh->tag_smooth_modified();
+
+  if (mesh->get_num_subd_faces()) {
+    mesh->triangle_patch.resize(num_tris);
+    mesh->tag_triangle_patch_modified();
+  }
+
   Attribute *attr_vN = mesh->attributes.add(ATTR_STD_VERTEX_NORMAL);
 
   mesh_P = mesh->verts.data() + vert_offset;
@@ -58,22 +72,27 @@ void EdgeDice::set_vert(Patch *patch, const int index, const float2 uv)
   params.mesh->vert_patch_uv[index + vert_offset] = make_float2(uv.x, uv.y);
 }
 
-void EdgeDice::add_triangle(Patch *patch, const int v0, const int v1, const int v2)
+void EdgeDice::set_triangle(
+    Patch *patch, const int index, const int v0, const int v1, const int v2)
 {
   Mesh *mesh = params.mesh;
+  const size_t tri = tri_offset + index;
 
-  mesh->add_triangle(v0 + vert_offset, v1 + vert_offset, v2 + vert_offset, patch->shader, true);
-  params.mesh->triangle_patch[params.mesh->num_triangles() - 1] = patch->patch_index;
+  assert(tri < mesh->num_triangles());
 
-  tri_offset++;
+  mesh->triangles[tri * 3 + 0] = v0 + vert_offset;
+  mesh->triangles[tri * 3 + 1] = v1 + vert_offset;
+  mesh->triangles[tri * 3 + 2] = v2 + vert_offset;
+  mesh->shader[tri] = patch->shader;
+  mesh->smooth[tri] = true;
+  mesh->triangle_patch[tri] = patch->patch_index;
 }
 
-void EdgeDice::stitch_triangles(Subpatch &sub, const int edge)
+void EdgeDice::stitch_triangles(Subpatch &sub, const int edge, int &triangle_index)
 {
-  int Mu = max(sub.edge_u0.T, sub.edge_u1.T);
-  int Mv = max(sub.edge_v0.T, sub.edge_v1.T);
-  Mu = max(Mu, 2);
-  Mv = max(Mv, 2);
+  int Mu;
+  int Mv;
+  sub.calc_grid_size(Mu, Mv);
 
   const int outer_T = sub.edges[edge].T;
   const int inner_T = ((edge % 2) == 0) ? Mv - 2 : Mu - 2;
@@ -116,7 +135,7 @@ void EdgeDice::stitch_triangles(Subpatch &sub, const int edge)
       }
     }
 
-    add_triangle(sub.patch, v1, v0, v2);
+    set_triangle(sub.patch, triangle_index++, v1, v0, v2);
   }
 }
 
@@ -225,6 +244,7 @@ void QuadDice::add_grid(Subpatch &sub, const int Mu, const int Mv, const int off
   /* create inner grid */
   const float du = 1.0f / (float)Mu;
   const float dv = 1.0f / (float)Mv;
+  int triangle_index = sub.triangle_offset;
 
   for (int j = 1; j < Mv; j++) {
     for (int i = 1; i < Mu; i++) {
@@ -239,41 +259,42 @@ void QuadDice::add_grid(Subpatch &sub, const int Mu, const int Mv, const int off
         const int i3 = offset + i + j * (Mu - 1);
         const int i4 = offset + (i - 1) + j * (Mu - 1);
 
-        add_triangle(sub.patch, i1, i2, i3);
-        add_triangle(sub.patch, i1, i3, i4);
+        set_triangle(sub.patch, triangle_index++, i1, i2, i3);
+        set_triangle(sub.patch, triangle_index++, i1, i3, i4);
       }
     }
   }
 }
 
-void QuadDice::dice(Subpatch &sub)
+void QuadDice::dice_grid(Subpatch &sub)
 {
-  /* compute inner grid size with scale factor */
-  int Mu = max(sub.edge_u0.T, sub.edge_u1.T);
-  int Mv = max(sub.edge_v0.T, sub.edge_v1.T);
-
-#if 0 /* Doesn't work very well, especially at grazing angles. */
-  const float S = scale_factor(sub, ef, Mu, Mv);
-#else
-  const float S = 1.0f;
-#endif
-
-  Mu = max((int)ceilf(S * Mu), 2);  // XXX handle 0 & 1?
-  Mv = max((int)ceilf(S * Mv), 2);  // XXX handle 0 & 1?
+  /* The grid size is not scaled with #scale_factor, it doesn't work very well, especially at
+   * grazing angles. The triangle offsets of the subpatches are also computed without it. */
+  int Mu;
+  int Mv;
+  sub.calc_grid_size(Mu, Mv);
 
   /* inner grid */
   add_grid(sub, Mu, Mv, sub.inner_grid_vert_offset);
+}
 
-  /* sides */
+void QuadDice::dice_sides(Subpatch &sub)
+{
   set_side(sub, 0);
   set_side(sub, 1);
   set_side(sub, 2);
   set_side(sub, 3);
+}
+
+void QuadDice::dice_stitch(Subpatch &sub)
+{
+  /* stitching triangles follow the inner grid triangles */
+  int triangle_index = sub.triangle_offset + sub.calc_num_inner_triangles();
 
-  stitch_triangles(sub, 0);
-  stitch_triangles(sub, 1);
-  stitch_triangles(sub, 2);
-  stitch_triangles(sub, 3);
+  stitch_triangles(sub, 0, triangle_index);
+  stitch_triangles(sub, 1, triangle_index);
+  stitch_triangles(sub, 2, triangle_index);
+  stitch_triangles(sub, 3, triangle_index);
 }
 
 CCL_NAMESPACE_END
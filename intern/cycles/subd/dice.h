@@ -58,9 +58,9 @@ class EdgeDice {
   void reserve(const int num_verts, const int num_triangles);
 
   void set_vert(Patch *patch, const int index, const float2 uv);
-  void add_triangle(Patch *patch, const int v0, const int v1, const int v2);
+  void set_triangle(Patch *patch, const int index, const int v0, const int v1, const int v2);
 
-  void stitch_triangles(Subpatch &sub, const int edge);
+  void stitch_triangles(Subpatch &sub, const int edge, int &triangle_index);
 };
 
 /* Quad EdgeDice */
@@ -81,7 +81,12 @@ class QuadDice : public EdgeDice {
   float quad_area(const float3 &a, const float3 &b, const float3 &c, const float3 &d);
   float scale_factor(Subpatch &sub, const int Mu, const int Mv);
 
-  void dice(Subpatch &sub);
+  /* Dicing is split in three stages so the grid and stitching stages can run in parallel
+   * across subpatches. Only the vertices on the sides are shared between neighboring
+   * subpatches, those are set serially in subpatch order. */
+  void dice_grid(Subpatch &sub);
+  void dice_sides(Subpatch &sub);
+  void dice_stitch(Subpatch &sub);
 };
 
 CCL_NAMESPACE_END
@@ -13,6 +13,7 @@
 
 #include "util/hash.h"
 #include "util/math.h"
+#include "util/tbb.h"
 #include "util/types.h"
 
 CCL_NAMESPACE_BEGIN
@@ -726,14 +727,6 @@ void DiagSplit::post_split()
   int num_verts = num_alloced_verts;
   int num_triangles = 0;
 
-  for (size_t i = 0; i < subpatches.size(); i++) {
-    subpatches[i].inner_grid_vert_offset = num_verts;
-    num_verts += subpatches[i].calc_num_inner_verts();
-    num_triangles += subpatches[i].calc_num_triangles();
-  }
-
-  dice.reserve(num_verts, num_triangles);
-
   for (size_t i = 0; i < subpatches.size(); i++) {
     Subpatch &sub = subpatches[i];
 
@@ -742,9 +735,37 @@ void DiagSplit::post_split()
     sub.edge_v0.T = max(sub.edge_v0.T, 1);
     sub.edge_v1.T = max(sub.edge_v1.T, 1);
 
-    dice.dice(sub);
+    sub.inner_grid_vert_offset = num_verts;
+    sub.triangle_offset = num_triangles;
+    num_verts += sub.calc_num_inner_verts();
+    num_triangles += sub.calc_num_triangles();
+  }
+
+  dice.reserve(num_verts, num_triangles);
+
+  /* Inner grids and stitching only write vertices and triangles owned by the subpatch, so they
+   * run in parallel. Vertices on the sides are shared with neighboring subpatches and are set
+   * serially, so the result does not depend on scheduling. */
+  const size_t subpatches_per_task = 16;
+
+  parallel_for(blocked_range<size_t>(0, subpatches.size(), subpatches_per_task),
+               [&](const blocked_range<size_t> &r) {
+                 for (size_t i = r.begin(); i != r.end(); i++) {
+                   dice.dice_grid(subpatches[i]);
+                 }
+               });
+
+  for (Subpatch &sub : subpatches) {
+    dice.dice_sides(sub);
   }
 
+  parallel_for(blocked_range<size_t>(0, subpatches.size(), subpatches_per_task),
+               [&](const blocked_range<size_t> &r) {
+                 for (size_t i = r.begin(); i != r.end(); i++) {
+                   dice.dice_stitch(subpatches[i]);
+                 }
+               });
+
   /* Cleanup */
   subpatches.clear();
   edges.clear();
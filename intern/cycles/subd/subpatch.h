@@ -15,6 +15,7 @@ class Subpatch {
  public:
   class Patch *patch; /* Patch this is a subpatch of. */
   int inner_grid_vert_offset;
+  int triangle_offset; /* Index of the first triangle of this subpatch, relative to the dicer. */
 
   struct edge_t {
     int T;
@@ -67,37 +68,49 @@ class Subpatch {
   {
   }
 
+  /* Size of the inner grid. At least 2 in each direction, the triangle and vertex counts and the
+   * dicing must all use this so that subpatches write to their own ranges only. */
+  void calc_grid_size(int &Mu, int &Mv) const
+  {
+    Mu = max(max(edge_u0.T, edge_u1.T), 2);
+    Mv = max(max(edge_v0.T, edge_v1.T), 2);
+  }
+
   int calc_num_inner_verts() const
   {
-    int Mu = fmax(edge_u0.T, edge_u1.T);
-    int Mv = fmax(edge_v0.T, edge_v1.T);
-    Mu = fmax(Mu, 2);
-    Mv = fmax(Mv, 2);
+    int Mu;
+    int Mv;
+    calc_grid_size(Mu, Mv);
     return (Mu - 1) * (Mv - 1);
   }
 
+  int calc_num_inner_triangles() const
+  {
+    int Mu;
+    int Mv;
+    calc_grid_size(Mu, Mv);
+    return (Mu - 2) * (Mv - 2) * 2;
+  }
+
   int calc_num_triangles() const
   {
-    int Mu = fmax(edge_u0.T, edge_u1.T);
-    int Mv = fmax(edge_v0.T, edge_v1.T);
-    Mu = fmax(Mu, 2);
-    Mv = fmax(Mv, 2);
+    int Mu;
+    int Mv;
+    calc_grid_size(Mu, Mv);
 
-    const int inner_triangles = (Mu - 2) * (Mv - 2) * 2;
     const int edge_triangles = edge_u0.T + edge_u1.T + edge_v0.T + edge_v1.T + (Mu - 2) * 2 +
                                (Mv - 2) * 2;
 
-    return inner_triangles + edge_triangles;
+    return calc_num_inner_triangles() + edge_triangles;
   }
 
   int get_vert_along_edge(const int e, const int n) const;
 
   int get_vert_along_grid_edge(const int edge, const int n) const
   {
-    int Mu = fmax(edge_u0.T, edge_u1.T);
-    int Mv = fmax(edge_v0.T, edge_v1.T);
-    Mu = fmax(Mu, 2);
-    Mv = fmax(Mv, 2);
+    int Mu;
+    int Mv;
+    calc_grid_size(Mu, Mv);
 
     switch (edge) {
       case 0:
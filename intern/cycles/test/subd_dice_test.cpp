@@ -0,0 +1,125 @@
+/* SPDX-FileCopyrightText: 2011-2025 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "scene/mesh.h"
+
+#include "subd/dice.h"
+#include "subd/patch.h"
+#include "subd/subpatch.h"
+
+#include "util/tbb.h"
+#include "util/types.h"
+#include "util/vector.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Dice independent subpatches with the given edge factors (in the order of #Subpatch.edges) the
+ * same way as #DiagSplit, and check that every subpatch writes exactly its own range of
+ * triangles, using only its own vertices. */
+static void test_dice_subpatches(const vector<int4> &edge_factors)
+{
+  Mesh mesh;
+  mesh.set_num_subd_faces(1);
+
+  LinearQuadPatch patch;
+  patch.hull[0] = make_float3(0.0f, 0.0f, 0.0f);
+  patch.hull[1] = make_float3(1.0f, 0.0f, 0.0f);
+  patch.hull[2] = make_float3(0.0f, 1.0f, 0.0f);
+  patch.hull[3] = make_float3(1.0f, 1.0f, 0.0f);
+  for (int i = 0; i < 4; i++) {
+    patch.normals[i] = make_float3(0.0f, 0.0f, 1.0f);
+  }
+
+  const int num_subpatches = edge_factors.size();
+  vector<Edge> edges(num_subpatches * 4);
+  vector<Subpatch> subpatches(num_subpatches, Subpatch(&patch));
+  vector<int> vert_subpatch;
+
+  /* Corner and edge vertices, not shared between subpatches. */
+  for (int s = 0; s < num_subpatches; s++) {
+    Subpatch &sub = subpatches[s];
+    const int corner_verts = vert_subpatch.size();
+    vert_subpatch.resize(vert_subpatch.size() + 4, s);
+
+    for (int e = 0; e < 4; e++) {
+      Edge &edge = edges[s * 4 + e];
+      edge.T = edge_factors[s][e];
+      edge.start_vert_index = corner_verts + e;
+      edge.end_vert_index = corner_verts + (e + 1) % 4;
+      edge.second_vert_index = vert_subpatch.size();
+      vert_subpatch.resize(vert_subpatch.size() + edge.T - 1, s);
+
+      sub.edges[e].T = edge.T;
+      sub.edges[e].offset = 0;
+      sub.edges[e].indices_decrease_along_edge = false;
+      sub.edges[e].sub_edges_created_in_reverse_order = false;
+      sub.edges[e].edge = &edge;
+    }
+  }
+
+  int num_triangles = 0;
+  for (int s = 0; s < num_subpatches; s++) {
+    Subpatch &sub = subpatches[s];
+    sub.inner_grid_vert_offset = vert_subpatch.size();
+    sub.triangle_offset = num_triangles;
+    vert_subpatch.resize(vert_subpatch.size() + sub.calc_num_inner_verts(), s);
+    num_triangles += sub.calc_num_triangles();
+  }
+
+  SubdParams params(&mesh);
+  QuadDice dice(params);
+  dice.reserve(vert_subpatch.size(), num_triangles);
+
+  array<int> &triangles = mesh.get_triangles();
+  ASSERT_EQ(triangles.size(), size_t(num_triangles) * 3);
+  std::fill(triangles.begin(), triangles.end(), -1);
+
+  const blocked_range<size_t> range(0, subpatches.size(), 1);
+  parallel_for(range, [&](const blocked_range<size_t> &r) {
+    for (size_t i = r.begin(); i != r.end(); i++) {
+      dice.dice_grid(subpatches[i]);
+    }
+  });
+  for (Subpatch &sub : subpatches) {
+    dice.dice_sides(sub);
+  }
+  parallel_for(range, [&](const blocked_range<size_t> &r) {
+    for (size_t i = r.begin(); i != r.end(); i++) {
+      dice.dice_stitch(subpatches[i]);
+    }
+  });
+
+  for (int s = 0; s < num_subpatches; s++) {
+    const Subpatch &sub = subpatches[s];
+    for (int t = 0; t < sub.calc_num_triangles(); t++) {
+      for (int k = 0; k < 3; k++) {
+        const int vert = triangles[(sub.triangle_offset + t) * 3 + k];
+        ASSERT_GE(vert, 0) << "Triangle " << t << " of subpatch " << s << " not written";
+        EXPECT_EQ(vert_subpatch[vert], s) << "Triangle " << t << " of subpatch " << s;
+      }
+    }
+  }
+}
+
+TEST(subd_dice, edge_factor_one)
+{
+  test_dice_subpatches(vector<int4>(64, make_int4(1, 1, 1, 1)));
+}
+
+TEST(subd_dice, mixed_edge_factors)
+{
+  vector<int4> edge_factors;
+  for (int i = 0; i < 16; i++) {
+    edge_factors.push_back(make_int4(1, 1, 1, 1));
+    edge_factors.push_back(make_int4(3, 1, 3, 1));
+    edge_factors.push_back(make_int4(1, 3, 1, 3));
+    edge_factors.push_back(make_int4(2, 5, 1, 4));
+    edge_factors.push_back(make_int4(4, 4, 4, 4));
+  }
+  test_dice_subpatches(edge_factors);
+}
+
+CCL_NAMESPACE_END
@@ -780,6 +780,17 @@ bool path_remove(const string &path)
   return remove(path.c_str()) == 0;
 }
 
+bool path_rename(const string &from, const string &to)
+{
+#ifdef _WIN32
+  return MoveFileExW(string_to_wstring(from).c_str(),
+                     string_to_wstring(to).c_str(),
+                     MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+  return rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
 struct SourceReplaceState {
   using ProcessedMapping = map<string, string>;
   /* Base director for all relative include headers. */
@@ -1034,4 +1045,28 @@ void path_cache_kernel_mark_added_and_clear_old(const string &new_path,
   }
 }
 
+void path_cache_clear_old(const string &dir, const size_t max_files)
+{
+  if (!path_exists(dir)) {
+    return;
+  }
+
+  directory_iterator it(dir);
+  const directory_iterator it_end;
+  vector<pair<std::time_t, string>> files;
+
+  for (; it != it_end; ++it) {
+    const string &path = it->path();
+    files.emplace_back(OIIO::Filesystem::last_write_time(path), path);
+  }
+
+  if (files.size() > max_files) {
+    sort(files.begin(), files.end());
+
+    for (size_t i = 0; i < files.size() - max_files; i++) {
+      path_remove(files[i].second);
+    }
+  }
+}
+
 CCL_NAMESPACE_END
@@ -52,6 +52,9 @@ bool path_read_compressed_text(const string &path, string &text);
 
 /* File manipulation. */
 bool path_remove(const string &path);
+/* Move a file, atomically replacing any existing file at the destination. Both paths must be on
+ * the same file system. */
+bool path_rename(const string &from, const string &to);
 
 /* source code utility */
 string path_source_replace_includes(const string &source, const string &path);
@@ -65,5 +68,7 @@ string path_source_replace_includes(const string &source, const string &path);
 bool path_cache_kernel_exists_and_mark_used(const string &path);
 void path_cache_kernel_mark_added_and_clear_old(const string &path,
                                                 const size_t max_old_kernel_of_same_type = 5);
+/* Remove the least recently used files in a cache directory, keeping at most max_files. */
+void path_cache_clear_old(const string &dir, const size_t max_files);
 
 CCL_NAMESPACE_END
@@ -65,6 +65,8 @@ void Profiler::reset(const int num_shaders, const int num_objects)
   shader_hits.assign(num_shaders, 0);
   object_hits.assign(num_objects, 0);
 
+  event_hits.assign(PROFILING_NUM_EVENTS, 0);
+
   event_samples.assign(PROFILING_NUM_EVENTS, 0);
   shader_samples.assign(num_shaders, 0);
   object_samples.assign(num_objects, 0);
@@ -102,6 +104,7 @@ void Profiler::add_state(ProfilingState *state)
   /* Resize thread-local hit counters. */
   state->shader_hits.assign(shader_hits.size(), 0);
   state->object_hits.assign(object_hits.size(), 0);
+  state->event_hits.assign(PROFILING_NUM_EVENTS, 0);
 
   /* Initialize the state. */
   state->event = PROFILING_UNKNOWN;
@@ -128,6 +131,11 @@ void Profiler::remove_state(ProfilingState *state)
   for (int i = 0; i < object_hits.size(); i++) {
     object_hits[i] += state->object_hits[i];
   }
+
+  assert(event_hits.size() == state->event_hits.size());
+  for (int i = 0; i < event_hits.size(); i++) {
+    event_hits[i] += state->event_hits[i];
+  }
 }
 
 uint64_t Profiler::get_event(ProfilingEvent event)
@@ -136,6 +144,12 @@ uint64_t Profiler::get_event(ProfilingEvent event)
   return event_samples[event];
 }
 
+uint64_t Profiler::get_event_hits(ProfilingEvent event)
+{
+  assert(worker == nullptr);
+  return event_hits[event];
+}
+
 bool Profiler::get_shader(const int shader, uint64_t &samples, uint64_t &hits)
 {
   assert(worker == nullptr);
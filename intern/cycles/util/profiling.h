@@ -66,6 +66,18 @@ struct ProfilingState {
 
   vector<uint64_t> shader_hits;
   vector<uint64_t> object_hits;
+
+  /* Number of times each event was entered by this thread. Unlike the sampled time these are
+   * exact, and merged into the profiler when the state is removed. */
+  vector<uint64_t> event_hits;
+
+  void count_event(const uint32_t new_event)
+  {
+    if (active) {
+      assert(new_event < event_hits.size());
+      event_hits[new_event]++;
+    }
+  }
 };
 
 class Profiler {
@@ -82,6 +94,7 @@ class Profiler {
   void remove_state(ProfilingState *state);
 
   uint64_t get_event(ProfilingEvent event);
+  uint64_t get_event_hits(ProfilingEvent event);
   bool get_shader(const int shader, uint64_t &samples, uint64_t &hits);
   bool get_object(const int object, uint64_t &samples, uint64_t &hits);
 
@@ -104,6 +117,9 @@ class Profiler {
   vector<uint64_t> shader_hits;
   vector<uint64_t> object_hits;
 
+  /* Tracks the total amount of times every event was entered, written by the render thread. */
+  vector<uint64_t> event_hits;
+
   volatile bool do_stop_worker;
   unique_ptr<thread> worker;
 
@@ -117,6 +133,7 @@ class ProfilingHelper {
   {
     previous_event = state->event;
     state->event = event;
+    state->count_event(event);
   }
 
   ~ProfilingHelper()
@@ -127,6 +144,7 @@ class ProfilingHelper {
   void set_event(ProfilingEvent event)
   {
     state->event = event;
+    state->count_event(event);
   }
 
  protected:
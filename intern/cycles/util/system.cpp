@@ -137,6 +137,7 @@ int system_cpu_bits()
 struct CPUCapabilities {
   bool sse42;
   bool avx2;
+  bool avx512;
 };
 
 static CPUCapabilities &system_cpu_capabilities()
@@ -190,6 +191,17 @@ static CPUCapabilities &system_cpu_capabilities()
 
         caps.avx2 = sse && sse2 && sse3 && ssse3 && sse41 && sse42 && avx && f16c && avx2 &&
                     fma3 && bmi1 && bmi2;
+
+        /* Check if the OS will save the opmask and ZMM registers. */
+        const bool os_avx512 = (xcr_feature_mask & 0xe6) == 0xe6;
+        const bool avx512f = (result[1] & ((int)1 << 16)) != 0;
+        const bool avx512dq = (result[1] & ((int)1 << 17)) != 0;
+        const bool avx512cd = (result[1] & ((int)1 << 28)) != 0;
+        const bool avx512bw = (result[1] & ((int)1 << 30)) != 0;
+        const bool avx512vl = ((unsigned int)result[1] & (1u << 31)) != 0;
+
+        caps.avx512 = caps.avx2 && os_avx512 && avx512f && avx512dq && avx512cd && avx512bw &&
+                      avx512vl;
       }
     }
 
@@ -210,6 +222,12 @@ bool system_cpu_support_avx2()
   CPUCapabilities &caps = system_cpu_capabilities();
   return caps.avx2;
 }
+
+bool system_cpu_support_avx512()
+{
+  CPUCapabilities &caps = system_cpu_capabilities();
+  return caps.avx512;
+}
 #else
 
 bool system_cpu_support_sse42()
@@ -222,6 +240,11 @@ bool system_cpu_support_avx2()
   return false;
 }
 
+bool system_cpu_support_avx512()
+{
+  return false;
+}
+
 #endif
 
 size_t system_physical_ram()
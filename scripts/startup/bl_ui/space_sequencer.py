@@ -10,6 +10,7 @@ from bpy.types import (
 )
 from bpy.app.translations import (
     contexts as i18n_contexts,
+    pgettext_iface as iface_,
     pgettext_rpt as rpt_,
 )
 from bl_ui.properties_grease_pencil_common import (
@@ -1978,6 +1979,18 @@ class SEQUENCER_PT_source(SequencerButtonsPanel, Panel):
                 split.label(text="FPS")
                 split.alignment = 'LEFT'
                 split.label(text="{:.2f}".format(elem.orig_fps), translate=False)
+            # Decoded frame cache.
+            if strip_type == 'MOVIE' and strip.decode_cache_frames:
+                split = col.split(factor=0.5, align=False)
+                split.alignment = 'RIGHT'
+                split.label(text="Decode Cache")
+                split.alignment = 'LEFT'
+                split.label(
+                    text=iface_("{:d} frames, {:.1f} MB, {:.0%} hits").format(
+                        strip.decode_cache_frames, strip.decode_cache_memory, strip.decode_cache_hit_ratio,
+                    ),
+                    translate=False,
+                )
 
 
 class SEQUENCER_PT_movie_clip(SequencerButtonsPanel, Panel):
@@ -2726,6 +2739,9 @@ class SEQUENCER_PT_view(SequencerButtonsPanel_Output, Panel):
         col = layout.column()
         if ed:
             col.prop(ed, "use_prefetch")
+            sub = col.column()
+            sub.active = ed.use_prefetch
+            sub.prop(ed, "use_prefetch_multi_frame")
 
         col.prop(st, "display_channel", text="Channel")
 
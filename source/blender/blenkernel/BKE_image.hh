@@ -296,6 +296,19 @@ void BKE_image_user_id_eval_animation(Depsgraph *depsgraph, ID *id);
  * don't correct for wrong indices here.
  */
 RenderPass *BKE_image_multilayer_index(RenderResult *rr, ImageUser *iuser);
+/**
+ * Read the pixels of the given pass of the render result of a multilayer image if they were not
+ * read yet, since the passes of multilayer files are only read when needed. This is only needed
+ * when accessing the passes of the render result directly instead of acquiring their image
+ * buffers.
+ */
+void BKE_image_multilayer_pass_ensure_loaded(Image *ima, RenderPass *rpass);
+/**
+ * Read the pixels of all passes of the render result of a multilayer image that were not read
+ * yet, reading the file once. Needed before using the pixels of the render result as a whole, see
+ * #BKE_image_acquire_renderresult.
+ */
+void BKE_image_multilayer_ensure_loaded(Image *ima);
 
 /**
  * Sets index offset for multi-view files.
@@ -320,6 +333,10 @@ bool BKE_image_is_stereo(const Image *ima);
  *
  * It is allowed to call #BKE_image_release_renderresult with render_result of nullptr, but it is
  * not required.
+ *
+ * The passes of multilayer images might not have their pixels read yet, so callers that use the
+ * pixels of the passes should call #BKE_image_multilayer_ensure_loaded first. Callers that only
+ * use the structure or meta-data of the render result don't need to.
  */
 RenderResult *BKE_image_acquire_renderresult(Scene *scene, Image *ima);
 void BKE_image_release_renderresult(Scene *scene, Image *ima, RenderResult *render_result);
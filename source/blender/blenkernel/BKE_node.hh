@@ -135,6 +135,9 @@ using NodeGetCompositorOperationFunction =
                                             blender::nodes::DNode node);
 using NodeGetCompositorShaderNodeFunction =
     blender::compositor::ShaderNode *(*)(blender::nodes::DNode node);
+using NodeGetCompositorTileHaloFunction = std::optional<int> (*)(const bNode &node);
+using NodeGetCompositorExternalDataHashFunction =
+    std::optional<uint64_t> (*)(blender::compositor::Context &context, blender::nodes::DNode node);
 using NodeExtraInfoFunction = void (*)(blender::nodes::NodeExtraInfoParams &params);
 using NodeInverseElemEvalFunction =
     void (*)(blender::nodes::value_elem::InverseElemEvalParams &params);
@@ -337,6 +340,20 @@ struct bNodeType {
    * responsibility of the caller. */
   NodeGetCompositorShaderNodeFunction get_compositor_shader_node = nullptr;
 
+  /* Get the number of pixels around an output pixel that the compositor operation of this node
+   * reads from its inputs, which is the halo needed to evaluate the node on a tile of the image.
+   * Returns std::nullopt if the node needs the whole image, like nodes that compute global
+   * properties or transform their inputs. A nullptr means the same, while pixel nodes never read
+   * neighboring pixels and need not define it. */
+  NodeGetCompositorTileHaloFunction get_compositor_tile_halo = nullptr;
+
+  /* Get a hash that identifies the data outside of the node tree that the compositor operation of
+   * this node reads, like render passes, which is needed to cache the results of the node across
+   * evaluations. Returns std::nullopt if the data can't be identified, in which case the results
+   * of the node and the nodes that depend on it are never cached. A nullptr means the node reads
+   * no such data, unless it references an ID, in which case it is treated as unidentifiable. */
+  NodeGetCompositorExternalDataHashFunction get_compositor_external_data_hash = nullptr;
+
   /* A message to display in the node header for unsupported compositor nodes. The message
    * is assumed to be static and thus require no memory handling. This field is to be removed when
    * all nodes are supported. */
@@ -15,9 +15,13 @@
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_math_geom.h"
+#include "BLI_math_matrix.h"
 #include "BLI_math_vector.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
+#include "BLI_time.h"
 
 #include "BKE_cloth.hh"
 #include "BKE_collection.hh"
@@ -30,10 +34,14 @@
 #include "DEG_depsgraph_physics.hh"
 #include "DEG_depsgraph_query.hh"
 
+#include "CLG_log.h"
+
 #ifdef WITH_ELTOPO
 #  include "eltopo-capi.h"
 #endif
 
+static CLG_LogRef LOG = {"bke.collision"};
+
 struct ColDetectData {
   ClothModifierData *clmd;
   CollisionModifierData *collmd;
@@ -786,93 +794,122 @@ static int cloth_collision_response_static(ClothModifierData *clmd,
   return result;
 }
 
-static int cloth_selfcollision_response_static(ClothModifierData *clmd,
-                                               CollPair *collpair,
-                                               uint collision_count,
-                                               const float dt)
+/** Impulses for the vertices of both triangles of a self-collision pair. */
+struct SelfCollisionImpulse {
+  float ia[3][3];
+  float ib[3][3];
+};
+
+/**
+ * Compute the impulses of a single self-collision pair.
+ *
+ * \note This only reads the cloth state, so pairs can be processed in parallel.
+ *
+ * \return false when the pair doesn't need a response.
+ */
+static bool cloth_selfcollision_impulse_calc(const ClothModifierData *clmd,
+                                             const CollPair *collpair,
+                                             const float time_multiplier,
+                                             const float min_distance,
+                                             SelfCollisionImpulse &r_impulse)
 {
-  int result = 0;
-  Cloth *cloth = clmd->clothObject;
-  const float clamp_sq = square_f(clmd->coll_parms->self_clamp * dt);
-  const float time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale);
-  const float min_distance = (2.0f * clmd->coll_parms->selfepsilon) * (8.0f / 9.0f);
+  const Cloth *cloth = clmd->clothObject;
+  float(*ia)[3] = r_impulse.ia;
+  float(*ib)[3] = r_impulse.ib;
+  float v1[3], v2[3], relativeVelocity[3];
 
-  for (int i = 0; i < collision_count; i++, collpair++) {
-    float ia[3][3] = {{0.0f}};
-    float ib[3][3] = {{0.0f}};
-    float v1[3], v2[3], relativeVelocity[3];
+  zero_m3(ia);
+  zero_m3(ib);
 
-    /* Only handle static collisions here. */
-    if (collpair->flag & (COLLISION_IN_FUTURE | COLLISION_INACTIVE)) {
-      continue;
-    }
+  /* Only handle static collisions here. */
+  if (collpair->flag & (COLLISION_IN_FUTURE | COLLISION_INACTIVE)) {
+    return false;
+  }
 
-    /* Retrieve barycentric coordinates for both collision points. */
-    float w1 = collpair->aw1, w2 = collpair->aw2, w3 = collpair->aw3;
-    float u1 = collpair->bw1, u2 = collpair->bw2, u3 = collpair->bw3;
+  /* Retrieve barycentric coordinates for both collision points. */
+  float w1 = collpair->aw1, w2 = collpair->aw2, w3 = collpair->aw3;
+  float u1 = collpair->bw1, u2 = collpair->bw2, u3 = collpair->bw3;
 
-    /* Calculate relative "velocity". */
-    collision_interpolateOnTriangle(v1,
-                                    cloth->verts[collpair->ap1].tv,
-                                    cloth->verts[collpair->ap2].tv,
-                                    cloth->verts[collpair->ap3].tv,
-                                    w1,
-                                    w2,
-                                    w3);
+  /* Calculate relative "velocity". */
+  collision_interpolateOnTriangle(v1,
+                                  cloth->verts[collpair->ap1].tv,
+                                  cloth->verts[collpair->ap2].tv,
+                                  cloth->verts[collpair->ap3].tv,
+                                  w1,
+                                  w2,
+                                  w3);
 
-    collision_interpolateOnTriangle(v2,
-                                    cloth->verts[collpair->bp1].tv,
-                                    cloth->verts[collpair->bp2].tv,
-                                    cloth->verts[collpair->bp3].tv,
-                                    u1,
-                                    u2,
-                                    u3);
+  collision_interpolateOnTriangle(v2,
+                                  cloth->verts[collpair->bp1].tv,
+                                  cloth->verts[collpair->bp2].tv,
+                                  cloth->verts[collpair->bp3].tv,
+                                  u1,
+                                  u2,
+                                  u3);
 
-    sub_v3_v3v3(relativeVelocity, v2, v1);
+  sub_v3_v3v3(relativeVelocity, v2, v1);
 
-    /* Calculate the normal component of the relative velocity
-     * (actually only the magnitude - the direction is stored in 'normal'). */
-    const float magrelVel = dot_v3v3(relativeVelocity, collpair->normal);
-    const float d = min_distance - collpair->distance;
+  /* Calculate the normal component of the relative velocity
+   * (actually only the magnitude - the direction is stored in 'normal'). */
+  const float magrelVel = dot_v3v3(relativeVelocity, collpair->normal);
+  const float d = min_distance - collpair->distance;
 
-    /* TODO: Impulses should be weighed by mass as this is self col,
-     * this has to be done after mass distribution is implemented. */
+  /* TODO: Impulses should be weighed by mass as this is self col,
+   * this has to be done after mass distribution is implemented. */
 
-    /* If magrelVel < 0 the edges are approaching each other. */
-    if (magrelVel > 0.0f) {
-      /* Calculate Impulse magnitude to stop all motion in normal direction. */
-      float magtangent = 0, repulse = 0;
-      double impulse = 0.0;
-      float vrel_t_pre[3];
-      float temp[3];
+  /* If magrelVel < 0 the edges are approaching each other. */
+  if (magrelVel > 0.0f) {
+    /* Calculate Impulse magnitude to stop all motion in normal direction. */
+    float magtangent = 0, repulse = 0;
+    double impulse = 0.0;
+    float vrel_t_pre[3];
+    float temp[3];
 
-      /* Calculate tangential velocity. */
-      copy_v3_v3(temp, collpair->normal);
-      mul_v3_fl(temp, magrelVel);
-      sub_v3_v3v3(vrel_t_pre, relativeVelocity, temp);
+    /* Calculate tangential velocity. */
+    copy_v3_v3(temp, collpair->normal);
+    mul_v3_fl(temp, magrelVel);
+    sub_v3_v3v3(vrel_t_pre, relativeVelocity, temp);
 
-      /* Decrease in magnitude of relative tangential velocity due to coulomb friction
-       * in original formula "magrelVel" should be the
-       * "change of relative velocity in normal direction". */
-      magtangent = min_ff(clmd->coll_parms->self_friction * 0.01f * magrelVel, len_v3(vrel_t_pre));
+    /* Decrease in magnitude of relative tangential velocity due to coulomb friction
+     * in original formula "magrelVel" should be the
+     * "change of relative velocity in normal direction". */
+    magtangent = min_ff(clmd->coll_parms->self_friction * 0.01f * magrelVel, len_v3(vrel_t_pre));
 
-      /* Apply friction impulse. */
-      if (magtangent > ALMOST_ZERO) {
-        normalize_v3(vrel_t_pre);
+    /* Apply friction impulse. */
+    if (magtangent > ALMOST_ZERO) {
+      normalize_v3(vrel_t_pre);
 
-        impulse = magtangent / 1.5;
+      impulse = magtangent / 1.5;
 
-        VECADDMUL(ia[0], vrel_t_pre, double(w1) * impulse);
-        VECADDMUL(ia[1], vrel_t_pre, double(w2) * impulse);
-        VECADDMUL(ia[2], vrel_t_pre, double(w3) * impulse);
+      VECADDMUL(ia[0], vrel_t_pre, double(w1) * impulse);
+      VECADDMUL(ia[1], vrel_t_pre, double(w2) * impulse);
+      VECADDMUL(ia[2], vrel_t_pre, double(w3) * impulse);
 
-        VECADDMUL(ib[0], vrel_t_pre, double(u1) * -impulse);
-        VECADDMUL(ib[1], vrel_t_pre, double(u2) * -impulse);
-        VECADDMUL(ib[2], vrel_t_pre, double(u3) * -impulse);
+      VECADDMUL(ib[0], vrel_t_pre, double(u1) * -impulse);
+      VECADDMUL(ib[1], vrel_t_pre, double(u2) * -impulse);
+      VECADDMUL(ib[2], vrel_t_pre, double(u3) * -impulse);
+    }
+
+    /* Apply velocity stopping impulse. */
+    impulse = magrelVel / 3.0f;
+
+    VECADDMUL(ia[0], collpair->normal, double(w1) * impulse);
+    VECADDMUL(ia[1], collpair->normal, double(w2) * impulse);
+    VECADDMUL(ia[2], collpair->normal, double(w3) * impulse);
+
+    VECADDMUL(ib[0], collpair->normal, double(u1) * -impulse);
+    VECADDMUL(ib[1], collpair->normal, double(u2) * -impulse);
+    VECADDMUL(ib[2], collpair->normal, double(u3) * -impulse);
+
+    if ((magrelVel < 0.1f * d * time_multiplier) && (d > ALMOST_ZERO)) {
+      repulse = std::min(d / time_multiplier, 0.1f * d * time_multiplier - magrelVel);
+
+      if (impulse > ALMOST_ZERO) {
+        repulse = min_ff(repulse, 5.0 * impulse);
       }
 
-      /* Apply velocity stopping impulse. */
-      impulse = magrelVel / 3.0f;
+      repulse = max_ff(impulse, repulse);
+      impulse = repulse / 1.5f;
 
       VECADDMUL(ia[0], collpair->normal, double(w1) * impulse);
       VECADDMUL(ia[1], collpair->normal, double(w2) * impulse);
@@ -881,53 +918,67 @@ static int cloth_selfcollision_response_static(ClothModifierData *clmd,
       VECADDMUL(ib[0], collpair->normal, double(u1) * -impulse);
       VECADDMUL(ib[1], collpair->normal, double(u2) * -impulse);
       VECADDMUL(ib[2], collpair->normal, double(u3) * -impulse);
+    }
 
-      if ((magrelVel < 0.1f * d * time_multiplier) && (d > ALMOST_ZERO)) {
-        repulse = std::min(d / time_multiplier, 0.1f * d * time_multiplier - magrelVel);
-
-        if (impulse > ALMOST_ZERO) {
-          repulse = min_ff(repulse, 5.0 * impulse);
-        }
-
-        repulse = max_ff(impulse, repulse);
-        impulse = repulse / 1.5f;
+    return true;
+  }
+  if (d > ALMOST_ZERO) {
+    /* Stay on the safe side and clamp repulse. */
+    float repulse = d * 1.0f / time_multiplier;
+    float impulse = repulse / 9.0f;
 
-        VECADDMUL(ia[0], collpair->normal, double(w1) * impulse);
-        VECADDMUL(ia[1], collpair->normal, double(w2) * impulse);
-        VECADDMUL(ia[2], collpair->normal, double(w3) * impulse);
+    VECADDMUL(ia[0], collpair->normal, w1 * impulse);
+    VECADDMUL(ia[1], collpair->normal, w2 * impulse);
+    VECADDMUL(ia[2], collpair->normal, w3 * impulse);
 
-        VECADDMUL(ib[0], collpair->normal, double(u1) * -impulse);
-        VECADDMUL(ib[1], collpair->normal, double(u2) * -impulse);
-        VECADDMUL(ib[2], collpair->normal, double(u3) * -impulse);
-      }
+    VECADDMUL(ib[0], collpair->normal, u1 * -impulse);
+    VECADDMUL(ib[1], collpair->normal, u2 * -impulse);
+    VECADDMUL(ib[2], collpair->normal, u3 * -impulse);
 
-      result = 1;
-    }
-    else if (d > ALMOST_ZERO) {
-      /* Stay on the safe side and clamp repulse. */
-      float repulse = d * 1.0f / time_multiplier;
-      float impulse = repulse / 9.0f;
+    return true;
+  }
 
-      VECADDMUL(ia[0], collpair->normal, w1 * impulse);
-      VECADDMUL(ia[1], collpair->normal, w2 * impulse);
-      VECADDMUL(ia[2], collpair->normal, w3 * impulse);
+  return false;
+}
 
-      VECADDMUL(ib[0], collpair->normal, u1 * -impulse);
-      VECADDMUL(ib[1], collpair->normal, u2 * -impulse);
-      VECADDMUL(ib[2], collpair->normal, u3 * -impulse);
+static int cloth_selfcollision_response_static(ClothModifierData *clmd,
+                                               CollPair *collpair,
+                                               uint collision_count,
+                                               const float dt)
+{
+  using namespace blender;
+  int result = 0;
+  Cloth *cloth = clmd->clothObject;
+  const float clamp_sq = square_f(clmd->coll_parms->self_clamp * dt);
+  const float time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale);
+  const float min_distance = (2.0f * clmd->coll_parms->selfepsilon) * (8.0f / 9.0f);
 
-      result = 1;
+  /* The impulses of all pairs are computed in parallel. Since vertices are shared between pairs,
+   * accumulating them into the vertices is done afterwards in pair order, which keeps the result
+   * independent of the number of threads without any locking. */
+  Array<SelfCollisionImpulse> impulses(collision_count);
+  Array<bool> active(collision_count);
+  threading::parallel_for(IndexRange(collision_count), 256, [&](const IndexRange range) {
+    for (const int i : range) {
+      active[i] = cloth_selfcollision_impulse_calc(
+          clmd, &collpair[i], time_multiplier, min_distance, impulses[i]);
     }
+  });
 
-    if (result) {
-      cloth_collision_impulse_vert(clamp_sq, ia[0], &cloth->verts[collpair->ap1]);
-      cloth_collision_impulse_vert(clamp_sq, ia[1], &cloth->verts[collpair->ap2]);
-      cloth_collision_impulse_vert(clamp_sq, ia[2], &cloth->verts[collpair->ap3]);
-
-      cloth_collision_impulse_vert(clamp_sq, ib[0], &cloth->verts[collpair->bp1]);
-      cloth_collision_impulse_vert(clamp_sq, ib[1], &cloth->verts[collpair->bp2]);
-      cloth_collision_impulse_vert(clamp_sq, ib[2], &cloth->verts[collpair->bp3]);
+  for (const int i : IndexRange(collision_count)) {
+    if (!active[i]) {
+      continue;
     }
+    const CollPair &pair = collpair[i];
+    const SelfCollisionImpulse &impulse = impulses[i];
+    cloth_collision_impulse_vert(clamp_sq, impulse.ia[0], &cloth->verts[pair.ap1]);
+    cloth_collision_impulse_vert(clamp_sq, impulse.ia[1], &cloth->verts[pair.ap2]);
+    cloth_collision_impulse_vert(clamp_sq, impulse.ia[2], &cloth->verts[pair.ap3]);
+
+    cloth_collision_impulse_vert(clamp_sq, impulse.ib[0], &cloth->verts[pair.bp1]);
+    cloth_collision_impulse_vert(clamp_sq, impulse.ib[1], &cloth->verts[pair.bp2]);
+    cloth_collision_impulse_vert(clamp_sq, impulse.ib[2], &cloth->verts[pair.bp3]);
+    result = 1;
   }
 
   return result;
@@ -1562,6 +1613,8 @@ int cloth_bvh_collision(
   verts = cloth->verts;
   mvert_num = cloth->mvert_num;
 
+  const double start_time = BLI_time_now_seconds();
+
   if (clmd->coll_parms->flags & CLOTH_COLLSETTINGS_FLAG_ENABLED) {
     bvhtree_update_from_cloth(clmd, false, false);
     bvh_updated = true;
@@ -1609,6 +1662,8 @@ int cloth_bvh_collision(
         cloth->bvhselftree, &coll_count_self, cloth_bvh_self_overlap_cb, clmd);
   }
 
+  const double broadphase_end_time = BLI_time_now_seconds();
+
   do {
     ret2 = 0;
 
@@ -1693,6 +1748,17 @@ int cloth_bvh_collision(
     rounds++;
   } while (ret2 && (clmd->coll_parms->loop_count > rounds));
 
+  CLOG_INFO(&LOG,
+            2,
+            "Collision step with %u colliders and %u self-collision candidate pairs took %f "
+            "seconds (broad-phase %f, narrow-phase and response %f over %d rounds).",
+            numcollobj,
+            coll_count_self,
+            BLI_time_now_seconds() - start_time,
+            broadphase_end_time - start_time,
+            BLI_time_now_seconds() - broadphase_end_time,
+            rounds);
+
   if (overlap_obj) {
     for (i = 0; i < numcollobj; i++) {
       MEM_SAFE_FREE(overlap_obj[i]);
@@ -122,7 +122,7 @@ ImBuf *BKE_icon_geom_rasterize(const Icon_Geom *geom, const uint size_x, const u
       BLI_bitmap_draw_2d_tri_v2i(UNPACK3(data.pt), tri_fill_smooth, &data);
     }
   }
-  IMB_scale(ibuf, size_x, size_y, IMBScaleFilter::Box, false);
+  IMB_scale(ibuf, size_x, size_y, IMBScaleFilter::Box);
   return ibuf;
 }
 
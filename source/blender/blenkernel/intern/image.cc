@@ -817,7 +817,7 @@ bool BKE_image_scale(Image *image, int width, int height, ImageUser *iuser)
   ibuf = BKE_image_acquire_ibuf(image, iuser, &lock);
 
   if (ibuf) {
-    IMB_scale(ibuf, width, height, IMBScaleFilter::Box, false);
+    IMB_scale(ibuf, width, height, IMBScaleFilter::Box);
     BKE_image_mark_dirty(image, ibuf);
   }
 
@@ -3912,6 +3912,60 @@ static void image_init_multilayer_multiview(Image *ima, RenderResult *rr)
   }
 }
 
+/* Multilayer files that are not packed are loaded lazily, that is, only the structure of their
+ * render result is read when loading, and the pixels of each pass are read from the file the first
+ * time the pass is needed, which avoids reading and storing all passes of files with many passes
+ * when only a few of them are used. See #IB_multilayer_lazy. Once read, passes are kept in the
+ * render result of the image until its buffers are freed.
+ *
+ * Read the given pass if it is not null, otherwise, read all passes that were not read yet. */
+static void image_multilayer_passes_ensure_loaded(Image *ima, RenderPass *rpass)
+{
+  if (rpass && rpass->ibuf) {
+    return;
+  }
+
+  if (!rpass) {
+    bool has_unloaded_pass = false;
+    LISTBASE_FOREACH (RenderLayer *, rl, &ima->rr->layers) {
+      LISTBASE_FOREACH (RenderPass *, iter_rpass, &rl->passes) {
+        has_unloaded_pass |= iter_rpass->ibuf == nullptr;
+      }
+    }
+    if (!has_unloaded_pass) {
+      return;
+    }
+  }
+
+  /* The render result is created from the first view at the frame it was loaded for, see
+   * load_image_single. */
+  ImageUser iuser{};
+  iuser.framenr = ima->rr->framenr;
+  char filepath[FILE_MAX];
+  BKE_image_user_file_path(&iuser, ima, filepath);
+
+  const bool predivide = (ima->alpha_mode == IMA_ALPHA_PREMUL);
+  RE_MultilayerLoadPasses(ima->rr, rpass, filepath, ima->colorspace_settings.name, predivide);
+}
+
+void BKE_image_multilayer_pass_ensure_loaded(Image *ima, RenderPass *rpass)
+{
+  BLI_mutex_lock(static_cast<ThreadMutex *>(ima->runtime.cache_mutex));
+  if (ima->rr) {
+    image_multilayer_passes_ensure_loaded(ima, rpass);
+  }
+  BLI_mutex_unlock(static_cast<ThreadMutex *>(ima->runtime.cache_mutex));
+}
+
+void BKE_image_multilayer_ensure_loaded(Image *ima)
+{
+  BLI_mutex_lock(static_cast<ThreadMutex *>(ima->runtime.cache_mutex));
+  if (ima->type == IMA_TYPE_MULTILAYER && ima->rr) {
+    image_multilayer_passes_ensure_loaded(ima, nullptr);
+  }
+  BLI_mutex_unlock(static_cast<ThreadMutex *>(ima->runtime.cache_mutex));
+}
+
 RenderResult *BKE_image_acquire_renderresult(Scene *scene, Image *ima)
 {
   BLI_mutex_lock(static_cast<ThreadMutex *>(ima->runtime.cache_mutex));
@@ -4153,6 +4207,9 @@ static ImBuf *image_load_sequence_multilayer(Image *ima, ImageUser *iuser, int e
   }
   if (ima->rr) {
     RenderPass *rpass = BKE_image_multilayer_index(ima->rr, iuser);
+    if (rpass) {
+      image_multilayer_passes_ensure_loaded(ima, rpass);
+    }
 
     if (rpass && rpass->ibuf) {
       ibuf = rpass->ibuf;
@@ -4322,8 +4379,10 @@ static ImBuf *load_image_single(Image *ima,
 
     BKE_image_user_file_path(&iuser_t, ima, filepath);
 
-    /* read ibuf */
-    ibuf = IMB_loadiffname(filepath, flag, ima->colorspace_settings.name);
+    /* Read ibuf. Multilayer files are loaded lazily from the file if they are not tiled, see
+     * image_multilayer_passes_ensure_loaded. */
+    ibuf = IMB_loadiffname(
+        filepath, is_tiled ? flag : flag | IB_multilayer_lazy, ima->colorspace_settings.name);
   }
 
   if (ibuf) {
@@ -4451,6 +4510,9 @@ static ImBuf *image_get_ibuf_multilayer(Image *ima, ImageUser *iuser)
   }
   if (ima->rr) {
     RenderPass *rpass = BKE_image_multilayer_index(ima->rr, iuser);
+    if (rpass) {
+      image_multilayer_passes_ensure_loaded(ima, rpass);
+    }
 
     if (rpass && rpass->ibuf) {
       ibuf = rpass->ibuf;
@@ -5006,7 +5068,7 @@ ImBuf *BKE_image_preview(Image *ima, const short max_size, short *r_width, short
   BKE_image_release_ibuf(ima, image_ibuf, lock);
 
   /* Resize. */
-  IMB_scale(preview, scale * image_ibuf->x, scale * image_ibuf->y, IMBScaleFilter::Box, false);
+  IMB_scale(preview, scale * image_ibuf->x, scale * image_ibuf->y, IMBScaleFilter::Box);
   IMB_rect_from_float(preview);
 
   return preview;
@@ -374,6 +374,7 @@ static bool image_save_single(ReportList *reports,
   }
 
   /* we need renderresult for exr and rendered multiview */
+  BKE_image_multilayer_ensure_loaded(ima);
   rr = BKE_image_acquire_renderresult(opts->scene, ima);
   const bool is_mono = rr ? BLI_listbase_count_at_most(&rr->views, 2) < 2 :
                             BLI_listbase_count_at_most(&ima->views, 2) < 2;
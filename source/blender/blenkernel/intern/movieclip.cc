@@ -1050,7 +1050,7 @@ static ImBuf *get_undistorted_ibuf(MovieClip *clip, MovieDistortion *distortion,
     undistibuf = BKE_tracking_undistort_frame(&clip->tracking, ibuf, ibuf->x, ibuf->y, 0.0f);
   }
 
-  IMB_scale(undistibuf, ibuf->x, ibuf->y, IMBScaleFilter::Box, false);
+  IMB_scale(undistibuf, ibuf->x, ibuf->y, IMBScaleFilter::Box);
 
   return undistibuf;
 }
@@ -1759,8 +1759,7 @@ static void movieclip_build_proxy_ibuf(const MovieClip *clip,
                                        const ImBuf *ibuf,
                                        int cfra,
                                        int proxy_render_size,
-                                       bool undistorted,
-                                       bool threaded)
+                                       bool undistorted)
 {
   char filepath[FILE_MAX];
   int quality, rectx, recty;
@@ -1771,7 +1770,7 @@ static void movieclip_build_proxy_ibuf(const MovieClip *clip,
   rectx = ibuf->x * size / 100.0f;
   recty = ibuf->y * size / 100.0f;
 
-  ImBuf *scaleibuf = IMB_scale_into_new(ibuf, rectx, recty, IMBScaleFilter::Bilinear, threaded);
+  ImBuf *scaleibuf = IMB_scale_into_new(ibuf, rectx, recty, IMBScaleFilter::Bilinear);
 
   quality = clip->proxy.quality;
   scaleibuf->ftype = IMB_FTYPE_JPG;
@@ -1827,7 +1826,7 @@ void BKE_movieclip_build_proxy_frame(MovieClip *clip,
     }
 
     for (i = 0; i < build_count; i++) {
-      movieclip_build_proxy_ibuf(clip, tmpibuf, cfra, build_sizes[i], undistorted, true);
+      movieclip_build_proxy_ibuf(clip, tmpibuf, cfra, build_sizes[i], undistorted);
     }
 
     IMB_freeImBuf(ibuf);
@@ -1859,7 +1858,7 @@ void BKE_movieclip_build_proxy_frame_for_ibuf(MovieClip *clip,
     }
 
     for (i = 0; i < build_count; i++) {
-      movieclip_build_proxy_ibuf(clip, tmpibuf, cfra, build_sizes[i], undistorted, false);
+      movieclip_build_proxy_ibuf(clip, tmpibuf, cfra, build_sizes[i], undistorted);
     }
 
     if (tmpibuf != ibuf) {
@@ -743,8 +743,7 @@ static ImBuf *accessor_get_ibuf(TrackingImageAccessor *accessor,
     IMB_scale(final_ibuf,
               orig_ibuf->x / (1 << downscale),
               orig_ibuf->y / (1 << downscale),
-              IMBScaleFilter::Box,
-              false);
+              IMBScaleFilter::Box);
   }
   /* Apply possible transformation. */
   if (transform != nullptr) {
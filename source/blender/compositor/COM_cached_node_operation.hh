@@ -0,0 +1,45 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include <memory>
+
+#include "NOD_derived_node_tree.hh"
+
+#include "COM_context.hh"
+#include "COM_node_operation.hh"
+#include "COM_node_result_cache.hh"
+
+namespace blender::compositor {
+
+using namespace nodes::derived_node_tree_types;
+
+/* ------------------------------------------------------------------------------------------------
+ * Cached Node Operation
+ *
+ * A cached node operation is a node operation that is used in place of the operation of a node
+ * whose results are retrieved from the node result cache. Its results wrap the cached results, so
+ * the node is not actually evaluated. Its inputs need not be evaluated either, so only inputs whose
+ * results are computed for other nodes are mapped, and that is just so they are released. See the
+ * NodeResultCache class for more information. */
+class CachedNodeOperation : public NodeOperation {
+ private:
+  /* The cached entry that stores the results of the node. */
+  std::shared_ptr<const NodeResultCache::Entry> entry_;
+
+ public:
+  CachedNodeOperation(Context &context,
+                      DNode node,
+                      std::shared_ptr<const NodeResultCache::Entry> entry);
+
+  /* Wrap the cached results of the needed outputs. */
+  void execute() override;
+
+ protected:
+  /* The inputs are not used, so they need no processing. */
+  void add_and_evaluate_input_processors() override;
+};
+
+}  // namespace blender::compositor
@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
+#include <optional>
 
 #include "BLI_math_vector_types.hh"
 #include "BLI_string_ref.hh"
@@ -25,6 +27,8 @@
 
 namespace blender::compositor {
 
+class NodeResultCache;
+
 /* Enumerates the possible outputs that the compositor can compute. */
 enum class OutputTypes : uint8_t {
   None = 0,
@@ -47,6 +51,10 @@ ENUM_OPERATORS(OutputTypes, OutputTypes::Previews)
  * efficiently. */
 class Context {
  private:
+  /* The size in bytes of the CPU data of the results that are currently allocated, as well as its
+   * peak since the last call to reset_peak_memory_usage. See add_memory_usage. */
+  std::atomic<int64_t> memory_usage_ = 0;
+  std::atomic<int64_t> peak_memory_usage_ = 0;
   /* A texture pool that can be used to allocate textures for the compositor efficiently. */
   TexturePool &texture_pool_;
   /* A static cache manager that can be used to acquire cached resources for the compositor
@@ -88,6 +96,13 @@ class Context {
    * since the region can be zero sized. */
   virtual rcti get_compositing_region() const = 0;
 
+  /* Get the rectangular region of the output that the compositor should write to, which is a
+   * subset of the compositing region. In the base case, this is identical to the compositing
+   * region. But when the compositor is evaluated in tiles, the compositing region is the tile
+   * extended by a halo of pixels needed to compute the tile, and the output region is the tile
+   * itself, since the pixels in the halo are not computed correctly. */
+  virtual rcti get_output_region() const;
+
   /* Get the result where the result of the compositor should be written. */
   virtual Result get_output_result() = 0;
 
@@ -101,6 +116,13 @@ class Context {
   /* Get the result where the given render pass is stored. */
   virtual Result get_pass(const Scene *scene, int view_layer, const char *pass_name) = 0;
 
+  /* Get a hash that identifies the data of the given render pass, such that the results of the
+   * nodes that read the pass can be cached across evaluations. Returns std::nullopt if the data
+   * can't be identified, which is the default. See NodeResultCache. */
+  virtual std::optional<uint64_t> get_pass_hash(const Scene *scene,
+                                                int view_layer,
+                                                const char *pass_name);
+
   /* Get the name of the view currently being rendered. */
   virtual StringRef get_view_name() const = 0;
 
@@ -139,6 +161,11 @@ class Context {
    * not support profiling. */
   virtual Profiler *profiler() const;
 
+  /* Get a pointer to the node result cache of this context, which caches the results of nodes
+   * across evaluations. It might be null if the context does not support caching node results,
+   * which is the default. See NodeResultCache for more information. */
+  virtual NodeResultCache *node_result_cache();
+
   /* Gets called after the evaluation of each compositor operation. See overrides for possible
    * uses. */
   virtual void evaluate_operation_post() const;
@@ -186,6 +213,18 @@ class Context {
 
   /* Get a reference to the static cache manager of this context. */
   StaticCacheManager &cache_manager();
+
+  /* Adds the given size in bytes to the memory usage of the CPU results of the context, which is
+   * negative if the memory was freed. This is called by results when allocating and freeing their
+   * CPU data. */
+  void add_memory_usage(int64_t size);
+
+  /* Get the peak size in bytes of the CPU data of the results of the context since the last call
+   * to reset_peak_memory_usage. */
+  int64_t get_peak_memory_usage() const;
+
+  /* Resets the peak memory usage to the current memory usage. */
+  void reset_peak_memory_usage();
 };
 
 }  // namespace blender::compositor
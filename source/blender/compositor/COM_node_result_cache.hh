@@ -0,0 +1,138 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "BLI_map.hh"
+#include "BLI_timeit.hh"
+
+#include "NOD_derived_node_tree.hh"
+
+#include "COM_context.hh"
+#include "COM_node_operation.hh"
+#include "COM_result.hh"
+#include "COM_scheduler.hh"
+
+namespace blender::compositor {
+
+using namespace nodes::derived_node_tree_types;
+
+/* ------------------------------------------------------------------------------------------------
+ * Node Result Cache
+ *
+ * A cache of the results of node operations that persists across evaluations of the compositor,
+ * such that when the user edits the node tree, only the nodes that changed and the nodes that
+ * depend on them are evaluated again, while the results of the rest of the nodes are retrieved
+ * from the cache. The results of a node are identified by a key that hashes the type and the
+ * parameters of the node, the keys of the nodes it depends on, the values of its unlinked inputs,
+ * and the state of the context that the results depend on, like the compositing region. So the key
+ * of a node changes whenever the node or any of the nodes it depends on changes, and cached
+ * results never need to be invalidated explicitly, they are just no longer used and are eventually
+ * evicted. Nodes that read data outside of the node tree can only be identified if they define the
+ * get_compositor_external_data_hash callback, otherwise, they and the nodes that depend on them
+ * are never cached.
+ *
+ * Only the results of standard node operations are cached, since pixel operations are fused and
+ * are cheap to compute, and on the CPU, only those that took a considerable amount of time to
+ * compute. The cache is limited to a
+ * certain memory size, beyond which the least recently used results are evicted.
+ *
+ * The cache is only updated when the node tree is compiled, so it should only be used by contexts
+ * that compile the node tree for every evaluation. */
+class NodeResultCache {
+ public:
+  /* The cached results of a node mapped by the identifiers of the outputs they belong to. The
+   * entries are shared with the operations that use them, such that they outlive their eviction
+   * from the cache. */
+  class Entry {
+   public:
+    Map<std::string, Result> results;
+    /* The total size in bytes of the data of the results. */
+    int64_t size = 0;
+    /* The index of the last evaluation that added or used the entry. */
+    int64_t last_use = 0;
+
+    ~Entry();
+  };
+
+ private:
+  /* The cached entries mapped by the keys of the nodes they belong to. */
+  Map<uint64_t, std::shared_ptr<Entry>> entries_;
+  /* The maximum size in bytes of the cached results, beyond which the least recently used ones are
+   * evicted. */
+  int64_t limit_ = 0;
+  /* The index of the current evaluation, used to track the last use of entries. */
+  int64_t evaluation_index_ = 0;
+  /* The keys of the nodes of the schedule of the current evaluation. Nodes that can't be identified
+   * have no key. */
+  Map<DNode, uint64_t> keys_;
+  /* The entries of the nodes of the current evaluation whose results are retrieved from the cache
+   * instead of being computed. */
+  Map<DNode, std::shared_ptr<const Entry>> hits_;
+  /* The number of entries added to the cache in the current evaluation. */
+  int additions_count_ = 0;
+
+ public:
+  /* The minimum time that a node should take to evaluate on the CPU for its results to be cached.
+   * Copying the results is not free, so cheap nodes are better computed again. The results of GPU
+   * evaluations are always cached, since the evaluation time only measures the submission of the
+   * GPU work. */
+  static constexpr timeit::Nanoseconds minimum_evaluation_time = std::chrono::milliseconds(10);
+
+  /* Set the maximum size in bytes of the cached results, evicting the least recently used results
+   * if the cache exceeds it. A zero limit frees all results. */
+  void set_limit(int64_t limit);
+
+  /* Prepare the cache for an evaluation of the given schedule. This computes the keys of the nodes
+   * in the schedule and finds the nodes whose results can be retrieved from the cache. Then
+   * returns the schedule without the nodes that are only needed to compute those results and thus
+   * need not be evaluated. */
+  Schedule begin_evaluation(Context &context, const Schedule &schedule);
+
+  /* Get the cached entry of the given node if its results should be retrieved from the cache
+   * instead of being computed, otherwise, return nullptr. */
+  std::shared_ptr<const Entry> lookup(DNode node) const;
+
+  /* Add copies of the computed results of the given operation of the given node to the cache,
+   * given the time it took to evaluate it, if the node can be identified and its results are worth
+   * caching. See minimum_evaluation_time. */
+  void add(Context &context,
+           DNode node,
+           NodeOperation &operation,
+           timeit::Nanoseconds evaluation_time);
+
+  /* Free all cached results. */
+  void clear();
+
+  /* Get the number of cached entries. */
+  int64_t entries_count() const;
+
+  /* Get the total size in bytes of the cached results. */
+  int64_t size() const;
+
+  /* Get the number of nodes whose results were retrieved from the cache in the last evaluation. */
+  int64_t hits_count() const;
+
+  /* Get the number of nodes whose results were added to the cache in the last evaluation. */
+  int64_t additions_count() const;
+
+ private:
+  /* Compute the key of the given node, assuming the keys of the nodes it depends on were already
+   * computed. Returns std::nullopt if the node can't be identified. */
+  std::optional<uint64_t> compute_node_key(Context &context, DNode node, uint64_t context_hash);
+
+  /* Returns true if the results of the given node can be cached, that is, if it is a standard node
+   * operation that can be identified and is not an output node. */
+  bool is_cacheable(DNode node) const;
+
+  /* Evict the least recently used entries until the cache size is within its limit. */
+  void evict();
+};
+
+}  // namespace blender::compositor
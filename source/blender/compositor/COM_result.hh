@@ -242,6 +242,13 @@ class Result {
    * value can't be computed and are considered invalid. */
   void allocate_invalid();
 
+  /* Allocate data for the result that is identical to the data of the given source result and
+   * copy the data, domain, single value, and meta data of the source into it. The data is never
+   * allocated from the texture pool, since the copy is typically persistent and spans multiple
+   * evaluations. It is assumed that both results are of the same type and precision, that this
+   * result is not allocated, and that the source result is allocated. */
+  void allocate_copy(const Result &source);
+
   /* Bind the GPU texture of the result to the texture image unit with the given name in the
    * currently bound given shader. This also inserts a memory barrier for texture fetches to ensure
    * any prior writes to the texture are reflected before reading from it. */
@@ -374,6 +381,9 @@ class Result {
   /* Computes the number of channels of the result based on its type. */
   int64_t channels_count() const;
 
+  /* Computes the size in bytes of the data of the result, which is zero if it is not allocated. */
+  int64_t size_in_bytes() const;
+
   /* Returns a reference to the allocate float data. */
   float *float_texture() const;
 
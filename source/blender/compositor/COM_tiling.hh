@@ -0,0 +1,23 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include <optional>
+
+#include "COM_context.hh"
+
+namespace blender::compositor {
+
+/* Computes the halo of pixels that the compositor node tree of the given context needs around a
+ * tile of the output to compute it, such that the node tree can be evaluated on a compositing
+ * region that covers the tile extended by the halo, while producing identical results to
+ * evaluating the whole image for the pixels of the tile. The halo of a node is the halo it
+ * declares through its get_compositor_tile_halo callback, where pixel nodes have a zero halo,
+ * added to the largest halo of the nodes it depends on. Returns std::nullopt if any of the nodes
+ * that will be evaluated needs the whole image, in which case, the node tree can't be evaluated in
+ * tiles. */
+std::optional<int> compute_tile_halo(const Context &context);
+
+}  // namespace blender::compositor
@@ -0,0 +1,45 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include "COM_context.hh"
+#include "COM_result.hh"
+
+namespace blender::compositor {
+
+/* The search radius starting from which the CPU variable size bokeh blur and defocus nodes use
+ * the layered bokeh blur instead of directly accumulating the pixels in the bokeh window, whose
+ * cost grows quadratically with the radius. */
+constexpr int layered_bokeh_blur_minimum_radius = 24;
+
+/* The debug value that disables the layered bokeh blur, to compare its result against the direct
+ * accumulation of the pixels. */
+constexpr int layered_bokeh_blur_disable_debug_value = 7080;
+
+/* Returns true if the CPU variable size bokeh blur and defocus nodes should use the layered bokeh
+ * blur for the given search radius. Always false when Blender is built without FFTW. */
+bool use_layered_bokeh_blur(const int search_radius);
+
+/* Blur the input using a variable size bokeh blur, where the radius of the blur at each pixel is
+ * given by the radius float image and the shape of the bokeh is given by the weights image. The
+ * result is identical in principle to directly accumulating the pixels in the bokeh window of the
+ * center pixel, but only for candidate pixels whose radius as well as the radius of the center
+ * pixel are larger than their distance, where the bokeh is scaled to the smaller of the two radii.
+ * The weights of the center pixels are always one. The radii are clamped to the given maximum
+ * radius. The output is written to the given output result, which will be allocated internally
+ * and is thus expected not to be previously allocated.
+ *
+ * Instead of accumulating the pixels directly, the radii are quantized into layers, each layer is
+ * convolved with its bokeh through FFT, and the layers are blended based on the radius of the
+ * center pixel. So the cost is almost independent of the radius. This is only supported on the
+ * CPU and when Blender is built with FFTW. */
+void layered_bokeh_blur(Context &context,
+                        const Result &input,
+                        const Result &radius,
+                        const Result &weights,
+                        Result &output,
+                        const int maximum_radius);
+
+}  // namespace blender::compositor
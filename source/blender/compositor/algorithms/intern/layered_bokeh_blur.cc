@@ -0,0 +1,466 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+
+#if defined(WITH_FFTW3)
+#  include <fftw3.h>
+#endif
+
+#include "BLI_array.hh"
+#include "BLI_assert.h"
+#include "BLI_fftw.hh"
+#include "BLI_index_range.hh"
+#include "BLI_math_base.h"
+#include "BLI_math_base.hh"
+#include "BLI_math_vector.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
+#include "BLI_task.hh"
+#include "BLI_utildefines.h"
+#include "BLI_vector.hh"
+
+#include "BKE_global.hh"
+
+#include "COM_context.hh"
+#include "COM_result.hh"
+#include "COM_utilities.hh"
+
+#include "COM_algorithm_layered_bokeh_blur.hh"
+
+namespace blender::compositor {
+
+#if defined(WITH_FFTW3)
+
+/* Computes the radii of the layers the radii of the pixels are quantized into. Small radii get a
+ * layer for every whole pixel, since the bokeh window only grows by whole pixels and small bokehs
+ * are the most sensitive to quantization, then the spacing doubles every octave such that there
+ * are four layers per octave. */
+static Vector<float> compute_layer_radii(const int maximum_radius)
+{
+  Vector<float> radii;
+  int radius = 0;
+  while (radius < maximum_radius) {
+    radii.append(float(radius));
+
+    int spacing = 1;
+    while (spacing * 8 <= radius) {
+      spacing *= 2;
+    }
+    radius += spacing;
+  }
+  radii.append(float(maximum_radius));
+
+  return radii;
+}
+
+/* The layer whose radius is the largest radius less than or equal a pixel radius, as well as the
+ * factor by which the pixel belongs to the next layer. */
+struct LayerSample {
+  int index;
+  float factor;
+
+  /* Returns the weight by which the pixel belongs to the layer of the given index. */
+  float weight(const int layer) const
+  {
+    if (layer == this->index) {
+      return 1.0f - this->factor;
+    }
+    if (layer == this->index + 1) {
+      return this->factor;
+    }
+    return 0.0f;
+  }
+};
+
+static LayerSample sample_layers(const Span<float> layer_radii, const float radius)
+{
+  /* Written such that NaN radii are zero. */
+  const float clamped_radius = radius > 0.0f ? math::min(radius, layer_radii.last()) : 0.0f;
+  const int index = int(std::upper_bound(layer_radii.begin(), layer_radii.end(), clamped_radius) -
+                        layer_radii.begin()) -
+                    1;
+  if (index == layer_radii.size() - 1) {
+    return {index, 0.0f};
+  }
+
+  /* Layers that are a single pixel apart are not interpolated, since the bokeh window of radii
+   * between them has the same size as the smaller layer. */
+  const float spacing = layer_radii[index + 1] - layer_radii[index];
+  if (spacing <= 1.0f) {
+    return {index, 0.0f};
+  }
+
+  return {index, (clamped_radius - layer_radii[index]) / spacing};
+}
+
+/* The state of the convolutions needed to accumulate channels of either the weighted colors or
+ * the weights, layer by layer. The bokeh kernel of a layer is transformed once and shared by all
+ * channels that use it. All buffers are allocated using FFTW allocators to guarantee the alignment
+ * expected by the plans, which are executed on all buffers. */
+class LayeredConvolution {
+ private:
+  /* The state of the convolution of a single channel. */
+  struct Channel {
+    /* The transform of the signal of the layers that were not processed yet. */
+    std::complex<float> *remaining_frequencies;
+    /* The sum of the convolutions of the signals of the layers processed so far with their own
+     * bokeh, in the frequency domain. */
+    std::complex<float> *previous_convolutions;
+  };
+
+  int2 spatial_size_;
+  int2 frequency_size_;
+  int64_t spatial_pixels_count_;
+  int64_t frequency_pixels_count_;
+
+  float *spatial_;
+  std::complex<float> *layer_frequencies_;
+  std::complex<float> *kernel_frequencies_;
+  Vector<Channel> channels_;
+
+  fftwf_plan forward_plan_;
+  fftwf_plan backward_plan_;
+
+ public:
+  LayeredConvolution(const int2 spatial_size) : spatial_size_(spatial_size)
+  {
+    /* The FFTW real to complex transforms utilizes the hermitian symmetry of real transforms and
+     * stores only half the output since the other half is redundant, so we only allocate half of
+     * the first dimension. See Section 4.3.4 Real-data DFT Array Format in the FFTW manual for
+     * more information. */
+    frequency_size_ = int2(spatial_size.x / 2 + 1, spatial_size.y);
+    spatial_pixels_count_ = int64_t(spatial_size.x) * spatial_size.y;
+    frequency_pixels_count_ = int64_t(frequency_size_.x) * frequency_size_.y;
+
+    spatial_ = fftwf_alloc_real(spatial_pixels_count_);
+    layer_frequencies_ = this->allocate_frequencies();
+    kernel_frequencies_ = this->allocate_frequencies();
+
+    forward_plan_ = fftwf_plan_dft_r2c_2d(spatial_size.y,
+                                          spatial_size.x,
+                                          spatial_,
+                                          reinterpret_cast<fftwf_complex *>(layer_frequencies_),
+                                          FFTW_ESTIMATE);
+    backward_plan_ = fftwf_plan_dft_c2r_2d(spatial_size.y,
+                                           spatial_size.x,
+                                           reinterpret_cast<fftwf_complex *>(layer_frequencies_),
+                                           spatial_,
+                                           FFTW_ESTIMATE);
+  }
+
+  ~LayeredConvolution()
+  {
+    fftwf_destroy_plan(forward_plan_);
+    fftwf_destroy_plan(backward_plan_);
+    fftwf_free(spatial_);
+    fftwf_free(layer_frequencies_);
+    fftwf_free(kernel_frequencies_);
+    for (Channel &channel : channels_) {
+      fftwf_free(channel.remaining_frequencies);
+      fftwf_free(channel.previous_convolutions);
+    }
+  }
+
+  /* The spatial buffer, which should be filled before calling the add and set methods and is
+   * filled with the convolution of the current layer after calling the convolve method. */
+  MutableSpan<float> spatial()
+  {
+    return MutableSpan<float>(spatial_, spatial_pixels_count_);
+  }
+
+  /* Adds a channel whose signal of all layers is the spatial buffer, and returns its index. */
+  int add_channel()
+  {
+    Channel channel;
+    channel.remaining_frequencies = this->allocate_frequencies();
+    channel.previous_convolutions = this->allocate_frequencies();
+    this->forward(channel.remaining_frequencies);
+    this->fill_zero(channel.previous_convolutions);
+    return int(channels_.append_and_get_index(channel));
+  }
+
+  /* Sets the spatial buffer as the bokeh kernel of the current layer. */
+  void set_layer_kernel()
+  {
+    this->forward(kernel_frequencies_);
+  }
+
+  /* Takes the spatial buffer as the signal of the current layer of the channel with the given
+   * index, then computes the convolution for center pixels in the current layer and writes it to
+   * the spatial buffer, and adds the current layer to the previous layers of the channel. Signals
+   * in the previous layers are convolved with their own smaller bokeh, while signals in the
+   * current and later layers are convolved with the bokeh of the current layer, since the bokeh is
+   * scaled to the smaller of the center and candidate radii. */
+  void convolve(const int channel_index)
+  {
+    this->forward(layer_frequencies_);
+    Channel &channel = channels_[channel_index];
+
+    /* The FFT is not normalized, meaning the result of the FFT followed by an inverse FFT will
+     * result in an image that is scaled by a factor of the product of the width and height, so we
+     * take that into account by dividing by that scale. See Section 4.8.6 Multi-dimensional
+     * Transforms of the FFTW manual for more information. */
+    const float normalization_scale = float(spatial_size_.x) * spatial_size_.y;
+    threading::parallel_for(
+        IndexRange(frequency_pixels_count_), 4096, [&](const IndexRange sub_range) {
+          for (const int64_t i : sub_range) {
+            const std::complex<float> kernel = kernel_frequencies_[i];
+            const std::complex<float> layer = layer_frequencies_[i];
+            const std::complex<float> convolution = channel.previous_convolutions[i] +
+                                                    kernel * channel.remaining_frequencies[i];
+
+            channel.previous_convolutions[i] += kernel * layer;
+            channel.remaining_frequencies[i] -= layer;
+
+            /* The layer frequencies are no longer needed, so reuse them for the backward
+             * transform, which destroys its input. */
+            layer_frequencies_[i] = convolution / normalization_scale;
+          }
+        });
+
+    fftwf_execute_dft_c2r(
+        backward_plan_, reinterpret_cast<fftwf_complex *>(layer_frequencies_), spatial_);
+  }
+
+ private:
+  std::complex<float> *allocate_frequencies()
+  {
+    return reinterpret_cast<std::complex<float> *>(fftwf_alloc_complex(frequency_pixels_count_));
+  }
+
+  void forward(std::complex<float> *frequencies)
+  {
+    fftwf_execute_dft_r2c(
+        forward_plan_, spatial_, reinterpret_cast<fftwf_complex *>(frequencies));
+  }
+
+  void fill_zero(std::complex<float> *frequencies)
+  {
+    threading::parallel_for(
+        IndexRange(frequency_pixels_count_), 4096, [&](const IndexRange sub_range) {
+          for (const int64_t i : sub_range) {
+            frequencies[i] = std::complex<float>(0.0f);
+          }
+        });
+  }
+};
+
+/* Returns true if all channels of the weights are identical, in which case, the accumulated
+ * weights are identical for all channels and need only be computed once. */
+static bool is_achromatic(const Result &weights)
+{
+  if (weights.is_single_value()) {
+    const float4 value = weights.get_single_value<float4>();
+    return value.x == value.y && value.x == value.z && value.x == value.w;
+  }
+
+  const int2 size = weights.domain().size;
+  for (const int y : IndexRange(size.y)) {
+    for (const int x : IndexRange(size.x)) {
+      const float4 value = weights.load_pixel<float4>(int2(x, y));
+      if (value.x != value.y || value.x != value.z || value.x != value.w) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static void layered_bokeh_blur_cpu(const Result &input,
+                                   const Result &radius,
+                                   const Result &weights,
+                                   Result &output,
+                                   const int maximum_radius)
+{
+  const int2 image_size = input.domain().size;
+  const int64_t image_pixels_count = int64_t(image_size.x) * image_size.y;
+
+  /* Pad the image by the maximum radius on all sides using an extended boundary condition, which
+   * also guarantees that the circular convolution doesn't wrap around for pixels inside the
+   * image. */
+  const int padding = maximum_radius;
+  const int2 spatial_size = fftw::optimal_size_for_real_transform(image_size + padding * 2);
+  const int64_t spatial_pixels_count = int64_t(spatial_size.x) * spatial_size.y;
+
+  auto image_texel = [&](const int64_t spatial_index) {
+    return int2(int(spatial_index % spatial_size.x), int(spatial_index / spatial_size.x)) -
+           padding;
+  };
+  auto spatial_index = [&](const int2 &image_texel) {
+    return int64_t(image_texel.y + padding) * spatial_size.x + image_texel.x + padding;
+  };
+
+  const Vector<float> layer_radii = compute_layer_radii(maximum_radius);
+
+  /* Compute the layers of all pixels in the padded domain once, since they are needed for every
+   * layer of every channel. Also identify the layers that no pixel belongs to, which can be
+   * skipped entirely. */
+  Array<LayerSample> layer_samples(spatial_pixels_count);
+  threading::parallel_for(IndexRange(spatial_pixels_count), 4096, [&](const IndexRange sub_range) {
+    for (const int64_t i : sub_range) {
+      layer_samples[i] = sample_layers(
+          layer_radii, radius.load_pixel_extended<float, true>(image_texel(i)));
+    }
+  });
+
+  Array<bool> is_layer_used(layer_radii.size(), false);
+  for (const LayerSample &sample : layer_samples) {
+    is_layer_used[sample.index] = true;
+    if (sample.factor != 0.0f) {
+      is_layer_used[sample.index + 1] = true;
+    }
+  }
+
+  Array<float4> accumulated_color(image_pixels_count, float4(0.0f));
+  Array<float4> accumulated_weight(image_pixels_count, float4(0.0f));
+
+  LayeredConvolution convolution(spatial_size);
+  MutableSpan<float> spatial = convolution.spatial();
+
+  /* A channel of either the colors weighted by the bokeh or of the bokeh weights themselves. The
+   * signal is then either the input or one. */
+  struct Accumulation {
+    int channel;
+    bool is_weight;
+    int convolution_channel;
+  };
+
+  auto load_signal = [&](const Accumulation &accumulation, const int64_t i) {
+    return accumulation.is_weight ?
+               1.0f :
+               input.load_pixel_extended<float4>(image_texel(i))[accumulation.channel];
+  };
+
+  /* If the weights are achromatic, the bokeh of all channels is the same and the accumulated
+   * weights are only computed once. */
+  const bool use_shared_weights = is_achromatic(weights);
+  Vector<Accumulation> accumulations;
+  for (const int channel : IndexRange(4)) {
+    accumulations.append({channel, false, 0});
+    if (!use_shared_weights || channel == 0) {
+      accumulations.append({channel, true, 0});
+    }
+  }
+
+  for (Accumulation &accumulation : accumulations) {
+    threading::parallel_for(spatial.index_range(), 4096, [&](const IndexRange sub_range) {
+      for (const int64_t i : sub_range) {
+        spatial[i] = load_signal(accumulation, i);
+      }
+    });
+    accumulation.convolution_channel = convolution.add_channel();
+  }
+
+  const IndexRange kernel_channels = IndexRange(use_shared_weights ? 1 : 4);
+  for (const int layer : layer_radii.index_range()) {
+    if (!is_layer_used[layer]) {
+      continue;
+    }
+
+    /* Transform the bokeh of the layer once for all the channels that use it. */
+    for (const int kernel_channel : kernel_channels) {
+      /* Compute the bokeh of the layer centered at the zero point with wrap around, which is the
+       * expected format for doing circular convolutions in the frequency domain. Notice that the
+       * bokeh is not inverted unlike when directly accumulating the pixels in the window, since
+       * convolution inherently inverts the kernel. */
+      const float layer_radius = layer_radii[layer];
+      const int window_radius = int(layer_radius);
+      const int window_size = window_radius * 2 + 1;
+      spatial.fill(0.0f);
+      threading::parallel_for(IndexRange(window_size), 16, [&](const IndexRange sub_y_range) {
+        for (const int64_t y : sub_y_range) {
+          for (const int64_t x : IndexRange(window_size)) {
+            const int2 texel = int2(int(x), int(y)) - window_radius;
+            float weight = 1.0f;
+            if (texel != int2(0)) {
+              weight = weights.sample_bilinear_extended(
+                  (float2(texel) + float2(layer_radius + 0.5f)) /
+                  (layer_radius * 2.0f + 1.0f))[kernel_channel];
+            }
+            const int64_t wrapped_x = mod_i(texel.x, spatial_size.x);
+            const int64_t wrapped_y = mod_i(texel.y, spatial_size.y);
+            spatial[wrapped_y * spatial_size.x + wrapped_x] = weight;
+          }
+        }
+      });
+      convolution.set_layer_kernel();
+
+      for (const Accumulation &accumulation : accumulations) {
+        if (!use_shared_weights && accumulation.channel != kernel_channel) {
+          continue;
+        }
+
+        threading::parallel_for(spatial.index_range(), 4096, [&](const IndexRange sub_range) {
+          for (const int64_t i : sub_range) {
+            const float layer_weight = layer_samples[i].weight(layer);
+            spatial[i] = layer_weight == 0.0f ? 0.0f : layer_weight * load_signal(accumulation, i);
+          }
+        });
+        convolution.convolve(accumulation.convolution_channel);
+
+        /* Accumulate the convolution for center pixels in the layer, blending it with the
+         * adjacent layer for pixels between layers. */
+        MutableSpan<float4> accumulated = accumulation.is_weight ?
+                                              accumulated_weight.as_mutable_span() :
+                                              accumulated_color.as_mutable_span();
+        parallel_for(image_size, [&](const int2 texel) {
+          const int64_t index = spatial_index(texel);
+          const float layer_weight = layer_samples[index].weight(layer);
+          if (layer_weight != 0.0f) {
+            accumulated[int64_t(texel.y) * image_size.x + texel.x][accumulation.channel] +=
+                layer_weight * spatial[index];
+          }
+        });
+      }
+    }
+  }
+
+  output.allocate_texture(input.domain());
+  parallel_for(image_size, [&](const int2 texel) {
+    const int64_t index = int64_t(texel.y) * image_size.x + texel.x;
+    const float4 weight = use_shared_weights ? float4(accumulated_weight[index].x) :
+                                               accumulated_weight[index];
+    output.store_pixel(texel, math::safe_divide(accumulated_color[index], weight));
+  });
+}
+
+#endif
+
+bool use_layered_bokeh_blur(const int search_radius)
+{
+#if defined(WITH_FFTW3)
+  return search_radius >= layered_bokeh_blur_minimum_radius &&
+         G.debug_value != layered_bokeh_blur_disable_debug_value;
+#else
+  UNUSED_VARS(search_radius);
+  return false;
+#endif
+}
+
+void layered_bokeh_blur(Context &context,
+                        const Result &input,
+                        const Result &radius,
+                        const Result &weights,
+                        Result &output,
+                        const int maximum_radius)
+{
+  BLI_assert(!context.use_gpu());
+  UNUSED_VARS_NDEBUG(context);
+
+#if defined(WITH_FFTW3)
+  layered_bokeh_blur_cpu(input, radius, weights, output, maximum_radius);
+#else
+  UNUSED_VARS(radius, weights, maximum_radius);
+  BLI_assert_unreachable();
+  output.allocate_texture(input.domain());
+  parallel_for(input.domain().size, [&](const int2 texel) {
+    output.store_pixel(texel, input.load_pixel<float4>(texel));
+  });
+#endif
+}
+
+}  // namespace blender::compositor
@@ -0,0 +1,51 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <memory>
+#include <utility>
+
+#include "NOD_derived_node_tree.hh"
+
+#include "COM_cached_node_operation.hh"
+#include "COM_context.hh"
+#include "COM_node_operation.hh"
+#include "COM_node_result_cache.hh"
+#include "COM_result.hh"
+
+namespace blender::compositor {
+
+using namespace nodes::derived_node_tree_types;
+
+CachedNodeOperation::CachedNodeOperation(Context &context,
+                                         DNode node,
+                                         std::shared_ptr<const NodeResultCache::Entry> entry)
+    : NodeOperation(context, node), entry_(std::move(entry))
+{
+}
+
+void CachedNodeOperation::execute()
+{
+  for (const bNodeSocket *output : this->node()->output_sockets()) {
+    Result &result = this->get_result(output->identifier);
+    if (!result.should_compute()) {
+      continue;
+    }
+
+    /* The output might only be used by other nodes whose results are retrieved from the cache, in
+     * which case it might not be cached but it is not actually read either. */
+    const Result *cached_result = entry_->results.lookup_ptr_as(output->identifier);
+    if (!cached_result) {
+      result.allocate_invalid();
+      continue;
+    }
+
+    result.set_type(cached_result->type());
+    result.set_precision(cached_result->precision());
+    result.wrap_external(*cached_result);
+  }
+}
+
+void CachedNodeOperation::add_and_evaluate_input_processors() {}
+
+}  // namespace blender::compositor
@@ -2,6 +2,8 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <optional>
+
 #include "BLI_math_vector.hh"
 #include "BLI_rect.h"
 
@@ -22,6 +24,13 @@ namespace blender::compositor {
 
 Context::Context(TexturePool &texture_pool) : texture_pool_(texture_pool) {}
 
+std::optional<uint64_t> Context::get_pass_hash(const Scene * /*scene*/,
+                                               int /*view_layer*/,
+                                               const char * /*pass_name*/)
+{
+  return std::nullopt;
+}
+
 bool Context::treat_viewer_as_composite_output() const
 {
   return false;
@@ -44,6 +53,11 @@ Profiler *Context::profiler() const
   return nullptr;
 }
 
+NodeResultCache *Context::node_result_cache()
+{
+  return nullptr;
+}
+
 void Context::evaluate_operation_post() const {}
 
 bool Context::is_canceled() const
@@ -60,6 +74,11 @@ void Context::reset()
   cache_manager_.reset();
 }
 
+rcti Context::get_output_region() const
+{
+  return this->get_compositing_region();
+}
+
 int2 Context::get_compositing_region_size() const
 {
   const rcti compositing_region = get_compositing_region();
@@ -124,4 +143,24 @@ StaticCacheManager &Context::cache_manager()
   return cache_manager_;
 }
 
+void Context::add_memory_usage(const int64_t size)
+{
+  const int64_t memory_usage = memory_usage_.fetch_add(size) + size;
+  int64_t peak_memory_usage = peak_memory_usage_.load();
+  while (memory_usage > peak_memory_usage &&
+         !peak_memory_usage_.compare_exchange_weak(peak_memory_usage, memory_usage))
+  {
+  }
+}
+
+int64_t Context::get_peak_memory_usage() const
+{
+  return peak_memory_usage_.load();
+}
+
+void Context::reset_peak_memory_usage()
+{
+  peak_memory_usage_.store(memory_usage_.load());
+}
+
 }  // namespace blender::compositor
@@ -2,18 +2,23 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <memory>
+
 #include "BLI_string.h"
+#include "BLI_timeit.hh"
 
 #include "DNA_node_types.h"
 
 #include "NOD_derived_node_tree.hh"
 
+#include "COM_cached_node_operation.hh"
 #include "COM_compile_state.hh"
 #include "COM_context.hh"
 #include "COM_evaluator.hh"
 #include "COM_input_single_value_operation.hh"
 #include "COM_multi_function_procedure_operation.hh"
 #include "COM_node_operation.hh"
+#include "COM_node_result_cache.hh"
 #include "COM_operation.hh"
 #include "COM_result.hh"
 #include "COM_scheduler.hh"
@@ -102,7 +107,14 @@ void Evaluator::compile_and_evaluate()
     return;
   }
 
-  const Schedule schedule = compute_schedule(context_, *derived_node_tree_);
+  Schedule schedule = compute_schedule(context_, *derived_node_tree_);
+
+  /* Remove the nodes that need not be evaluated because the results of the nodes that depend on
+   * them are retrieved from the node result cache. */
+  NodeResultCache *node_result_cache = context_.node_result_cache();
+  if (node_result_cache) {
+    schedule = node_result_cache->begin_evaluation(context_, schedule);
+  }
 
   CompileState compile_state(schedule);
 
@@ -130,7 +142,15 @@ void Evaluator::compile_and_evaluate()
 
 void Evaluator::compile_and_evaluate_node(DNode node, CompileState &compile_state)
 {
-  NodeOperation *operation = node->typeinfo->get_compositor_operation(context_, node);
+  NodeResultCache *node_result_cache = context_.node_result_cache();
+  std::shared_ptr<const NodeResultCache::Entry> cached_entry = node_result_cache ?
+                                                                   node_result_cache->lookup(node) :
+                                                                   nullptr;
+  const bool is_cached = bool(cached_entry);
+
+  NodeOperation *operation = is_cached ?
+                                 new CachedNodeOperation(context_, node, std::move(cached_entry)) :
+                                 node->typeinfo->get_compositor_operation(context_, node);
 
   compile_state.map_node_to_node_operation(node, operation);
 
@@ -143,7 +163,11 @@ void Evaluator::compile_and_evaluate_node(DNode node, CompileState &compile_stat
 
   operation->compute_results_reference_counts(compile_state.get_schedule());
 
+  const timeit::TimePoint before_time = timeit::Clock::now();
   operation->evaluate();
+  if (node_result_cache && !is_cached) {
+    node_result_cache->add(context_, node, *operation, timeit::Clock::now() - before_time);
+  }
 }
 
 void Evaluator::map_node_operation_inputs_to_their_results(DNode node,
@@ -158,6 +182,12 @@ void Evaluator::map_node_operation_inputs_to_their_results(DNode node,
     /* The origin socket is an output, which means the input is linked. So map the input to the
      * result we get from the output. */
     if (dorigin->is_output()) {
+      /* The node of the output might not be scheduled if the node is retrieved from the node result
+       * cache, since its inputs are not needed in that case. */
+      if (!compile_state.get_schedule().contains(dorigin.node())) {
+        continue;
+      }
+
       Result &result = compile_state.get_result_from_output_socket(DOutputSocket(dorigin));
       operation->map_input_to_result(input->identifier, &result);
       continue;
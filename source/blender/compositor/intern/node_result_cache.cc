@@ -0,0 +1,461 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+
+#include <xxhash.h>
+
+#include "BLI_index_range.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_set.hh"
+#include "BLI_string_ref.hh"
+#include "BLI_timeit.hh"
+#include "BLI_vector.hh"
+
+#include "DNA_color_types.h"
+#include "DNA_genfile.h"
+#include "DNA_node_types.h"
+#include "DNA_sdna_types.h"
+#include "DNA_vec_types.h"
+
+#include "BKE_node.hh"
+
+#include "NOD_derived_node_tree.hh"
+
+#include "COM_context.hh"
+#include "COM_node_operation.hh"
+#include "COM_node_result_cache.hh"
+#include "COM_result.hh"
+#include "COM_scheduler.hh"
+#include "COM_utilities.hh"
+
+namespace blender::compositor {
+
+using namespace nodes::derived_node_tree_types;
+
+/* --------------------------------------------------------------------
+ * Hashing.
+ */
+
+static uint64_t hash_bytes(const void *data, const int64_t size, const uint64_t hash)
+{
+  return XXH3_64bits_withSeed(data, size_t(size), hash);
+}
+
+template<typename T> static uint64_t hash_value(const T &value, const uint64_t hash)
+{
+  static_assert(std::is_trivially_copyable_v<T>);
+  return hash_bytes(&value, sizeof(T), hash);
+}
+
+/* Hashes the data of the DNA struct with the given index, returning false if the struct has
+ * pointers to data that can't be hashed. The SDNA doesn't describe the data that pointers point
+ * to, so only null pointers can generally be hashed. An exception is made for the points of curve
+ * maps, which are common in node storage and whose count is known, while their lookup tables are
+ * derived from the points and are skipped. */
+static bool hash_dna_struct(const SDNA &sdna,
+                            const int struct_index,
+                            const char *data,
+                            uint64_t &hash)
+{
+  const SDNA_Struct *dna_struct = sdna.structs[struct_index];
+  const StringRef struct_name = sdna.types[dna_struct->type_index];
+
+  /* DNA structs have no implicit padding, so the members are laid out contiguously. */
+  int64_t offset = 0;
+  for (const int i : IndexRange(dna_struct->members_num)) {
+    const SDNA_StructMember &member = dna_struct->members[i];
+    const StringRef member_name = sdna.members[member.member_index];
+    const int member_size = DNA_struct_member_size(&sdna, member.type_index, member.member_index);
+    const char *member_data = data + offset;
+    offset += member_size;
+
+    const bool is_pointer = ELEM(member_name[0], '*', '(');
+    if (is_pointer) {
+      if (struct_name == "CurveMap") {
+        const CurveMap &curve_map = *reinterpret_cast<const CurveMap *>(data);
+        if (member_name == "*curve") {
+          hash = hash_bytes(curve_map.curve, sizeof(CurveMapPoint) * curve_map.totpoint, hash);
+          continue;
+        }
+        if (ELEM(member_name, "*table", "*premultable")) {
+          continue;
+        }
+      }
+
+      if (*reinterpret_cast<const void *const *>(member_data) != nullptr) {
+        return false;
+      }
+      continue;
+    }
+
+    const int member_struct_index = DNA_struct_find_index_without_alias(
+        &sdna, sdna.types[member.type_index]);
+    if (member_struct_index == -1) {
+      hash = hash_bytes(member_data, member_size, hash);
+      continue;
+    }
+
+    const int array_size = sdna.members_array_num[member.member_index];
+    const int struct_size = sdna.types_size[member.type_index];
+    for (const int j : IndexRange(array_size)) {
+      if (!hash_dna_struct(sdna, member_struct_index, member_data + j * struct_size, hash)) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+/* Hashes the default value of the given socket, identical to how it is read by the Input Single
+ * Value Operation for unlinked inputs. */
+static uint64_t hash_socket_value(const bNodeSocket *bsocket, const uint64_t hash)
+{
+  switch (get_node_socket_result_type(bsocket)) {
+    case ResultType::Float:
+      return hash_value(bsocket->default_value_typed<bNodeSocketValueFloat>()->value, hash);
+    case ResultType::Int:
+      return hash_value(bsocket->default_value_typed<bNodeSocketValueInt>()->value, hash);
+    case ResultType::Vector:
+      return hash_value(bsocket->default_value_typed<bNodeSocketValueVector>()->value, hash);
+    case ResultType::Color:
+      return hash_value(bsocket->default_value_typed<bNodeSocketValueRGBA>()->value, hash);
+    case ResultType::Float2:
+    case ResultType::Float3:
+    case ResultType::Int2:
+      /* Those types are internal and needn't be handled by operations. */
+      BLI_assert_unreachable();
+      break;
+  }
+
+  return hash;
+}
+
+/* Hashes the type and parameters of the node as well as the external data it reads, if any.
+ * Returns std::nullopt if any of those can't be hashed. */
+static std::optional<uint64_t> compute_node_parameters_hash(Context &context, DNode node)
+{
+  const bNode &bnode = *node;
+
+  uint64_t hash = hash_bytes(bnode.idname, std::strlen(bnode.idname), 0);
+  hash = hash_value(bnode.custom1, hash);
+  hash = hash_value(bnode.custom2, hash);
+  hash = hash_value(bnode.custom3, hash);
+  hash = hash_value(bnode.custom4, hash);
+
+  /* Input nodes like RGB and Value store their values in the default values of their outputs. */
+  for (const bNodeSocket *output : bnode.output_sockets()) {
+    hash = hash_socket_value(output, hash);
+  }
+
+  if (bnode.typeinfo->get_compositor_external_data_hash) {
+    const std::optional<uint64_t> external_data_hash =
+        bnode.typeinfo->get_compositor_external_data_hash(context, node);
+    if (!external_data_hash) {
+      return std::nullopt;
+    }
+    hash = hash_value(*external_data_hash, hash);
+  }
+  else if (bnode.id) {
+    /* The node reads an ID whose changes can't be tracked. */
+    return std::nullopt;
+  }
+
+  if (bnode.storage) {
+    const SDNA &sdna = *DNA_sdna_current_get();
+    const int struct_index = DNA_struct_find_index_without_alias(&sdna,
+                                                                 bnode.typeinfo->storagename.c_str());
+    if (struct_index == -1) {
+      return std::nullopt;
+    }
+
+    if (!hash_dna_struct(sdna, struct_index, static_cast<const char *>(bnode.storage), hash)) {
+      return std::nullopt;
+    }
+  }
+
+  return hash;
+}
+
+/* Hashes the state of the context that the results of nodes might depend on. */
+static uint64_t compute_context_hash(Context &context)
+{
+  uint64_t hash = hash_value(context.get_compositing_region(), 0);
+  hash = hash_value(context.get_render_size(), hash);
+  hash = hash_value(context.get_render_percentage(), hash);
+  hash = hash_value(context.get_frame_number(), hash);
+  hash = hash_value(context.get_time(), hash);
+  hash = hash_value(context.get_precision(), hash);
+  hash = hash_value(context.get_denoise_quality(), hash);
+  hash = hash_value(context.use_gpu(), hash);
+
+  const StringRef view_name = context.get_view_name();
+  hash = hash_bytes(view_name.data(), view_name.size(), hash);
+
+  return hash;
+}
+
+/* --------------------------------------------------------------------
+ * Node Result Cache.
+ */
+
+NodeResultCache::Entry::~Entry()
+{
+  for (Result &result : this->results.values()) {
+    result.free();
+  }
+}
+
+void NodeResultCache::set_limit(const int64_t limit)
+{
+  limit_ = limit;
+  this->evict();
+}
+
+Schedule NodeResultCache::begin_evaluation(Context &context, const Schedule &schedule)
+{
+  evaluation_index_++;
+  keys_.clear();
+  hits_.clear();
+  additions_count_ = 0;
+
+  if (limit_ == 0) {
+    return schedule;
+  }
+
+  /* The schedule is topologically sorted, so the keys of the nodes that a node depends on are
+   * computed before its own key. */
+  const uint64_t context_hash = compute_context_hash(context);
+  for (const DNode &node : schedule) {
+    const std::optional<uint64_t> key = this->compute_node_key(context, node, context_hash);
+    if (key) {
+      keys_.add_new(node, *key);
+    }
+  }
+
+  /* Go over the schedule in reverse order, such that all nodes that depend on a node are visited
+   * before it, and find the nodes that are needed for the evaluation, that is, nodes that no other
+   * node depends on, which are the outputs of the schedule, nodes whose previews need to be
+   * computed, and nodes that needed nodes depend on, unless those nodes are retrieved from the
+   * cache. Needed nodes are retrieved from the cache if they have a cached entry that has all of
+   * their needed outputs. */
+  const bool needs_previews = bool(context.needed_outputs() & OutputTypes::Previews);
+  Set<DNode> needed_nodes;
+  for (int i = schedule.size() - 1; i >= 0; i--) {
+    const DNode node = schedule[i];
+    const bool needs_preview = needs_previews && is_node_preview_needed(node);
+
+    bool has_dependents = false;
+    Vector<StringRef> needed_outputs;
+    for (const bNodeSocket *output : node->output_sockets()) {
+      const DOutputSocket doutput{node.context(), output};
+      has_dependents |= is_output_linked_to_node_conditioned(
+          doutput, [&](DNode target) { return schedule.contains(target); });
+
+      if (is_output_linked_to_node_conditioned(doutput, [&](DNode target) {
+            return needed_nodes.contains(target) && !hits_.contains(target);
+          }))
+      {
+        needed_outputs.append(output->identifier);
+      }
+    }
+
+    if (has_dependents && !needs_preview && needed_outputs.is_empty()) {
+      continue;
+    }
+
+    needed_nodes.add_new(node);
+
+    if (needs_preview || !this->is_cacheable(node)) {
+      continue;
+    }
+
+    const std::shared_ptr<Entry> *entry = entries_.lookup_ptr(keys_.lookup(node));
+    if (!entry) {
+      continue;
+    }
+
+    const bool has_needed_outputs = std::all_of(
+        needed_outputs.begin(), needed_outputs.end(), [&](const StringRef identifier) {
+          return (*entry)->results.contains_as(identifier);
+        });
+    if (!has_needed_outputs) {
+      continue;
+    }
+
+    (*entry)->last_use = evaluation_index_;
+    hits_.add_new(node, *entry);
+  }
+
+  Schedule needed_schedule;
+  for (const DNode &node : schedule) {
+    if (needed_nodes.contains(node)) {
+      needed_schedule.add_new(node);
+    }
+  }
+
+  return needed_schedule;
+}
+
+std::shared_ptr<const NodeResultCache::Entry> NodeResultCache::lookup(DNode node) const
+{
+  return hits_.lookup_default(node, nullptr);
+}
+
+void NodeResultCache::add(Context &context,
+                          DNode node,
+                          NodeOperation &operation,
+                          const timeit::Nanoseconds evaluation_time)
+{
+  if (limit_ == 0) {
+    return;
+  }
+
+  /* GPU operations are only submitted and not waited on, so their evaluation time doesn't reflect
+   * their cost. GPU results are copied on the device, so they are always cached. */
+  if (!context.use_gpu() && evaluation_time < minimum_evaluation_time) {
+    return;
+  }
+
+  if (!this->is_cacheable(node)) {
+    return;
+  }
+
+  int64_t size = 0;
+  for (const bNodeSocket *output : node->output_sockets()) {
+    Result &result = operation.get_result(output->identifier);
+    if (result.should_compute()) {
+      size += result.size_in_bytes();
+    }
+  }
+
+  if (size > limit_) {
+    return;
+  }
+
+  std::shared_ptr<Entry> entry = std::make_shared<Entry>();
+  entry->size = size;
+  entry->last_use = evaluation_index_;
+  for (const bNodeSocket *output : node->output_sockets()) {
+    Result &result = operation.get_result(output->identifier);
+    if (!result.should_compute() || !result.is_allocated()) {
+      continue;
+    }
+
+    Result copy = context.create_result(result.type(), result.precision());
+    copy.allocate_copy(result);
+    entry->results.add_new(output->identifier, copy);
+  }
+
+  entries_.add_overwrite(keys_.lookup(node), std::move(entry));
+  additions_count_++;
+
+  this->evict();
+}
+
+void NodeResultCache::clear()
+{
+  entries_.clear();
+}
+
+int64_t NodeResultCache::entries_count() const
+{
+  return entries_.size();
+}
+
+int64_t NodeResultCache::size() const
+{
+  int64_t size = 0;
+  for (const std::shared_ptr<Entry> &entry : entries_.values()) {
+    size += entry->size;
+  }
+  return size;
+}
+
+int64_t NodeResultCache::hits_count() const
+{
+  return hits_.size();
+}
+
+int64_t NodeResultCache::additions_count() const
+{
+  return additions_count_;
+}
+
+std::optional<uint64_t> NodeResultCache::compute_node_key(Context &context,
+                                                         DNode node,
+                                                         const uint64_t context_hash)
+{
+  const std::optional<uint64_t> parameters_hash = compute_node_parameters_hash(context, node);
+  if (!parameters_hash) {
+    return std::nullopt;
+  }
+
+  uint64_t key = hash_value(*parameters_hash, context_hash);
+  for (const bNodeSocket *input : node->input_sockets()) {
+    const DInputSocket dinput{node.context(), input};
+    const DSocket origin = get_input_origin_socket(dinput);
+
+    /* The input is unlinked, so hash its value. */
+    if (origin->is_input()) {
+      key = hash_socket_value(origin.bsocket(), key);
+      continue;
+    }
+
+    /* The input is linked, so hash the key of the node it is linked to as well as the output it is
+     * linked from. If the node can't be identified, then neither can this node. */
+    const uint64_t *origin_key = keys_.lookup_ptr(origin.node());
+    if (!origin_key) {
+      return std::nullopt;
+    }
+    key = hash_value(*origin_key, key);
+    key = hash_bytes(origin->identifier, std::strlen(origin->identifier), key);
+  }
+
+  return key;
+}
+
+bool NodeResultCache::is_cacheable(DNode node) const
+{
+  if (is_pixel_node(node)) {
+    return false;
+  }
+
+  /* Output nodes write to the outputs of the context, so they always need to be evaluated. */
+  if (node->typeinfo->nclass == NODE_CLASS_OUTPUT) {
+    return false;
+  }
+
+  return keys_.contains(node);
+}
+
+void NodeResultCache::evict()
+{
+  if (limit_ == 0) {
+    this->clear();
+    return;
+  }
+
+  int64_t size = this->size();
+  while (size > limit_) {
+    const std::shared_ptr<Entry> *least_recently_used = nullptr;
+    uint64_t least_recently_used_key = 0;
+    for (const auto item : entries_.items()) {
+      if (!least_recently_used || item.value->last_use < (*least_recently_used)->last_use) {
+        least_recently_used = &item.value;
+        least_recently_used_key = item.key;
+      }
+    }
+
+    size -= (*least_recently_used)->size;
+    entries_.remove(least_recently_used_key);
+  }
+}
+
+}  // namespace blender::compositor
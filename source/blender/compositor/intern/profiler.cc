@@ -52,8 +52,10 @@ timeit::Nanoseconds Profiler::accumulate_node_group_times(const bNodeTree &node_
     const timeit::Nanoseconds group_execution_time = this->accumulate_node_group_times(
         *child_tree, node_instance_key);
 
-    /* Set evaluation time of the group node. */
-    this->set_node_evaluation_time(node_instance_key, group_execution_time);
+    /* Set evaluation time of the group node. Overwrite any existing time, since the compositor
+     * might be evaluated multiple times before finalizing, like when evaluating it in tiles, and
+     * the times of the nodes inside the group are already accumulated over all evaluations. */
+    nodes_evaluation_times_.add_overwrite(node_instance_key, group_execution_time);
 
     /* Add group evaluation time to the overall tree execution time. */
     tree_evaluation_time += group_execution_time;
@@ -2,6 +2,8 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <cstring>
+
 #include "MEM_guardedalloc.h"
 
 #include "BLI_assert.h"
@@ -273,6 +275,27 @@ void Result::allocate_invalid()
   }
 }
 
+void Result::allocate_copy(const Result &source)
+{
+  BLI_assert(type_ == source.type());
+  BLI_assert(precision_ == source.precision());
+  BLI_assert(!this->is_allocated() && source.is_allocated());
+  BLI_assert(!master_);
+
+  is_single_value_ = source.is_single_value();
+  this->allocate_data(is_single_value_ ? int2(1) : source.domain().size, false);
+  domain_ = source.domain();
+  vector_value_ = source.vector_value_;
+  meta_data = source.meta_data;
+
+  if (storage_type_ == ResultStorageType::GPU) {
+    GPU_texture_copy(gpu_texture_, source.gpu_texture_);
+  }
+  else {
+    std::memcpy(this->data(), source.data(), this->size_in_bytes());
+  }
+}
+
 void Result::bind_as_texture(GPUShader *shader, const char *texture_name) const
 {
   BLI_assert(storage_type_ == ResultStorageType::GPU);
@@ -485,10 +508,12 @@ void Result::free()
       gpu_texture_ = nullptr;
       break;
     case ResultStorageType::FloatCPU:
+      context_->add_memory_usage(-int64_t(MEM_allocN_len(float_texture_)));
       MEM_freeN(float_texture_);
       float_texture_ = nullptr;
       break;
     case ResultStorageType::IntegerCPU:
+      context_->add_memory_usage(-int64_t(MEM_allocN_len(integer_texture_)));
       MEM_freeN(integer_texture_);
       integer_texture_ = nullptr;
       break;
@@ -554,6 +579,21 @@ bool Result::is_allocated() const
   return false;
 }
 
+int64_t Result::size_in_bytes() const
+{
+  if (!this->is_allocated()) {
+    return 0;
+  }
+
+  const int2 size = is_single_value_ ? int2(1) : domain_.size;
+  const int64_t pixels_count = int64_t(size.x) * int64_t(size.y);
+
+  /* CPU data is always stored in full precision. */
+  const bool is_half = storage_type_ == ResultStorageType::GPU &&
+                       precision_ == ResultPrecision::Half;
+  return pixels_count * this->channels_count() * (is_half ? 2 : 4);
+}
+
 int Result::reference_count() const
 {
   /* If there is a master result, return its reference count instead. */
@@ -589,12 +629,14 @@ void Result::allocate_data(int2 size, bool from_pool)
       case ResultType::Float3:
         float_texture_ = static_cast<float *>(MEM_malloc_arrayN(
             int64_t(size.x) * int64_t(size.y), this->channels_count() * sizeof(float), __func__));
+        context_->add_memory_usage(MEM_allocN_len(float_texture_));
         storage_type_ = ResultStorageType::FloatCPU;
         break;
       case ResultType::Int:
       case ResultType::Int2:
         integer_texture_ = static_cast<int *>(MEM_malloc_arrayN(
             int64_t(size.x) * int64_t(size.y), this->channels_count() * sizeof(int), __func__));
+        context_->add_memory_usage(MEM_allocN_len(integer_texture_));
         storage_type_ = ResultStorageType::IntegerCPU;
         break;
     }
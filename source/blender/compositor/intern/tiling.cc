@@ -0,0 +1,80 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <algorithm>
+#include <optional>
+
+#include "BLI_map.hh"
+
+#include "DNA_node_types.h"
+
+#include "BKE_node.hh"
+
+#include "NOD_derived_node_tree.hh"
+
+#include "COM_context.hh"
+#include "COM_scheduler.hh"
+#include "COM_tiling.hh"
+#include "COM_utilities.hh"
+
+namespace blender::compositor {
+
+using namespace nodes::derived_node_tree_types;
+
+/* Get the halo that the given node needs around the pixels it computes, not taking its
+ * dependencies into account. */
+static std::optional<int> get_node_tile_halo(const DNode &node)
+{
+  if (is_pixel_node(node)) {
+    return 0;
+  }
+
+  if (!node->typeinfo->get_compositor_tile_halo) {
+    return std::nullopt;
+  }
+
+  return node->typeinfo->get_compositor_tile_halo(*node);
+}
+
+std::optional<int> compute_tile_halo(const Context &context)
+{
+  const DerivedNodeTree tree(context.get_node_tree());
+  if (tree.has_link_cycles() || tree.has_undefined_nodes_or_sockets()) {
+    return std::nullopt;
+  }
+
+  /* The schedule is ordered such that the nodes a node depends on are scheduled before it, so the
+   * halos of the dependencies are always computed before the node itself. */
+  const Schedule schedule = compute_schedule(context, tree);
+
+  Map<DNode, int> nodes_halos;
+  int tile_halo = 0;
+  for (const DNode &node : schedule) {
+    const std::optional<int> node_halo = get_node_tile_halo(node);
+    if (!node_halo) {
+      return std::nullopt;
+    }
+
+    int dependencies_halo = 0;
+    for (const bNodeSocket *input : node->input_sockets()) {
+      const DInputSocket dinput{node.context(), input};
+
+      /* Unlinked inputs have no dependency node. */
+      const DOutputSocket doutput = get_output_linked_to_input(dinput);
+      if (!doutput) {
+        continue;
+      }
+
+      dependencies_halo = std::max(dependencies_halo, nodes_halos.lookup(doutput.node()));
+    }
+
+    const int halo = *node_halo + dependencies_halo;
+    nodes_halos.add_new(node, halo);
+    tile_halo = std::max(tile_halo, halo);
+  }
+
+  return tile_halo;
+}
+
+}  // namespace blender::compositor
@@ -0,0 +1,399 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include <chrono>
+#include <memory>
+#include <optional>
+
+#include "CLG_log.h"
+
+#include "BLI_math_vector_types.hh"
+#include "BLI_set.hh"
+#include "BLI_span.hh"
+#include "BLI_string_ref.hh"
+
+#include "DNA_ID.h"
+#include "DNA_genfile.h"
+#include "DNA_mask_types.h"
+#include "DNA_node_types.h"
+#include "DNA_scene_types.h"
+#include "DNA_vec_types.h"
+
+#include "RNA_define.hh"
+
+#include "BKE_idtype.hh"
+#include "BKE_lib_id.hh"
+#include "BKE_node.hh"
+#include "BKE_node_tree_update.hh"
+
+#include "NOD_derived_node_tree.hh"
+
+#include "COM_context.hh"
+#include "COM_domain.hh"
+#include "COM_node_operation.hh"
+#include "COM_node_result_cache.hh"
+#include "COM_result.hh"
+#include "COM_scheduler.hh"
+#include "COM_texture_pool.hh"
+
+namespace blender::compositor::tests {
+
+constexpr int RESULT_SIZE = 4;
+/* The size in bytes of a full precision color result of the above size. */
+constexpr int64_t RESULT_BYTES = int64_t(RESULT_SIZE) * RESULT_SIZE * 4 * sizeof(float);
+
+class TestTexturePool : public TexturePool {
+ public:
+  GPUTexture *allocate_texture(int2 /*size*/, eGPUTextureFormat /*format*/) override
+  {
+    return nullptr;
+  }
+};
+
+class TestContext : public Context {
+ private:
+  const bNodeTree &node_tree_;
+  Scene scene_ = {{nullptr}};
+
+ public:
+  TestContext(TexturePool &texture_pool, const bNodeTree &node_tree)
+      : Context(texture_pool), node_tree_(node_tree)
+  {
+    scene_.r.size = 100;
+    scene_.r.frs_sec = 24;
+    scene_.r.frs_sec_base = 1.0f;
+  }
+
+  const Scene &get_scene() const override
+  {
+    return scene_;
+  }
+
+  const bNodeTree &get_node_tree() const override
+  {
+    return node_tree_;
+  }
+
+  bool use_gpu() const override
+  {
+    return false;
+  }
+
+  eCompositorDenoiseQaulity get_denoise_quality() const override
+  {
+    return SCE_COMPOSITOR_DENOISE_HIGH;
+  }
+
+  OutputTypes needed_outputs() const override
+  {
+    return OutputTypes::Composite;
+  }
+
+  const RenderData &get_render_data() const override
+  {
+    return scene_.r;
+  }
+
+  int2 get_render_size() const override
+  {
+    return int2(RESULT_SIZE);
+  }
+
+  rcti get_compositing_region() const override
+  {
+    return rcti{0, RESULT_SIZE, 0, RESULT_SIZE};
+  }
+
+  Result get_output_result() override
+  {
+    return this->create_result(ResultType::Color);
+  }
+
+  Result get_viewer_output_result(Domain /*domain*/,
+                                  bool /*is_data*/,
+                                  ResultPrecision /*precision*/) override
+  {
+    return this->create_result(ResultType::Color);
+  }
+
+  Result get_pass(const Scene * /*scene*/, int /*view_layer*/, const char * /*pass_name*/) override
+  {
+    return this->create_result(ResultType::Color);
+  }
+
+  StringRef get_view_name() const override
+  {
+    return "";
+  }
+
+  ResultPrecision get_precision() const override
+  {
+    return ResultPrecision::Full;
+  }
+
+  void set_info_message(StringRef /*message*/) const override {}
+
+  IDRecalcFlag query_id_recalc_flag(ID * /*id*/) const override
+  {
+    return IDRecalcFlag(0);
+  }
+};
+
+/* An operation that computes nothing, its results are allocated by the test instead. */
+class TestOperation : public NodeOperation {
+ public:
+  using NodeOperation::NodeOperation;
+
+  void execute() override {}
+};
+
+class NodeResultCacheTest : public testing::Test {
+ public:
+  bNodeTree *node_tree = nullptr;
+  TestTexturePool texture_pool;
+  std::unique_ptr<TestContext> context;
+  NodeResultCache cache;
+
+  /* The nodes whose results were retrieved from the cache and the nodes that were evaluated in the
+   * last call to evaluate. */
+  Set<const bNode *> hits;
+  Set<const bNode *> evaluated;
+
+  static void SetUpTestSuite()
+  {
+    CLG_init();
+    DNA_sdna_current_init();
+    BKE_idtype_init();
+    RNA_init();
+    bke::node_system_init();
+  }
+
+  static void TearDownTestSuite()
+  {
+    bke::node_system_exit();
+    RNA_exit();
+    DNA_sdna_current_free();
+    CLG_exit();
+  }
+
+  void SetUp() override
+  {
+    node_tree = bke::node_tree_add_tree(nullptr, "Test", "CompositorNodeTree");
+    context = std::make_unique<TestContext>(texture_pool, *node_tree);
+    cache.set_limit(RESULT_BYTES * 16);
+  }
+
+  void TearDown() override
+  {
+    cache.clear();
+    context.reset();
+    BKE_id_free(nullptr, &node_tree->id);
+  }
+
+  bNode *add_node(const StringRef idname)
+  {
+    return bke::node_add_node(nullptr, node_tree, idname);
+  }
+
+  bNode *add_filter_node(const int filter_type)
+  {
+    bNode *node = this->add_node("CompositorNodeFilter");
+    node->custom1 = filter_type;
+    return node;
+  }
+
+  void add_link(bNode *from_node, const StringRef from_socket, bNode *to_node)
+  {
+    bke::node_add_link(node_tree,
+                       from_node,
+                       bke::node_find_socket(from_node, SOCK_OUT, from_socket),
+                       to_node,
+                       bke::node_find_socket(to_node, SOCK_IN, "Image"));
+  }
+
+  /* Evaluate the given nodes, which are expected to be topologically sorted, the same way the
+   * evaluator does, except that the results of the evaluated nodes are allocated without computing
+   * them, and are added to the cache as if they took a second to compute. */
+  void evaluate(const Span<const bNode *> nodes)
+  {
+    BKE_ntree_update_without_main(*node_tree);
+    const nodes::DerivedNodeTree derived_node_tree(*node_tree);
+
+    Schedule schedule;
+    for (const bNode *node : nodes) {
+      schedule.add_new(DNode(&derived_node_tree.root_context(), node));
+    }
+
+    hits.clear();
+    evaluated.clear();
+    const Schedule needed_schedule = cache.begin_evaluation(*context, schedule);
+    for (const DNode &node : needed_schedule) {
+      if (cache.lookup(node)) {
+        hits.add_new(node.bnode());
+        continue;
+      }
+
+      evaluated.add_new(node.bnode());
+      TestOperation operation(*context, node);
+      for (const bNodeSocket *output : node->output_sockets()) {
+        Result &result = operation.get_result(output->identifier);
+        result.set_initial_reference_count(1);
+        result.allocate_texture(Domain(int2(RESULT_SIZE)));
+      }
+
+      cache.add(*context, node, operation, std::chrono::seconds(1));
+
+      for (const bNodeSocket *output : node->output_sockets()) {
+        operation.get_result(output->identifier).free();
+      }
+    }
+  }
+};
+
+TEST_F(NodeResultCacheTest, unchanged_tree)
+{
+  bNode *rgb = this->add_node("CompositorNodeRGB");
+  bNode *soft = this->add_filter_node(CMP_NODE_FILTER_SOFT);
+  bNode *sharp = this->add_filter_node(CMP_NODE_FILTER_SHARP_BOX);
+  this->add_link(rgb, "RGBA", soft);
+  this->add_link(soft, "Image", sharp);
+
+  this->evaluate({rgb, soft, sharp});
+  EXPECT_TRUE(hits.is_empty());
+  EXPECT_EQ(evaluated.size(), 3);
+  EXPECT_EQ(cache.additions_count(), 3);
+
+  /* Only the last node is needed, and its results are cached, so nothing is evaluated. */
+  this->evaluate({rgb, soft, sharp});
+  EXPECT_EQ(hits.size(), 1);
+  EXPECT_TRUE(hits.contains(sharp));
+  EXPECT_TRUE(evaluated.is_empty());
+  EXPECT_EQ(cache.additions_count(), 0);
+}
+
+TEST_F(NodeResultCacheTest, unchanged_upstream_subtree)
+{
+  bNode *rgb = this->add_node("CompositorNodeRGB");
+  bNode *soft = this->add_filter_node(CMP_NODE_FILTER_SOFT);
+  bNode *sharp = this->add_filter_node(CMP_NODE_FILTER_SHARP_BOX);
+  this->add_link(rgb, "RGBA", soft);
+  this->add_link(soft, "Image", sharp);
+
+  this->evaluate({rgb, soft, sharp});
+
+  /* The changed node is evaluated using the cached results of the node it depends on, while the
+   * nodes upstream of that node are not needed at all. */
+  sharp->custom1 = CMP_NODE_FILTER_LAPLACE;
+  this->evaluate({rgb, soft, sharp});
+  EXPECT_EQ(hits.size(), 1);
+  EXPECT_TRUE(hits.contains(soft));
+  EXPECT_EQ(evaluated.size(), 1);
+  EXPECT_TRUE(evaluated.contains(sharp));
+}
+
+TEST_F(NodeResultCacheTest, upstream_parameter_change)
+{
+  bNode *rgb = this->add_node("CompositorNodeRGB");
+  bNode *soft = this->add_filter_node(CMP_NODE_FILTER_SOFT);
+  bNode *sharp = this->add_filter_node(CMP_NODE_FILTER_SHARP_BOX);
+  this->add_link(rgb, "RGBA", soft);
+  this->add_link(soft, "Image", sharp);
+
+  this->evaluate({rgb, soft, sharp});
+
+  /* The RGB node stores its color in its output. */
+  bNodeSocket *rgb_output = bke::node_find_socket(rgb, SOCK_OUT, "RGBA");
+  rgb_output->default_value_typed<bNodeSocketValueRGBA>()->value[0] = 0.25f;
+  this->evaluate({rgb, soft, sharp});
+  EXPECT_TRUE(hits.is_empty());
+  EXPECT_EQ(evaluated.size(), 3);
+
+  /* Unlinked inputs are part of the key as well. */
+  bNodeSocket *factor_input = bke::node_find_socket(soft, SOCK_IN, "Fac");
+  factor_input->default_value_typed<bNodeSocketValueFloat>()->value = 0.5f;
+  this->evaluate({rgb, soft, sharp});
+  EXPECT_EQ(hits.size(), 1);
+  EXPECT_TRUE(hits.contains(rgb));
+  EXPECT_EQ(evaluated.size(), 2);
+  EXPECT_TRUE(evaluated.contains(soft));
+  EXPECT_TRUE(evaluated.contains(sharp));
+
+  /* Reverting the change retrieves the results of the first evaluation. */
+  rgb_output->default_value_typed<bNodeSocketValueRGBA>()->value[0] = 0.5f;
+  factor_input->default_value_typed<bNodeSocketValueFloat>()->value = 1.0f;
+  this->evaluate({rgb, soft, sharp});
+  EXPECT_EQ(hits.size(), 1);
+  EXPECT_TRUE(hits.contains(sharp));
+  EXPECT_TRUE(evaluated.is_empty());
+}
+
+TEST_F(NodeResultCacheTest, eviction_order)
+{
+  /* Independent nodes whose results have the same size. */
+  bNode *soft = this->add_filter_node(CMP_NODE_FILTER_SOFT);
+  bNode *sharp = this->add_filter_node(CMP_NODE_FILTER_SHARP_BOX);
+  bNode *laplace = this->add_filter_node(CMP_NODE_FILTER_LAPLACE);
+
+  cache.set_limit(RESULT_BYTES * 2);
+
+  this->evaluate({soft, sharp});
+  EXPECT_EQ(cache.entries_count(), 2);
+  EXPECT_EQ(cache.size(), RESULT_BYTES * 2);
+
+  /* Use the soft node, such that the sharp node becomes the least recently used one. */
+  this->evaluate({soft});
+  EXPECT_TRUE(hits.contains(soft));
+
+  this->evaluate({laplace});
+  EXPECT_EQ(cache.entries_count(), 2);
+  EXPECT_EQ(cache.size(), RESULT_BYTES * 2);
+
+  this->evaluate({soft, sharp, laplace});
+  EXPECT_EQ(hits.size(), 2);
+  EXPECT_TRUE(hits.contains(soft));
+  EXPECT_TRUE(hits.contains(laplace));
+  EXPECT_EQ(evaluated.size(), 1);
+  EXPECT_TRUE(evaluated.contains(sharp));
+
+  /* Results larger than the limit are not cached. */
+  cache.set_limit(RESULT_BYTES / 2);
+  EXPECT_EQ(cache.entries_count(), 0);
+  this->evaluate({soft});
+  EXPECT_EQ(cache.entries_count(), 0);
+
+  /* A zero limit disables the cache. */
+  cache.set_limit(0);
+  this->evaluate({soft});
+  EXPECT_EQ(cache.entries_count(), 0);
+  EXPECT_EQ(evaluated.size(), 1);
+}
+
+TEST_F(NodeResultCacheTest, unidentifiable_node)
+{
+  /* The mask node reads an ID whose changes can't be tracked, so neither it nor the nodes that
+   * depend on it can be cached. */
+  Mask *mask = static_cast<Mask *>(BKE_id_new_nomain(ID_MSK, "Mask"));
+  bNode *mask_node = this->add_node("CompositorNodeMask");
+  mask_node->id = &mask->id;
+  bNode *mask_filter = this->add_filter_node(CMP_NODE_FILTER_SOFT);
+  this->add_link(mask_node, "Mask", mask_filter);
+  bNode *filter = this->add_filter_node(CMP_NODE_FILTER_SHARP_BOX);
+
+  this->evaluate({mask_node, mask_filter, filter});
+  EXPECT_EQ(cache.entries_count(), 1);
+
+  this->evaluate({mask_node, mask_filter, filter});
+  EXPECT_EQ(hits.size(), 1);
+  EXPECT_TRUE(hits.contains(filter));
+  EXPECT_EQ(evaluated.size(), 2);
+  EXPECT_TRUE(evaluated.contains(mask_node));
+  EXPECT_TRUE(evaluated.contains(mask_filter));
+
+  mask_node->id = nullptr;
+  BKE_id_free(nullptr, &mask->id);
+}
+
+}  // namespace blender::compositor::tests
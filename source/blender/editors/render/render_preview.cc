@@ -1389,7 +1389,7 @@ static void icon_copy_rect(const ImBuf *ibuf, uint w, uint h, uint *rect)
   int dx = (w - ex) / 2;
   int dy = (h - ey) / 2;
 
-  ImBuf *ima = IMB_scale_into_new(ibuf, ex, ey, IMBScaleFilter::Nearest, false);
+  ImBuf *ima = IMB_scale_into_new(ibuf, ex, ey, IMBScaleFilter::Nearest);
   if (ima == nullptr) {
     return;
   }
@@ -31,6 +31,8 @@
 
 #include <mutex>
 
+#include <zstd.h>
+
 #include "CLG_log.h"
 
 #include "BLI_array.hh"
@@ -38,6 +40,8 @@
 #include "BLI_listbase.h"
 #include "BLI_map.hh"
 #include "BLI_string.h"
+#include "BLI_task.h"
+#include "BLI_time.h"
 #include "BLI_utildefines.h"
 #include "BLI_vector.hh"
 
@@ -124,6 +128,18 @@ namespace blender::ed::sculpt_paint::undo {
 
 #define NO_ACTIVE_LAYER bke::AttrDomain::Auto
 
+/**
+ * An array of a finished undo step, compressed with ZSTD. See #compress_nodes_start.
+ */
+struct CompressedArray {
+  /** Compressed bytes of the array. */
+  Array<uint8_t, 0> data;
+  /** False if the compression failed, in which case the bytes are stored as they are. */
+  bool is_compressed = false;
+  /** The number of values in the array, zero if the array isn't stored in this form. */
+  int64_t values_num = 0;
+};
+
 struct Node {
   Array<float3, 0> position;
   Array<float3, 0> orig_position;
@@ -156,6 +172,10 @@ struct Node {
   Array<int, 0> face_sets;
 
   Vector<int> face_indices;
+
+  /* Compressed storage of #position and #mask, these are empty when it is used. */
+  CompressedArray position_compressed;
+  CompressedArray mask_compressed;
 };
 
 struct SculptAttrRef {
@@ -249,6 +269,12 @@ struct StepData {
   /** Storage of per-node undo data after creation of the undo step is finished. */
   Vector<std::unique_ptr<Node>> nodes;
 
+  /**
+   * Compresses the node data in the background after the undo step is finished. The nodes must
+   * not be accessed before waiting for it with #compress_nodes_wait.
+   */
+  TaskPool *compress_task_pool = nullptr;
+
   size_t undo_size;
 };
 
@@ -1770,13 +1796,326 @@ static size_t node_size_in_bytes(const Node &node)
   size += node.grid_hidden.all_bits().size() / 8;
   size += node.face_sets.as_span().size_in_bytes();
   size += node.face_indices.as_span().size_in_bytes();
+  size += node.position_compressed.data.as_span().size_in_bytes();
+  size += node.mask_compressed.data.as_span().size_in_bytes();
   return size;
 }
 
+static size_t step_size_in_bytes(const StepData &step_data)
+{
+  return threading::parallel_reduce(
+      step_data.nodes.index_range(),
+      16,
+      size_t(0),
+      [&](const IndexRange range, size_t size) {
+        for (const int i : range) {
+          size += node_size_in_bytes(*step_data.nodes[i]);
+        }
+        return size;
+      },
+      std::plus<size_t>());
+}
+
+/**
+ * Check whether restoring the undo node would leave the mesh unchanged, i.e. whether the operation
+ * didn't modify any of the data stored in the node. This is common for nodes that are only
+ * touched by the brush bounds, are fully masked, or are filtered out by auto-masking.
+ */
+static bool node_data_unchanged_mesh(const Object &object, const Type type, const Node &unode)
+{
+  const Mesh &mesh = *static_cast<const Mesh *>(object.data);
+  const bke::AttributeAccessor attributes = mesh.attributes();
+  const Span<int> verts = unode.vert_indices.as_span().take_front(unode.unique_verts_num);
+  switch (type) {
+    case Type::Position: {
+      if (!unode.orig_position.is_empty()) {
+        /* The positions are restored into the active shape key or the original mesh positions,
+         * keep the handling of that in one place. */
+        return false;
+      }
+      const Span<float3> positions = mesh.vert_positions();
+      for (const int i : verts.index_range()) {
+        if (unode.position[i] != positions[verts[i]]) {
+          return false;
+        }
+      }
+      return true;
+    }
+    case Type::Mask: {
+      const VArraySpan mask = *attributes.lookup<float>(".sculpt_mask", bke::AttrDomain::Point);
+      for (const int i : verts.index_range()) {
+        if (unode.mask[i] != (mask.is_empty() ? 0.0f : mask[verts[i]])) {
+          return false;
+        }
+      }
+      return true;
+    }
+    case Type::FaceSet: {
+      const VArraySpan face_sets = *attributes.lookup<int>(".sculpt_face_set",
+                                                           bke::AttrDomain::Face);
+      const Span<int> faces = unode.face_indices;
+      for (const int i : faces.index_range()) {
+        if (unode.face_sets[i] != (face_sets.is_empty() ? 1 : face_sets[faces[i]])) {
+          return false;
+        }
+      }
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+static bool node_data_unchanged_grids(const Object &object, const Type type, const Node &unode)
+{
+  const SubdivCCG &subdiv_ccg = *object.sculpt->subdiv_ccg;
+  const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
+  const Span<int> grids = unode.grids;
+  switch (type) {
+    case Type::Position: {
+      for (const int i : grids.index_range()) {
+        if (unode.position.as_span().slice(bke::ccg::grid_range(key, i)) !=
+            subdiv_ccg.positions.as_span().slice(bke::ccg::grid_range(key, grids[i])))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+    case Type::Mask: {
+      if (subdiv_ccg.masks.is_empty()) {
+        return std::all_of(
+            unode.mask.begin(), unode.mask.end(), [](const float value) { return value == 0.0f; });
+      }
+      for (const int i : grids.index_range()) {
+        if (unode.mask.as_span().slice(bke::ccg::grid_range(key, i)) !=
+            subdiv_ccg.masks.as_span().slice(bke::ccg::grid_range(key, grids[i])))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+    case Type::FaceSet:
+      /* Face sets are stored on the base mesh. */
+      return node_data_unchanged_mesh(object, type, unode);
+    default:
+      return false;
+  }
+}
+
+/**
+ * Remove undo nodes whose data wasn't changed by the operation. Restoring them would be a no-op,
+ * but they would still take as much memory as the nodes that were actually modified.
+ */
+static void remove_unchanged_nodes(const Object &object, StepData &step_data)
+{
+  const SculptSession &ss = *object.sculpt;
+  if (ss.bm) {
+    /* Dynamic topology stores its changes in the #BMLog instead. */
+    return;
+  }
+  if (!ELEM(step_data.type, Type::Position, Type::Mask, Type::FaceSet)) {
+    return;
+  }
+  if (!topology_matches(step_data, object)) {
+    return;
+  }
+  const bool use_grids = use_multires_undo(step_data, ss);
+  threading::parallel_for(step_data.nodes.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      const Node &unode = *step_data.nodes[i];
+      if (use_grids ? node_data_unchanged_grids(object, step_data.type, unode) :
+                      node_data_unchanged_mesh(object, step_data.type, unode))
+      {
+        step_data.nodes[i].reset();
+      }
+    }
+  });
+  step_data.nodes.remove_if([](const std::unique_ptr<Node> &unode) { return !unode; });
+}
+
+/* -------------------------------------------------------------------- */
+/** \name Undo Node Compression
+ *
+ * The positions and masks of finished undo steps are compressed with ZSTD in a background task.
+ * The arrays are decompressed for restoring the step, and the values swapped in from the mesh
+ * are compressed again afterwards.
+ *
+ * The stored values don't depend on the current mesh data, so a step can always be restored even
+ * if the mesh changed in ways the undo system doesn't track. Grouping the bytes of the values
+ * into separate planes lets the sign and exponent bytes, which are mostly the same for nearby
+ * values, compress well.
+ * \{ */
+
+/* Higher levels are much slower while barely reducing the size of the arrays. */
+static constexpr int UNDO_ZSTD_COMPRESSION_LEVEL = 1;
+
+static bool use_compression(const StepData &step_data, const Node &unode)
+{
+  switch (step_data.type) {
+    case Type::Position:
+      /* With deform modifiers the positions are restored into shape keys or the original
+       * positions, see #restore_position_mesh. */
+      return unode.orig_position.is_empty() && !unode.position.is_empty();
+    case Type::Mask:
+      return !unode.mask.is_empty();
+    default:
+      return false;
+  }
+}
+
+/** Group the bytes of 32 bit values into planes, such that similar bytes are contiguous. */
+static void shuffle_bytes(const Span<uint8_t> src, MutableSpan<uint8_t> dst)
+{
+  const int64_t values_num = src.size() / 4;
+  for (const int64_t i : IndexRange(values_num)) {
+    for (const int byte : IndexRange(4)) {
+      dst[byte * values_num + i] = src[i * 4 + byte];
+    }
+  }
+}
+
+static void unshuffle_bytes(const Span<uint8_t> src, MutableSpan<uint8_t> dst)
+{
+  const int64_t values_num = src.size() / 4;
+  for (const int64_t i : IndexRange(values_num)) {
+    for (const int byte : IndexRange(4)) {
+      dst[i * 4 + byte] = src[byte * values_num + i];
+    }
+  }
+}
+
+template<typename T> static void compress_array(Array<T, 0> &values, CompressedArray &compressed)
+{
+  static_assert(sizeof(T) % sizeof(uint32_t) == 0);
+  const Span<uint8_t> bytes = values.as_span().template cast<uint8_t>();
+  Array<uint8_t, 0> shuffled(bytes.size(), NoInitialization());
+  shuffle_bytes(bytes, shuffled);
+
+  Array<uint8_t, 0> buffer(ZSTD_compressBound(bytes.size()), NoInitialization());
+  const size_t compressed_size = ZSTD_compress(buffer.data(),
+                                               buffer.size(),
+                                               shuffled.data(),
+                                               shuffled.size(),
+                                               UNDO_ZSTD_COMPRESSION_LEVEL);
+  if (ZSTD_isError(compressed_size)) {
+    compressed.data = std::move(shuffled);
+    compressed.is_compressed = false;
+  }
+  else {
+    compressed.data = buffer.as_span().take_front(compressed_size);
+    compressed.is_compressed = true;
+  }
+  compressed.values_num = values.size();
+  values = {};
+}
+
+template<typename T>
+static void decompress_array(CompressedArray &compressed, Array<T, 0> &values)
+{
+  values.reinitialize(compressed.values_num);
+  MutableSpan<uint8_t> bytes = values.as_mutable_span().template cast<uint8_t>();
+  if (compressed.is_compressed) {
+    Array<uint8_t, 0> shuffled(bytes.size(), NoInitialization());
+    const size_t size = ZSTD_decompress(
+        shuffled.data(), shuffled.size(), compressed.data.data(), compressed.data.size());
+    /* The data was compressed by this process, a failure means it was corrupted in memory. */
+    BLI_assert(!ZSTD_isError(size) && int64_t(size) == shuffled.size());
+    UNUSED_VARS_NDEBUG(size);
+    unshuffle_bytes(shuffled, bytes);
+  }
+  else {
+    unshuffle_bytes(compressed.data, bytes);
+  }
+  compressed = {};
+}
+
+static void compress_node_task(TaskPool *__restrict pool, void *taskdata)
+{
+  const StepData &step_data = *static_cast<const StepData *>(BLI_task_pool_user_data(pool));
+  Node &unode = *static_cast<Node *>(taskdata);
+  if (step_data.type == Type::Position) {
+    compress_array(unode.position, unode.position_compressed);
+  }
+  else {
+    compress_array(unode.mask, unode.mask_compressed);
+  }
+}
+
+/**
+ * Compress the positions or masks of the step in the background. Called when the step is
+ * finished, and again after restoring it.
+ */
+static void compress_nodes_start(StepData &step_data)
+{
+  BLI_assert(step_data.compress_task_pool == nullptr);
+  if (!std::any_of(step_data.nodes.begin(), step_data.nodes.end(), [&](const auto &unode) {
+        return use_compression(step_data, *unode);
+      }))
+  {
+    return;
+  }
+  step_data.compress_task_pool = BLI_task_pool_create_background(&step_data, TASK_PRIORITY_LOW);
+  for (std::unique_ptr<Node> &unode : step_data.nodes) {
+    if (use_compression(step_data, *unode)) {
+      BLI_task_pool_push(
+          step_data.compress_task_pool, compress_node_task, unode.get(), false, nullptr);
+    }
+  }
+}
+
+/** Wait for the background compression of the step and update its memory usage. */
+static void compress_nodes_wait(SculptUndoStep &us)
+{
+  StepData &step_data = us.data;
+  if (step_data.compress_task_pool == nullptr) {
+    return;
+  }
+  BLI_task_pool_work_and_wait(step_data.compress_task_pool);
+  BLI_task_pool_free(step_data.compress_task_pool);
+  step_data.compress_task_pool = nullptr;
+
+  const size_t uncompressed_size = step_data.undo_size;
+  step_data.undo_size = step_size_in_bytes(step_data);
+  us.step.data_size = step_data.undo_size;
+  CLOG_INFO(&LOG,
+            2,
+            "Undo step compressed from %zu to %zu bytes.",
+            uncompressed_size,
+            step_data.undo_size);
+}
+
+/** Decompress the node data of the step for restoring it. */
+static void decompress_nodes(StepData &step_data)
+{
+  threading::parallel_for(step_data.nodes.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      Node &unode = *step_data.nodes[i];
+      if (unode.position_compressed.values_num != 0) {
+        decompress_array(unode.position_compressed, unode.position);
+      }
+      if (unode.mask_compressed.values_num != 0) {
+        decompress_array(unode.mask_compressed, unode.mask);
+      }
+    }
+  });
+}
+
+/** \} */
+
 void push_end_ex(Object &ob, const bool use_nested_undo)
 {
   StepData *step_data = get_step_data();
 
+  /* The compression of previous steps is finished by now in practice, wait for it to account for
+   * the compressed size when limiting the memory of the undo stack. */
+  LISTBASE_FOREACH (UndoStep *, us, &ED_undo_stack_get()->steps) {
+    if (us->type == BKE_UNDOSYS_TYPE_SCULPT) {
+      compress_nodes_wait(*reinterpret_cast<SculptUndoStep *>(us));
+    }
+  }
+
   /* Move undo node storage from map to vector. */
   step_data->nodes.reserve(step_data->undo_nodes_by_pbvh_node.size());
   for (std::unique_ptr<Node> &node : step_data->undo_nodes_by_pbvh_node.values()) {
@@ -1784,6 +2123,9 @@ void push_end_ex(Object &ob, const bool use_nested_undo)
   }
   step_data->undo_nodes_by_pbvh_node.clear();
 
+  const int64_t pushed_nodes_num = step_data->nodes.size();
+  remove_unchanged_nodes(ob, *step_data);
+
   /* We don't need normals in the undo stack. */
   for (std::unique_ptr<Node> &unode : step_data->nodes) {
     unode->normal = {};
@@ -1793,17 +2135,16 @@ void push_end_ex(Object &ob, const bool use_nested_undo)
    * just one positions array that has a different semantic meaning depending on whether there are
    * deform modifiers. */
 
-  step_data->undo_size = threading::parallel_reduce(
-      step_data->nodes.index_range(),
-      16,
-      0,
-      [&](const IndexRange range, size_t size) {
-        for (const int i : range) {
-          size += node_size_in_bytes(*step_data->nodes[i]);
-        }
-        return size;
-      },
-      std::plus<size_t>());
+  /* The size is updated once the compression finished, see #compress_nodes_wait. */
+  step_data->undo_size = step_size_in_bytes(*step_data);
+  compress_nodes_start(*step_data);
+
+  CLOG_INFO(&LOG,
+            2,
+            "Undo step uses %zu bytes for %d nodes (%d unchanged nodes removed).",
+            step_data->undo_size,
+            int(step_data->nodes.size()),
+            int(pushed_nodes_num - step_data->nodes.size()));
 
   /* We could remove this and enforce all callers run in an operator using 'OPTYPE_UNDO'. */
   wmWindowManager *wm = static_cast<wmWindowManager *>(G_MAIN->wm.first);
@@ -1910,7 +2251,10 @@ static void step_decode_undo_impl(bContext *C, Depsgraph *depsgraph, SculptUndoS
 {
   BLI_assert(us->step.is_applied == true);
 
+  compress_nodes_wait(*us);
+  decompress_nodes(us->data);
   restore_list(C, depsgraph, us->data);
+  compress_nodes_start(us->data);
   us->step.is_applied = false;
 }
 
@@ -1918,7 +2262,10 @@ static void step_decode_redo_impl(bContext *C, Depsgraph *depsgraph, SculptUndoS
 {
   BLI_assert(us->step.is_applied == false);
 
+  compress_nodes_wait(*us);
+  decompress_nodes(us->data);
   restore_list(C, depsgraph, us->data);
+  compress_nodes_start(us->data);
   us->step.is_applied = true;
 }
 
@@ -2020,6 +2367,8 @@ static void step_decode(
     }
   }
 
+  const double start_time = BLI_time_now_seconds();
+
   SculptUndoStep *us = reinterpret_cast<SculptUndoStep *>(us_p);
   if (dir == STEP_UNDO) {
     step_decode_undo(C, depsgraph, us, is_final);
@@ -2027,11 +2376,19 @@ static void step_decode(
   else if (dir == STEP_REDO) {
     step_decode_redo(C, depsgraph, us);
   }
+
+  CLOG_INFO(&LOG,
+            2,
+            "%s of %zu byte step took %f seconds.",
+            dir == STEP_UNDO ? "Undo" : "Redo",
+            us->data.undo_size,
+            BLI_time_now_seconds() - start_time);
 }
 
 static void step_free(UndoStep *us_p)
 {
   SculptUndoStep *us = reinterpret_cast<SculptUndoStep *>(us_p);
+  compress_nodes_wait(*us);
   free_step_data(us->data);
 }
 
@@ -3281,7 +3281,7 @@ static int image_scale_exec(bContext *C, wmOperator *op)
 
     ED_image_undo_push_begin_with_image(op->type->name, ima, ibuf, &iuser);
     ibuf->userflags |= IB_DISPLAY_BUFFER_INVALID;
-    IMB_scale(ibuf, size[0], size[1], IMBScaleFilter::Box, false);
+    IMB_scale(ibuf, size[0], size[1], IMBScaleFilter::Box);
     BKE_image_mark_dirty(ima, ibuf);
     BKE_image_release_ibuf(ima, ibuf, nullptr);
     ED_image_undo_push_end();
@@ -3319,7 +3319,7 @@ static int image_scale_exec(bContext *C, wmOperator *op)
       }
 
       ibuf->userflags |= IB_DISPLAY_BUFFER_INVALID;
-      IMB_scale(ibuf, size[0], size[1], IMBScaleFilter::Box, false);
+      IMB_scale(ibuf, size[0], size[1], IMBScaleFilter::Box);
       BKE_image_mark_dirty(ima, ibuf);
       BKE_image_release_ibuf(ima, ibuf, nullptr);
     }
@@ -12,6 +12,8 @@
 #include "BKE_global.hh"
 #include "BKE_report.hh"
 
+#include "BLI_listbase.h"
+
 #include "BLT_translation.hh"
 
 #include "SEQ_proxy.hh"
@@ -104,23 +106,23 @@ static int sequencer_rebuild_proxy_exec(bContext *C, wmOperator * /*o*/)
   }
 
   blender::Set<std::string> processed_paths;
+  ListBase queue = {nullptr, nullptr};
 
   LISTBASE_FOREACH (Strip *, seq, SEQ_active_seqbase_get(ed)) {
     if (seq->flag & SELECT) {
-      ListBase queue = {nullptr, nullptr};
-
       SEQ_proxy_rebuild_context(bmain, depsgraph, scene, seq, &processed_paths, &queue, false);
-
-      wmJobWorkerStatus worker_status = {};
-      LISTBASE_FOREACH (LinkData *, link, &queue) {
-        SeqIndexBuildContext *context = static_cast<SeqIndexBuildContext *>(link->data);
-        SEQ_proxy_rebuild(context, &worker_status);
-        SEQ_proxy_rebuild_finish(context, false);
-      }
-      SEQ_relations_free_imbuf(scene, &ed->seqbase, false);
     }
   }
 
+  wmJobWorkerStatus worker_status = {};
+  SEQ_proxy_rebuild_queue(&queue, &worker_status);
+
+  LISTBASE_FOREACH (LinkData *, link, &queue) {
+    SEQ_proxy_rebuild_finish(static_cast<SeqIndexBuildContext *>(link->data), false);
+  }
+  BLI_freelistN(&queue);
+  SEQ_relations_free_imbuf(scene, &ed->seqbase, false);
+
   return OPERATOR_FINISHED;
 }
 
@@ -355,7 +355,7 @@ void Canvas::loadMap(const char *iFileName, const char *iMapName, uint iNbLevels
   ImBuf *scaledImg;
   if ((qimg->x != width()) || (qimg->y != height())) {
     scaledImg = IMB_dupImBuf(qimg);
-    IMB_scale(scaledImg, width(), height(), IMBScaleFilter::Box, false);
+    IMB_scale(scaledImg, width(), height(), IMBScaleFilter::Box);
   }
 
   // deal with color image
@@ -329,17 +329,26 @@ enum class IMBScaleFilter {
    * better results when scaling down by more than 2x.
    */
   Box,
+  /**
+   * Mitchell-Netravali cubic filter (B=C=1/3). Sharper than Box with little ringing, good for both
+   * scaling up and down.
+   */
+  Mitchell,
+  /**
+   * Lanczos filter with a radius of 3 pixels. Sharpest result, but can produce slight ringing
+   * around high contrast edges.
+   */
+  Lanczos,
 };
 
 /**
  * Scale/resize image to new dimensions.
  * Return true if \a ibuf is modified.
+ *
+ * All filters use multiple threads, in an isolated task so that callers holding locks can not
+ * deadlock.
  */
-bool IMB_scale(ImBuf *ibuf,
-               unsigned int newx,
-               unsigned int newy,
-               IMBScaleFilter filter,
-               bool threaded = true);
+bool IMB_scale(ImBuf *ibuf, unsigned int newx, unsigned int newy, IMBScaleFilter filter);
 
 /**
  * Scale/resize image to new dimensions, into a newly created result image.
@@ -348,8 +357,7 @@ bool IMB_scale(ImBuf *ibuf,
 ImBuf *IMB_scale_into_new(const ImBuf *ibuf,
                           unsigned int newx,
                           unsigned int newy,
-                          IMBScaleFilter filter,
-                          bool threaded = true);
+                          IMBScaleFilter filter);
 
 bool IMB_saveiff(ImBuf *ibuf, const char *filepath, int flags);
 
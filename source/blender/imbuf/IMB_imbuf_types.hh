@@ -111,6 +111,9 @@ enum eImBufFlags {
   IB_thumbnail = 1 << 16,
   IB_multiview = 1 << 17,
   IB_halffloat = 1 << 18,
+  /** Only parse the layers and passes of multilayer files without reading their pixels, which
+   * can be read later using #IMB_exr_read_assigned_passes. */
+  IB_multilayer_lazy = 1 << 19,
 };
 
 /** \} */
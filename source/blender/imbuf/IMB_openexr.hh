@@ -76,6 +76,26 @@ float *IMB_exr_channel_rect(void *handle,
                             const char *viewname);
 
 void IMB_exr_read_channels(void *handle);
+/**
+ * Assign the buffer that the channels of the given pass are read into by
+ * #IMB_exr_read_assigned_passes. The buffer is owned by the caller and is expected to be large
+ * enough to store the interleaved channels of the pass.
+ * \param passname: Does not include view.
+ * \param totchan: The expected number of channels of the pass.
+ * \return false if the pass doesn't exist, has a different number of channels or already has a
+ * buffer.
+ */
+bool IMB_exr_pass_assign_rect(void *handle,
+                              const char *layname,
+                              const char *passname,
+                              const char *viewname,
+                              int totchan,
+                              float *rect);
+/**
+ * Read only the channels of the passes assigned through #IMB_exr_pass_assign_rect, without
+ * reading other passes, then unassign their buffers.
+ */
+void IMB_exr_read_assigned_passes(void *handle);
 void IMB_exr_write_channels(void *handle);
 /**
  * Temporary function, used for FSA and Save Buffers.
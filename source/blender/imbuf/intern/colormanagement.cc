@@ -11,6 +11,9 @@
 
 #include <cmath>
 #include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
 
 #include "DNA_color_types.h"
 #include "DNA_image_types.h"
@@ -18,6 +21,7 @@
 #include "DNA_scene_types.h"
 #include "DNA_sequence_types.h"
 #include "DNA_space_types.h"
+#include "DNA_userdef_types.h"
 
 #include "IMB_filetype.hh"
 #include "IMB_filter.hh"
@@ -28,6 +32,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_map.hh"
 #include "BLI_math_color.h"
 #include "BLI_math_color.hh"
 #include "BLI_path_utils.hh"
@@ -52,7 +57,10 @@
 
 #include <ocio_capi.h>
 
+#include "colormanagement_lut.hh"
+
 using blender::float3x3;
+using blender::imbuf::ColorLut3D;
 
 /* -------------------------------------------------------------------- */
 /** \name Global declarations
@@ -97,11 +105,18 @@ float imbuf_aces_to_scene_linear[3][3] = {{0.0f}};
 static pthread_mutex_t processor_lock = BLI_MUTEX_INITIALIZER;
 
 struct ColormanageProcessor {
-  OCIO_ConstCPUProcessorRcPtr *cpu_processor;
-  CurveMapping *curve_mapping;
-  bool is_data_result;
+  OCIO_ConstCPUProcessorRcPtr *cpu_processor = nullptr;
+  /* When set, used instead of `cpu_processor` for processing of buffers. */
+  std::shared_ptr<const ColorLut3D> display_lut;
+  CurveMapping *curve_mapping = nullptr;
+  bool is_data_result = false;
 };
 
+/* Display transforms baked into lookup tables, by the settings of the transform. */
+#define DISPLAY_LUT_CACHE_MAX_ITEMS 8
+static std::mutex display_lut_cache_mutex;
+static blender::Map<std::string, std::shared_ptr<const ColorLut3D>> display_lut_cache;
+
 static struct global_gpu_state {
   /* GPU shader currently bound. */
   bool gpu_shader_bound;
@@ -613,6 +628,11 @@ static void colormanage_free_config()
   ColorSpace *colorspace;
   ColorManagedDisplay *display;
 
+  {
+    std::lock_guard lock(display_lut_cache_mutex);
+    display_lut_cache.clear();
+  }
+
   /* free color spaces */
   colorspace = static_cast<ColorSpace *>(global_colorspaces.first);
   while (colorspace) {
@@ -1898,6 +1918,64 @@ static bool is_colorspace_same_as_display(const ColorSpace *colorspace,
   return false;
 }
 
+/* Bake the display transform of the processor into a lookup table, or use an existing table that
+ * was baked for the same settings. */
+static void display_processor_lut_ensure(ColormanageProcessor *cm_processor,
+                                         const ColorManagedViewSettings *view_settings,
+                                         const ColorManagedDisplaySettings *display_settings)
+{
+  OCIO_ConstCPUProcessorRcPtr *cpu_processor = cm_processor->cpu_processor;
+  if (cpu_processor == nullptr || OCIO_cpuProcessorIsNoOp(cpu_processor)) {
+    return;
+  }
+
+  char key[1024];
+  SNPRINTF(key,
+           "%s|%s|%s|%.9g|%.9g|%.9g|%.9g|%d",
+           view_settings->look,
+           view_settings->view_transform,
+           display_settings->display_device,
+           view_settings->exposure,
+           view_settings->gamma,
+           view_settings->temperature,
+           view_settings->tint,
+           (view_settings->flag & COLORMANAGE_VIEW_USE_WHITE_BALANCE) != 0);
+
+  std::lock_guard lock(display_lut_cache_mutex);
+
+  if (const std::shared_ptr<const ColorLut3D> *lut = display_lut_cache.lookup_ptr(key)) {
+    cm_processor->display_lut = *lut;
+    return;
+  }
+
+  if (display_lut_cache.size() >= DISPLAY_LUT_CACHE_MAX_ITEMS) {
+    display_lut_cache.clear();
+  }
+
+  auto evaluate = [&](blender::MutableSpan<blender::float3> colors) {
+    /* Isolate the tasks, the cache mutex is held while baking. */
+    blender::threading::isolate_task([&]() {
+      blender::threading::parallel_for(
+          colors.index_range(), 4096, [&](const blender::IndexRange range) {
+            blender::MutableSpan<blender::float3> chunk = colors.slice(range);
+            OCIO_PackedImageDesc *img = OCIO_createOCIO_PackedImageDesc(
+                reinterpret_cast<float *>(chunk.data()),
+                int(chunk.size()),
+                1,
+                3,
+                sizeof(float),
+                sizeof(blender::float3),
+                sizeof(blender::float3) * chunk.size());
+            OCIO_cpuProcessorApply(cpu_processor, img);
+            OCIO_PackedImageDescRelease(img);
+          });
+    });
+  };
+
+  cm_processor->display_lut = std::make_shared<const ColorLut3D>(evaluate);
+  display_lut_cache.add_new(key, cm_processor->display_lut);
+}
+
 static void colormanage_display_buffer_process_ex(
     ImBuf *ibuf,
     float *display_buffer,
@@ -1919,6 +1997,11 @@ static void colormanage_display_buffer_process_ex(
 
   if (skip_transform == false) {
     cm_processor = IMB_colormanagement_display_processor_new(view_settings, display_settings);
+
+    /* The lookup table is only accurate enough when the result is quantized to bytes. */
+    if (display_buffer == nullptr && USER_EXPERIMENTAL_TEST(&U, use_display_transform_lut)) {
+      display_processor_lut_ensure(cm_processor, view_settings, display_settings);
+    }
   }
 
   display_buffer_apply_threaded(ibuf,
@@ -4013,7 +4096,7 @@ ColormanageProcessor *IMB_colormanagement_display_processor_new(
   const ColorManagedViewSettings *applied_view_settings;
   ColorSpace *display_space;
 
-  cm_processor = MEM_cnew<ColormanageProcessor>("colormanagement processor");
+  cm_processor = MEM_new<ColormanageProcessor>("colormanagement processor");
 
   if (view_settings) {
     applied_view_settings = view_settings;
@@ -4053,7 +4136,7 @@ ColormanageProcessor *IMB_colormanagement_colorspace_processor_new(const char *f
 {
   ColormanageProcessor *cm_processor;
 
-  cm_processor = MEM_cnew<ColormanageProcessor>("colormanagement processor");
+  cm_processor = MEM_new<ColormanageProcessor>("colormanagement processor");
   cm_processor->is_data_result = IMB_colormanagement_space_name_is_data(to_colorspace);
 
   OCIO_ConstProcessorRcPtr *processor = create_colorspace_transform_processor(from_colorspace,
@@ -4146,6 +4229,32 @@ void IMB_colormanagement_processor_apply_pixel(ColormanageProcessor *cm_processo
   }
 }
 
+static void cpu_processor_apply(OCIO_ConstCPUProcessorRcPtr *cpu_processor,
+                                float *buffer,
+                                const int width,
+                                const int height,
+                                const int channels,
+                                const bool predivide)
+{
+  OCIO_PackedImageDesc *img = OCIO_createOCIO_PackedImageDesc(
+      buffer,
+      width,
+      height,
+      channels,
+      sizeof(float),
+      size_t(channels) * sizeof(float),
+      size_t(channels) * sizeof(float) * width);
+
+  if (predivide) {
+    OCIO_cpuProcessorApply_predivide(cpu_processor, img);
+  }
+  else {
+    OCIO_cpuProcessorApply(cpu_processor, img);
+  }
+
+  OCIO_PackedImageDescRelease(img);
+}
+
 void IMB_colormanagement_processor_apply(ColormanageProcessor *cm_processor,
                                          float *buffer,
                                          int width,
@@ -4166,26 +4275,24 @@ void IMB_colormanagement_processor_apply(ColormanageProcessor *cm_processor,
     }
   }
 
-  if (cm_processor->cpu_processor && channels >= 3) {
-    OCIO_PackedImageDesc *img;
-
-    /* apply OCIO processor */
-    img = OCIO_createOCIO_PackedImageDesc(buffer,
-                                          width,
-                                          height,
-                                          channels,
-                                          sizeof(float),
-                                          size_t(channels) * sizeof(float),
-                                          size_t(channels) * sizeof(float) * width);
-
-    if (predivide) {
-      OCIO_cpuProcessorApply_predivide(cm_processor->cpu_processor, img);
-    }
-    else {
-      OCIO_cpuProcessorApply(cm_processor->cpu_processor, img);
-    }
-
-    OCIO_PackedImageDescRelease(img);
+  if (cm_processor->display_lut && channels >= 3) {
+    /* Colors outside of the range of the table use the exact transform. */
+    cm_processor->display_lut->apply(
+        buffer,
+        int64_t(width) * height,
+        channels,
+        predivide,
+        [&](float *fallback_buffer, const int64_t fallback_pixels_num) {
+          cpu_processor_apply(cm_processor->cpu_processor,
+                              fallback_buffer,
+                              int(fallback_pixels_num),
+                              1,
+                              channels,
+                              predivide);
+        });
+  }
+  else if (cm_processor->cpu_processor && channels >= 3) {
+    cpu_processor_apply(cm_processor->cpu_processor, buffer, width, height, channels, predivide);
   }
 }
 
@@ -4216,7 +4323,7 @@ void IMB_colormanagement_processor_free(ColormanageProcessor *cm_processor)
     OCIO_cpuProcessorRelease(cm_processor->cpu_processor);
   }
 
-  MEM_freeN(cm_processor);
+  MEM_delete(cm_processor);
 }
 
 /* **** OpenGL drawing routines using GLSL for color space transform ***** */
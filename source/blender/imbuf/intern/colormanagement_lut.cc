@@ -0,0 +1,155 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup imbuf
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "BLI_assert.h"
+#include "BLI_index_range.hh"
+#include "BLI_utildefines.h"
+
+#include "colormanagement_lut.hh"
+
+namespace blender::imbuf {
+
+/* Slope of the shaper around zero. Values below `1 / shaper_scale` are spaced almost linearly,
+ * larger values logarithmically. */
+static constexpr float shaper_scale = 1024.0f;
+
+float ColorLut3D::shaper(const float value)
+{
+  /* Written so that NaN maps to zero. */
+  const float clamped = (value > 0.0f) ? std::min(value, max_value) : 0.0f;
+  return std::log2(1.0f + shaper_scale * clamped) / std::log2(1.0f + shaper_scale * max_value);
+}
+
+float ColorLut3D::shaper_inverse(const float value)
+{
+  return (std::exp2(value * std::log2(1.0f + shaper_scale * max_value)) - 1.0f) / shaper_scale;
+}
+
+ColorLut3D::ColorLut3D(FunctionRef<void(MutableSpan<float3> colors)> evaluate)
+    : table_(resolution * resolution * resolution)
+{
+  Array<float> axis(resolution);
+  for (const int i : axis.index_range()) {
+    axis[i] = shaper_inverse(float(i) / (resolution - 1));
+  }
+
+  int64_t index = 0;
+  for (const int z : IndexRange(resolution)) {
+    for (const int y : IndexRange(resolution)) {
+      for (const int x : IndexRange(resolution)) {
+        table_[index++] = float3(axis[x], axis[y], axis[z]);
+      }
+    }
+  }
+
+  evaluate(table_);
+}
+
+bool ColorLut3D::contains(const float3 &color)
+{
+  /* Written so that NaN is not contained. */
+  return color.x >= 0.0f && color.y >= 0.0f && color.z >= 0.0f && color.x <= max_value &&
+         color.y <= max_value && color.z <= max_value;
+}
+
+float3 ColorLut3D::evaluate(const float3 &color) const
+{
+  const float scale = float(resolution - 1);
+  const float px = shaper(color.x) * scale;
+  const float py = shaper(color.y) * scale;
+  const float pz = shaper(color.z) * scale;
+
+  const int x = std::min(int(px), resolution - 2);
+  const int y = std::min(int(py), resolution - 2);
+  const int z = std::min(int(pz), resolution - 2);
+
+  const float fx = px - x;
+  const float fy = py - y;
+  const float fz = pz - z;
+
+  /* Offsets of neighbor grid points along each axis. */
+  const int64_t dx = 1;
+  const int64_t dy = resolution;
+  const int64_t dz = int64_t(resolution) * resolution;
+  const float3 *c000 = &table_[z * dz + y * dy + x];
+  const float3 &c111 = c000[dx + dy + dz];
+
+  /* Tetrahedral interpolation, only four of the eight surrounding grid points are used. */
+  if (fx > fy) {
+    if (fy > fz) {
+      return *c000 + fx * (c000[dx] - *c000) + fy * (c000[dx + dy] - c000[dx]) +
+             fz * (c111 - c000[dx + dy]);
+    }
+    if (fx > fz) {
+      return *c000 + fx * (c000[dx] - *c000) + fz * (c000[dx + dz] - c000[dx]) +
+             fy * (c111 - c000[dx + dz]);
+    }
+    return *c000 + fz * (c000[dz] - *c000) + fx * (c000[dx + dz] - c000[dz]) +
+           fy * (c111 - c000[dx + dz]);
+  }
+  if (fz > fy) {
+    return *c000 + fz * (c000[dz] - *c000) + fy * (c000[dy + dz] - c000[dz]) +
+           fx * (c111 - c000[dy + dz]);
+  }
+  if (fz > fx) {
+    return *c000 + fy * (c000[dy] - *c000) + fz * (c000[dy + dz] - c000[dy]) +
+           fx * (c111 - c000[dy + dz]);
+  }
+  return *c000 + fy * (c000[dy] - *c000) + fx * (c000[dx + dy] - c000[dy]) +
+         fz * (c111 - c000[dx + dy]);
+}
+
+void ColorLut3D::apply(float *buffer,
+                       const int64_t pixels_num,
+                       const int channels,
+                       const bool predivide,
+                       FunctionRef<void(float *buffer, int64_t pixels_num)> fallback) const
+{
+  BLI_assert(ELEM(channels, 3, 4));
+
+  /* First pixel of the current run of pixels the table doesn't contain. */
+  float *fallback_start = nullptr;
+
+  float *pixel_end = buffer + pixels_num * channels;
+  for (float *pixel = buffer; pixel != pixel_end; pixel += channels) {
+    const float alpha = (channels == 4) ? pixel[3] : 1.0f;
+    const bool use_predivide = predivide && alpha != 0.0f && alpha != 1.0f;
+    float3 color = float3(pixel);
+    if (use_predivide) {
+      color /= alpha;
+    }
+
+    if (!contains(color)) {
+      if (fallback_start == nullptr) {
+        fallback_start = pixel;
+      }
+      continue;
+    }
+    if (fallback_start != nullptr) {
+      fallback(fallback_start, (pixel - fallback_start) / channels);
+      fallback_start = nullptr;
+    }
+
+    color = evaluate(color);
+    if (use_predivide) {
+      color *= alpha;
+    }
+    pixel[0] = color.x;
+    pixel[1] = color.y;
+    pixel[2] = color.z;
+  }
+
+  if (fallback_start != nullptr) {
+    fallback(fallback_start, (pixel_end - fallback_start) / channels);
+  }
+}
+
+}  // namespace blender::imbuf
@@ -0,0 +1,72 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup imbuf
+ *
+ * Baked 3D lookup table, used as a faster approximation of display transforms on the CPU.
+ */
+
+#pragma once
+
+#include "BLI_array.hh"
+#include "BLI_function_ref.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
+
+namespace blender::imbuf {
+
+/**
+ * 3D lookup table of a color transform, sampled on a log shaped grid so that scene linear values
+ * up to #ColorLut3D::max_value are covered with more samples in the dark range.
+ * Values are looked up with tetrahedral interpolation.
+ *
+ * The table is only accurate for transforms which output display referred values, where the
+ * result is clamped to the [0, 1] range anyway. Colors outside of the table range (see #contains)
+ * must be transformed with the exact transform instead.
+ */
+class ColorLut3D {
+ public:
+  /** Number of samples along each axis. */
+  static constexpr int resolution = 65;
+  /** Largest input value covered by the table, larger values are clamped. */
+  static constexpr float max_value = 64.0f;
+
+ private:
+  Array<float3> table_;
+
+ public:
+  /**
+   * Bake the table. The `evaluate` function is called with colors of all grid points, and is
+   * expected to transform them in place.
+   */
+  ColorLut3D(FunctionRef<void(MutableSpan<float3> colors)> evaluate);
+
+  /** Whether all components of the color are in the [0, #max_value] range covered by the table. */
+  static bool contains(const float3 &color);
+
+  /** Transform a single color, components outside of the table range are clamped. */
+  float3 evaluate(const float3 &color) const;
+
+  /**
+   * Transform RGB of a buffer of pixels with the given number of channels (3 or 4) in place.
+   * With `predivide`, colors are un-premultiplied by alpha before the lookup.
+   *
+   * Runs of consecutive pixels that the table doesn't contain (negative values in wide gamut
+   * footage, very bright highlights or NaN) are left untouched and passed to `fallback`, which
+   * is expected to transform them with the exact transform.
+   */
+  void apply(float *buffer,
+             int64_t pixels_num,
+             int channels,
+             bool predivide,
+             FunctionRef<void(float *buffer, int64_t pixels_num)> fallback) const;
+
+  /** Map a scene linear value to the [0, 1] range of the table axis. */
+  static float shaper(float value);
+  /** Inverse of #shaper. */
+  static float shaper_inverse(float value);
+};
+
+}  // namespace blender::imbuf
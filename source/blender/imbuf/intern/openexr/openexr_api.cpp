@@ -722,6 +722,7 @@ struct ExrChannel {
   char chan_id;                   /* quick lookup of channel char */
   int view_id;                    /* quick lookup of channel view */
   bool use_half_float;            /* when saving use half float for file storage */
+  int pass_offset;                /* offset of the channel in the pixels of its pass */
 };
 
 /* hierarchical; layers -> passes -> channels[] */
@@ -736,6 +737,7 @@ struct ExrPass {
   char internal_name[EXR_PASS_MAXNAME]; /* name with no view */
   char view[EXR_VIEW_MAXNAME];
   int view_id;
+  bool is_rect_external; /* rect is owned by the caller, see IMB_exr_pass_assign_rect */
 };
 
 struct ExrLayer {
@@ -1282,9 +1284,24 @@ void IMB_exrtile_write_channels(
   }
 }
 
-void IMB_exr_read_channels(void *handle)
+/* Set the buffer of the given pass, assigning the channels of the pass to their offsets in the
+ * interleaved pixels of the buffer. A null buffer unassigns the channels, such that they are not
+ * read. */
+static void imb_exr_pass_set_rect(const ExrHandle *data, ExrPass *pass, float *rect)
+{
+  pass->rect = rect;
+  for (int a = 0; a < pass->totchan; a++) {
+    ExrChannel *echan = pass->chan[a];
+    echan->rect = rect ? rect + echan->pass_offset : nullptr;
+    echan->xstride = pass->totchan;
+    echan->ystride = data->width * pass->totchan;
+  }
+}
+
+/* Read the pixels of all channels that have a buffer assigned, skipping the parts that have none,
+ * which avoids decoding them altogether for multi-part files. */
+static void imb_exr_read_assigned_channels(ExrHandle *data)
 {
-  ExrHandle *data = (ExrHandle *)handle;
   int numparts = data->ifile->parts();
 
   /* Check if EXR was saved with previous versions of blender which flipped images. */
@@ -1310,6 +1327,7 @@ void IMB_exr_read_channels(void *handle)
 
     /* Insert all matching channel into frame-buffer. */
     FrameBuffer frameBuffer;
+    bool has_channels = false;
 
     LISTBASE_FOREACH (ExrChannel *, echan, &data->channels) {
       if (echan->m->part_number != i) {
@@ -1341,9 +1359,14 @@ void IMB_exr_read_channels(void *handle)
 
         frameBuffer.insert(echan->m->internal_name,
                            Slice(Imf::FLOAT, (char *)rect, xstride, ystride));
+        has_channels = true;
       }
     }
 
+    if (!has_channels) {
+      continue;
+    }
+
     /* Read pixels. */
     try {
       in.setFrameBuffer(frameBuffer);
@@ -1361,6 +1384,77 @@ void IMB_exr_read_channels(void *handle)
   }
 }
 
+void IMB_exr_read_channels(void *handle)
+{
+  ExrHandle *data = (ExrHandle *)handle;
+
+  /* The pass buffers are only allocated when reading, since a multilayer file might be parsed
+   * without reading its pixels, see IMB_exr_read_assigned_passes. */
+  LISTBASE_FOREACH (ExrLayer *, lay, &data->layers) {
+    LISTBASE_FOREACH (ExrPass *, pass, &lay->passes) {
+      if (pass->totchan && !pass->rect) {
+        imb_exr_pass_set_rect(
+            data,
+            pass,
+            (float *)MEM_callocN(data->width * data->height * pass->totchan * sizeof(float),
+                                 "pass rect"));
+      }
+    }
+  }
+
+  imb_exr_read_assigned_channels(data);
+}
+
+bool IMB_exr_pass_assign_rect(void *handle,
+                              const char *layname,
+                              const char *passname,
+                              const char *viewname,
+                              int totchan,
+                              float *rect)
+{
+  ExrHandle *data = (ExrHandle *)handle;
+
+  ExrLayer *lay = (ExrLayer *)BLI_findstring(&data->layers, layname, offsetof(ExrLayer, name));
+  if (!lay) {
+    return false;
+  }
+
+  ExrPass *pass = nullptr;
+  LISTBASE_FOREACH (ExrPass *, iter_pass, &lay->passes) {
+    if (STREQ(iter_pass->internal_name, passname) && STREQ(iter_pass->view, viewname)) {
+      pass = iter_pass;
+      break;
+    }
+  }
+  if (!pass || pass->totchan != totchan || pass->rect) {
+    return false;
+  }
+
+  imb_exr_pass_set_rect(data, pass, rect);
+  pass->is_rect_external = true;
+
+  return true;
+}
+
+void IMB_exr_read_assigned_passes(void *handle)
+{
+  ExrHandle *data = (ExrHandle *)handle;
+
+  /* Only the channels of the assigned passes are read, such that the channels of other passes are
+   * neither allocated nor converted. All passes are read at once, such that each part of the file
+   * is decoded at most once. */
+  imb_exr_read_assigned_channels(data);
+
+  LISTBASE_FOREACH (ExrLayer *, lay, &data->layers) {
+    LISTBASE_FOREACH (ExrPass *, pass, &lay->passes) {
+      if (pass->is_rect_external) {
+        imb_exr_pass_set_rect(data, pass, nullptr);
+        pass->is_rect_external = false;
+      }
+    }
+  }
+}
+
 void IMB_exr_multilayer_convert(void *handle,
                                 void *base,
                                 void *(*addview)(void *base, const char *str),
@@ -1432,7 +1526,7 @@ void IMB_exr_close(void *handle)
 
   LISTBASE_FOREACH (ExrLayer *, lay, &data->layers) {
     LISTBASE_FOREACH (ExrPass *, pass, &lay->passes) {
-      if (pass->rect) {
+      if (pass->rect && !pass->is_rect_external) {
         MEM_freeN(pass->rect);
       }
     }
@@ -1764,17 +1858,14 @@ static bool imb_exr_multilayer_parse_channels_from_file(ExrHandle *data)
     return false;
   }
 
-  /* with some heuristics, try to merge the channels in buffers */
+  /* With some heuristics, try to merge the channels in buffers. The buffers themselves are only
+   * allocated when the channels are read. */
   LISTBASE_FOREACH (ExrLayer *, lay, &data->layers) {
     LISTBASE_FOREACH (ExrPass *, pass, &lay->passes) {
       if (pass->totchan) {
-        pass->rect = (float *)MEM_callocN(
-            data->width * data->height * pass->totchan * sizeof(float), "pass rect");
         if (pass->totchan == 1) {
           ExrChannel *echan = pass->chan[0];
-          echan->rect = pass->rect;
-          echan->xstride = 1;
-          echan->ystride = data->width;
+          echan->pass_offset = 0;
           pass->chan_id[0] = echan->chan_id;
         }
         else {
@@ -1807,18 +1898,14 @@ static bool imb_exr_multilayer_parse_channels_from_file(ExrHandle *data)
             }
             for (int a = 0; a < pass->totchan; a++) {
               echan = pass->chan[a];
-              echan->rect = pass->rect + lookup[uint(echan->chan_id)];
-              echan->xstride = pass->totchan;
-              echan->ystride = data->width * pass->totchan;
+              echan->pass_offset = lookup[uint(echan->chan_id)];
               pass->chan_id[uint(lookup[uint(echan->chan_id)])] = echan->chan_id;
             }
           }
           else { /* unknown */
             for (int a = 0; a < pass->totchan; a++) {
               ExrChannel *echan = pass->chan[a];
-              echan->rect = pass->rect + a;
-              echan->xstride = pass->totchan;
-              echan->ystride = data->width * pass->totchan;
+              echan->pass_offset = a;
               pass->chan_id[a] = echan->chan_id;
             }
           }
@@ -1830,7 +1917,7 @@ static bool imb_exr_multilayer_parse_channels_from_file(ExrHandle *data)
   return true;
 }
 
-/* creates channels, makes a hierarchy and assigns memory to channels */
+/* creates channels, makes a hierarchy and assigns offsets to channels */
 static ExrHandle *imb_exr_begin_read_mem(IStream &file_stream,
                                          MultiPartInputFile &file,
                                          int width,
@@ -2170,10 +2257,13 @@ ImBuf *imb_load_openexr(const uchar *mem, size_t size, int flags, char colorspac
 
         /* Only enters with IB_multilayer flag set. */
         if (is_multi && ((flags & IB_thumbnail) == 0)) {
-          /* constructs channels for reading, allocates memory in channels */
+          /* constructs channels for reading */
           ExrHandle *handle = imb_exr_begin_read_mem(*membuf, *file, width, height);
           if (handle) {
-            IMB_exr_read_channels(handle);
+            /* With IB_multilayer_lazy, the caller reads the passes it needs later on. */
+            if ((flags & IB_multilayer_lazy) == 0) {
+              IMB_exr_read_channels(handle);
+            }
             ibuf->userdata = handle; /* potential danger, the caller has to check for this! */
           }
         }
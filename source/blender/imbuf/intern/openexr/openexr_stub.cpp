@@ -73,6 +73,16 @@ float *IMB_exr_channel_rect(void * /*handle*/,
 }
 
 void IMB_exr_read_channels(void * /*handle*/) {}
+bool IMB_exr_pass_assign_rect(void * /*handle*/,
+                              const char * /*layname*/,
+                              const char * /*passname*/,
+                              const char * /*viewname*/,
+                              int /*totchan*/,
+                              float * /*rect*/)
+{
+  return false;
+}
+void IMB_exr_read_assigned_passes(void * /*handle*/) {}
 void IMB_exr_write_channels(void * /*handle*/) {}
 void IMB_exrtile_write_channels(void * /*handle*/,
                                 int /*partx*/,
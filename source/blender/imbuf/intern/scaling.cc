@@ -7,6 +7,11 @@
  * \ingroup imbuf
  */
 
+#include <type_traits>
+
+#include "BLI_array.hh"
+#include "BLI_math_base.hh"
+#include "BLI_math_constants.h"
 #include "BLI_math_vector.hh"
 #include "BLI_task.hh"
 #include "BLI_utildefines.h"
@@ -405,14 +410,13 @@ static inline void store_pixel(float4 pix, float4 *ptr)
 
 struct ScaleDownX {
   template<typename T>
-  static void op(const T *src, T *dst, int ibufx, int ibufy, int newx, int /*newy*/, bool threaded)
+  static void op(const T *src, T *dst, int ibufx, int ibufy, int newx, int /*newy*/)
   {
     using namespace blender;
     const float add = (ibufx - 0.01f) / newx;
     const float inv_add = 1.0f / add;
 
-    const int grain_size = threaded ? 32 : ibufy;
-    threading::parallel_for(IndexRange(ibufy), grain_size, [&](IndexRange range) {
+    threading::parallel_for(IndexRange(ibufy), 32, [&](IndexRange range) {
       for (const int y : range) {
         const T *src_ptr = src + y * ibufx;
         T *dst_ptr = dst + y * newx;
@@ -444,14 +448,13 @@ struct ScaleDownX {
 
 struct ScaleDownY {
   template<typename T>
-  static void op(const T *src, T *dst, int ibufx, int ibufy, int /*newx*/, int newy, bool threaded)
+  static void op(const T *src, T *dst, int ibufx, int ibufy, int /*newx*/, int newy)
   {
     using namespace blender;
     const float add = (ibufy - 0.01f) / newy;
     const float inv_add = 1.0f / add;
 
-    const int grain_size = threaded ? 32 : ibufx;
-    threading::parallel_for(IndexRange(ibufx), grain_size, [&](IndexRange range) {
+    threading::parallel_for(IndexRange(ibufx), 32, [&](IndexRange range) {
       for (const int x : range) {
         const T *src_ptr = src + x;
         T *dst_ptr = dst + x;
@@ -483,7 +486,7 @@ struct ScaleDownY {
 
 struct ScaleUpX {
   template<typename T>
-  static void op(const T *src, T *dst, int ibufx, int ibufy, int newx, int /*newy*/, bool threaded)
+  static void op(const T *src, T *dst, int ibufx, int ibufy, int newx, int /*newy*/)
   {
     using namespace blender;
     const float add = (ibufx - 0.001f) / newx;
@@ -498,8 +501,7 @@ struct ScaleUpX {
       }
     }
     else {
-      const int grain_size = threaded ? 32 : ibufy;
-      threading::parallel_for(IndexRange(ibufy), grain_size, [&](IndexRange range) {
+      threading::parallel_for(IndexRange(ibufy), 32, [&](IndexRange range) {
         for (const int y : range) {
           float sample = -0.5f + add * 0.5f;
           int counter = 0;
@@ -536,7 +538,7 @@ struct ScaleUpX {
 
 struct ScaleUpY {
   template<typename T>
-  static void op(const T *src, T *dst, int ibufx, int ibufy, int /*newx*/, int newy, bool threaded)
+  static void op(const T *src, T *dst, int ibufx, int ibufy, int /*newx*/, int newy)
   {
     using namespace blender;
     const float add = (ibufy - 0.001f) / newy;
@@ -548,8 +550,7 @@ struct ScaleUpY {
       }
     }
     else {
-      const int grain_size = threaded ? 32 : ibufx;
-      threading::parallel_for(IndexRange(ibufx), grain_size, [&](IndexRange range) {
+      threading::parallel_for(IndexRange(ibufx), 32, [&](IndexRange range) {
         for (const int x : range) {
           float sample = -0.5f + add * 0.5f;
           int counter = 0;
@@ -587,69 +588,68 @@ struct ScaleUpY {
 };
 
 template<typename T>
-static void instantiate_pixel_op(T & /*op*/,
-                                 const ImBuf *ibuf,
-                                 int newx,
-                                 int newy,
-                                 uchar4 *dst_byte,
-                                 float *dst_float,
-                                 bool threaded)
+static void instantiate_pixel_op(
+    T & /*op*/, const ImBuf *ibuf, int newx, int newy, uchar4 *dst_byte, float *dst_float)
 {
-  if (dst_byte != nullptr) {
-    const uchar4 *src = (const uchar4 *)ibuf->byte_buffer.data;
-    T::op(src, dst_byte, ibuf->x, ibuf->y, newx, newy, threaded);
-  }
-  if (dst_float != nullptr) {
-    if (ibuf->channels == 1) {
-      T::op(ibuf->float_buffer.data, dst_float, ibuf->x, ibuf->y, newx, newy, threaded);
-    }
-    else if (ibuf->channels == 2) {
-      const float2 *src = (const float2 *)ibuf->float_buffer.data;
-      T::op(src, (float2 *)dst_float, ibuf->x, ibuf->y, newx, newy, threaded);
-    }
-    else if (ibuf->channels == 3) {
-      const float3 *src = (const float3 *)ibuf->float_buffer.data;
-      T::op(src, (float3 *)dst_float, ibuf->x, ibuf->y, newx, newy, threaded);
+  /* Always multi-threaded. Callers might hold locks while scaling, so do not let waiting threads
+   * steal unrelated tasks that could try to acquire them. */
+  blender::threading::isolate_task([&]() {
+    if (dst_byte != nullptr) {
+      const uchar4 *src = (const uchar4 *)ibuf->byte_buffer.data;
+      T::op(src, dst_byte, ibuf->x, ibuf->y, newx, newy);
     }
-    else if (ibuf->channels == 4) {
-      const float4 *src = (const float4 *)ibuf->float_buffer.data;
-      T::op(src, (float4 *)dst_float, ibuf->x, ibuf->y, newx, newy, threaded);
+    if (dst_float != nullptr) {
+      if (ibuf->channels == 1) {
+        T::op(ibuf->float_buffer.data, dst_float, ibuf->x, ibuf->y, newx, newy);
+      }
+      else if (ibuf->channels == 2) {
+        const float2 *src = (const float2 *)ibuf->float_buffer.data;
+        T::op(src, (float2 *)dst_float, ibuf->x, ibuf->y, newx, newy);
+      }
+      else if (ibuf->channels == 3) {
+        const float3 *src = (const float3 *)ibuf->float_buffer.data;
+        T::op(src, (float3 *)dst_float, ibuf->x, ibuf->y, newx, newy);
+      }
+      else if (ibuf->channels == 4) {
+        const float4 *src = (const float4 *)ibuf->float_buffer.data;
+        T::op(src, (float4 *)dst_float, ibuf->x, ibuf->y, newx, newy);
+      }
     }
-  }
+  });
 }
 
 static void scale_down_x_func(
-    const ImBuf *ibuf, int newx, int newy, uchar4 *dst_byte, float *dst_float, bool threaded)
+    const ImBuf *ibuf, int newx, int newy, uchar4 *dst_byte, float *dst_float)
 {
   ScaleDownX op;
-  instantiate_pixel_op(op, ibuf, newx, newy, dst_byte, dst_float, threaded);
+  instantiate_pixel_op(op, ibuf, newx, newy, dst_byte, dst_float);
 }
 
 static void scale_down_y_func(
-    const ImBuf *ibuf, int newx, int newy, uchar4 *dst_byte, float *dst_float, bool threaded)
+    const ImBuf *ibuf, int newx, int newy, uchar4 *dst_byte, float *dst_float)
 {
   ScaleDownY op;
-  instantiate_pixel_op(op, ibuf, newx, newy, dst_byte, dst_float, threaded);
+  instantiate_pixel_op(op, ibuf, newx, newy, dst_byte, dst_float);
 }
 
 static void scale_up_x_func(
-    const ImBuf *ibuf, int newx, int newy, uchar4 *dst_byte, float *dst_float, bool threaded)
+    const ImBuf *ibuf, int newx, int newy, uchar4 *dst_byte, float *dst_float)
 {
   ScaleUpX op;
-  instantiate_pixel_op(op, ibuf, newx, newy, dst_byte, dst_float, threaded);
+  instantiate_pixel_op(op, ibuf, newx, newy, dst_byte, dst_float);
 }
 
 static void scale_up_y_func(
-    const ImBuf *ibuf, int newx, int newy, uchar4 *dst_byte, float *dst_float, bool threaded)
+    const ImBuf *ibuf, int newx, int newy, uchar4 *dst_byte, float *dst_float)
 {
   ScaleUpY op;
-  instantiate_pixel_op(op, ibuf, newx, newy, dst_byte, dst_float, threaded);
+  instantiate_pixel_op(op, ibuf, newx, newy, dst_byte, dst_float);
 }
 
-using ScaleFunction = void (*)(
-    const ImBuf *ibuf, int newx, int newy, uchar4 *dst_byte, float *dst_float, bool threaded);
+using ScaleFunction =
+    void (*)(const ImBuf *ibuf, int newx, int newy, uchar4 *dst_byte, float *dst_float);
 
-static void scale_with_function(ImBuf *ibuf, int newx, int newy, ScaleFunction func, bool threaded)
+static void scale_with_function(ImBuf *ibuf, int newx, int newy, ScaleFunction func)
 {
   /* Allocate destination buffers. */
   uchar4 *dst_byte = nullptr;
@@ -660,7 +660,7 @@ static void scale_with_function(ImBuf *ibuf, int newx, int newy, ScaleFunction f
   }
 
   /* Do actual processing. */
-  func(ibuf, newx, newy, dst_byte, dst_float, threaded);
+  func(ibuf, newx, newy, dst_byte, dst_float);
 
   /* Modify image to point to new destination. */
   if (dst_byte != nullptr) {
@@ -675,19 +675,19 @@ static void scale_with_function(ImBuf *ibuf, int newx, int newy, ScaleFunction f
   ibuf->y = newy;
 }
 
-static void imb_scale_box(ImBuf *ibuf, uint newx, uint newy, bool threaded)
+static void imb_scale_box(ImBuf *ibuf, uint newx, uint newy)
 {
   if (newx != 0 && (newx < ibuf->x)) {
-    scale_with_function(ibuf, newx, ibuf->y, scale_down_x_func, threaded);
+    scale_with_function(ibuf, newx, ibuf->y, scale_down_x_func);
   }
   if (newy != 0 && (newy < ibuf->y)) {
-    scale_with_function(ibuf, ibuf->x, newy, scale_down_y_func, threaded);
+    scale_with_function(ibuf, ibuf->x, newy, scale_down_y_func);
   }
   if (newx != 0 && (newx > ibuf->x)) {
-    scale_with_function(ibuf, newx, ibuf->y, scale_up_x_func, threaded);
+    scale_with_function(ibuf, newx, ibuf->y, scale_up_x_func);
   }
   if (newy != 0 && (newy > ibuf->y)) {
-    scale_with_function(ibuf, ibuf->x, newy, scale_up_y_func, threaded);
+    scale_with_function(ibuf, ibuf->x, newy, scale_up_y_func);
   }
 }
 
@@ -714,68 +714,317 @@ static void scale_nearest(
 }
 
 static void scale_nearest_func(
-    const ImBuf *ibuf, int newx, int newy, uchar4 *dst_byte, float *dst_float, bool threaded)
+    const ImBuf *ibuf, int newx, int newy, uchar4 *dst_byte, float *dst_float)
 {
   using namespace blender;
 
-  const int grain_size = threaded ? 64 : newy;
-  threading::parallel_for(IndexRange(newy), grain_size, [&](IndexRange y_range) {
-    /* Byte pixels. */
+  /* Always multi-threaded, see instantiate_pixel_op. */
+  threading::isolate_task([&]() {
+    threading::parallel_for(IndexRange(newy), 64, [&](IndexRange y_range) {
+      /* Byte pixels. */
+      if (dst_byte != nullptr) {
+        const uchar4 *src = (const uchar4 *)ibuf->byte_buffer.data;
+        scale_nearest(src, dst_byte, ibuf->x, ibuf->y, newx, newy, y_range);
+      }
+      /* Float pixels. */
+      if (dst_float != nullptr) {
+        if (ibuf->channels == 1) {
+          scale_nearest(
+              ibuf->float_buffer.data, dst_float, ibuf->x, ibuf->y, newx, newy, y_range);
+        }
+        else if (ibuf->channels == 2) {
+          const float2 *src = (const float2 *)ibuf->float_buffer.data;
+          scale_nearest(src, (float2 *)dst_float, ibuf->x, ibuf->y, newx, newy, y_range);
+        }
+        else if (ibuf->channels == 3) {
+          const float3 *src = (const float3 *)ibuf->float_buffer.data;
+          scale_nearest(src, (float3 *)dst_float, ibuf->x, ibuf->y, newx, newy, y_range);
+        }
+        else if (ibuf->channels == 4) {
+          const float4 *src = (const float4 *)ibuf->float_buffer.data;
+          scale_nearest(src, (float4 *)dst_float, ibuf->x, ibuf->y, newx, newy, y_range);
+        }
+      }
+    });
+  });
+}
+
+static void scale_bilinear_func(
+    const ImBuf *ibuf, int newx, int newy, uchar4 *dst_byte, float *dst_float)
+{
+  using namespace blender;
+  using namespace blender::imbuf;
+
+  /* Always multi-threaded, see instantiate_pixel_op. */
+  threading::isolate_task([&]() {
+    threading::parallel_for(IndexRange(newy), 32, [&](IndexRange y_range) {
+      float factor_x = float(ibuf->x) / newx;
+      float factor_y = float(ibuf->y) / newy;
+
+      for (const int y : y_range) {
+        float v = (float(y) + 0.5f) * factor_y - 0.5f;
+        for (int x = 0; x < newx; x++) {
+          float u = (float(x) + 0.5f) * factor_x - 0.5f;
+          int64_t offset = int64_t(y) * newx + x;
+          if (dst_byte) {
+            interpolate_bilinear_byte(ibuf, (uchar *)(dst_byte + offset), u, v);
+          }
+          if (dst_float) {
+            float *pixel = dst_float + ibuf->channels * offset;
+            math::interpolate_bilinear_fl(
+                ibuf->float_buffer.data, pixel, ibuf->x, ibuf->y, ibuf->channels, u, v);
+          }
+        }
+      }
+    });
+  });
+}
+
+/* -------------------------------------------------------------------- */
+/** \name Separable Filtered Scaling
+ *
+ * Mitchell and Lanczos scaling is done in two passes, one along each axis. The filter weights of
+ * every output row and column are computed once up front, and the passes loop over contiguous
+ * rows of pixels such that the compiler can vectorize the weighted sums.
+ * \{ */
+
+namespace blender::imbuf {
+
+static float mitchell_kernel(float x)
+{
+  /* Mitchell-Netravali filter with B=1/3, C=1/3 parameters. */
+  x = math::abs(x);
+  if (x < 1.0f) {
+    return (7.0f * x * x * x - 12.0f * x * x + 16.0f / 3.0f) / 6.0f;
+  }
+  if (x < 2.0f) {
+    return (-7.0f / 3.0f * x * x * x + 12.0f * x * x - 20.0f * x + 32.0f / 3.0f) / 6.0f;
+  }
+  return 0.0f;
+}
+
+static float lanczos3_kernel(float x)
+{
+  x = math::abs(x);
+  if (x < 1e-6f) {
+    return 1.0f;
+  }
+  if (x >= 3.0f) {
+    return 0.0f;
+  }
+  const float pi_x = float(M_PI) * x;
+  return 3.0f * math::sin(pi_x) * math::sin(pi_x / 3.0f) / (pi_x * pi_x);
+}
+
+/** Filter weights of the source pixels that contribute to each pixel along one axis. */
+struct FilterWeights {
+  /** First source pixel and number of source pixels that contribute to each output pixel. */
+  Array<int> start;
+  Array<int> count;
+  /** Normalized weights of the contributing source pixels, #stride per output pixel. */
+  Array<float> weights;
+  int stride;
+};
+
+static FilterWeights compute_filter_weights(int src_size, int dst_size, IMBScaleFilter filter)
+{
+  const float radius = filter == IMBScaleFilter::Lanczos ? 3.0f : 2.0f;
+  const float scale = float(src_size) / dst_size;
+  /* When scaling down, widen the filter to cover all source pixels under an output pixel. */
+  const float filter_scale = math::max(scale, 1.0f);
+  const float support = radius * filter_scale;
+
+  FilterWeights result;
+  result.stride = int(math::ceil(support * 2.0f)) + 1;
+  result.start.reinitialize(dst_size);
+  result.count.reinitialize(dst_size);
+  result.weights = Array<float>(int64_t(dst_size) * result.stride, 0.0f);
+
+  threading::parallel_for(IndexRange(dst_size), 256, [&](IndexRange range) {
+    for (const int i : range) {
+      const float center = (i + 0.5f) * scale;
+      const int first = math::max(int(math::ceil(center - support - 0.5f)), 0);
+      const int last = math::min(int(math::floor(center + support - 0.5f)), src_size - 1);
+      const int count = math::clamp(last - first + 1, 1, result.stride);
+
+      float *weights = &result.weights[int64_t(i) * result.stride];
+      float sum = 0.0f;
+      for (int j = 0; j < count; j++) {
+        const float x = (first + j + 0.5f - center) / filter_scale;
+        weights[j] = filter == IMBScaleFilter::Lanczos ? lanczos3_kernel(x) : mitchell_kernel(x);
+        sum += weights[j];
+      }
+      if (sum != 0.0f) {
+        for (int j = 0; j < count; j++) {
+          weights[j] /= sum;
+        }
+      }
+      else {
+        weights[0] = 1.0f;
+      }
+      result.start[i] = math::min(first, src_size - 1);
+      result.count[i] = count;
+    }
+  });
+  return result;
+}
+
+template<typename T> static inline void store_filtered_pixel(float4 pix, T *ptr)
+{
+  /* Negative filter lobes can overshoot the range of byte pixels. */
+  if constexpr (std::is_same_v<T, uchar4>) {
+    pix = math::clamp(pix, 0.0f, 255.0f);
+  }
+  store_pixel(pix, ptr);
+}
+
+template<typename SrcT, typename DstT>
+static void filter_rows_x(
+    const SrcT *src, DstT *dst, int src_x, int size_y, const FilterWeights &weights_x)
+{
+  const int dst_x = weights_x.start.size();
+  threading::parallel_for(IndexRange(size_y), 32, [&](IndexRange range) {
+    for (const int y : range) {
+      const SrcT *src_row = src + int64_t(y) * src_x;
+      DstT *dst_row = dst + int64_t(y) * dst_x;
+      for (int x = 0; x < dst_x; x++) {
+        const SrcT *src_ptr = src_row + weights_x.start[x];
+        const float *weights = &weights_x.weights[int64_t(x) * weights_x.stride];
+        float4 pix(0.0f);
+        for (int i = 0; i < weights_x.count[x]; i++) {
+          pix += load_pixel(src_ptr + i) * weights[i];
+        }
+        store_filtered_pixel(pix, dst_row + x);
+      }
+    }
+  });
+}
+
+template<typename SrcT, typename DstT>
+static void filter_columns_y(const SrcT *src,
+                             DstT *dst,
+                             int size_x,
+                             const FilterWeights &weights_y)
+{
+  const int dst_y = weights_y.start.size();
+  threading::parallel_for(IndexRange(dst_y), 32, [&](IndexRange range) {
+    /* Accumulate whole source rows at once, which is contiguous in memory. */
+    Array<float4> row(size_x);
+    for (const int y : range) {
+      row.fill(float4(0.0f));
+      const float *weights = &weights_y.weights[int64_t(y) * weights_y.stride];
+      for (int i = 0; i < weights_y.count[y]; i++) {
+        const SrcT *src_row = src + int64_t(weights_y.start[y] + i) * size_x;
+        const float weight = weights[i];
+        for (int x = 0; x < size_x; x++) {
+          row[x] += load_pixel(src_row + x) * weight;
+        }
+      }
+      DstT *dst_row = dst + int64_t(y) * size_x;
+      for (int x = 0; x < size_x; x++) {
+        store_filtered_pixel(row[x], dst_row + x);
+      }
+    }
+  });
+}
+
+template<typename T>
+static void scale_separable(const T *src,
+                            T *dst,
+                            int ibufx,
+                            int ibufy,
+                            int newx,
+                            int newy,
+                            const FilterWeights &weights_x,
+                            const FilterWeights &weights_y)
+{
+  if (newx == ibufx) {
+    filter_columns_y(src, dst, ibufx, weights_y);
+    return;
+  }
+  if (newy == ibufy) {
+    filter_rows_x(src, dst, ibufx, ibufy, weights_x);
+    return;
+  }
+
+  /* Byte pixels are kept as floats in between the passes to avoid losing precision. Filter the
+   * axis that shrinks the image the most first, to keep the intermediate image small. */
+  using TmpT = std::conditional_t<std::is_same_v<T, uchar4>, float4, T>;
+  if (int64_t(newx) * ibufy <= int64_t(ibufx) * newy) {
+    Array<TmpT> tmp(int64_t(newx) * ibufy, NoInitialization());
+    filter_rows_x(src, tmp.data(), ibufx, ibufy, weights_x);
+    filter_columns_y(tmp.data(), dst, newx, weights_y);
+  }
+  else {
+    Array<TmpT> tmp(int64_t(ibufx) * newy, NoInitialization());
+    filter_columns_y(src, tmp.data(), ibufx, weights_y);
+    filter_rows_x(tmp.data(), dst, ibufx, newy, weights_x);
+  }
+}
+
+static void scale_separable_func(const ImBuf *ibuf,
+                                 int newx,
+                                 int newy,
+                                 uchar4 *dst_byte,
+                                 float *dst_float,
+                                 IMBScaleFilter filter)
+{
+  /* Always multi-threaded, see instantiate_pixel_op. */
+  threading::isolate_task([&]() {
+    const FilterWeights weights_x = compute_filter_weights(ibuf->x, newx, filter);
+    const FilterWeights weights_y = compute_filter_weights(ibuf->y, newy, filter);
+
     if (dst_byte != nullptr) {
       const uchar4 *src = (const uchar4 *)ibuf->byte_buffer.data;
-      scale_nearest(src, dst_byte, ibuf->x, ibuf->y, newx, newy, y_range);
+      scale_separable(src, dst_byte, ibuf->x, ibuf->y, newx, newy, weights_x, weights_y);
     }
-    /* Float pixels. */
     if (dst_float != nullptr) {
       if (ibuf->channels == 1) {
-        scale_nearest(ibuf->float_buffer.data, dst_float, ibuf->x, ibuf->y, newx, newy, y_range);
+        scale_separable(ibuf->float_buffer.data,
+                        dst_float,
+                        ibuf->x,
+                        ibuf->y,
+                        newx,
+                        newy,
+                        weights_x,
+                        weights_y);
       }
       else if (ibuf->channels == 2) {
         const float2 *src = (const float2 *)ibuf->float_buffer.data;
-        scale_nearest(src, (float2 *)dst_float, ibuf->x, ibuf->y, newx, newy, y_range);
+        scale_separable(
+            src, (float2 *)dst_float, ibuf->x, ibuf->y, newx, newy, weights_x, weights_y);
       }
       else if (ibuf->channels == 3) {
         const float3 *src = (const float3 *)ibuf->float_buffer.data;
-        scale_nearest(src, (float3 *)dst_float, ibuf->x, ibuf->y, newx, newy, y_range);
+        scale_separable(
+            src, (float3 *)dst_float, ibuf->x, ibuf->y, newx, newy, weights_x, weights_y);
       }
       else if (ibuf->channels == 4) {
         const float4 *src = (const float4 *)ibuf->float_buffer.data;
-        scale_nearest(src, (float4 *)dst_float, ibuf->x, ibuf->y, newx, newy, y_range);
+        scale_separable(
+            src, (float4 *)dst_float, ibuf->x, ibuf->y, newx, newy, weights_x, weights_y);
       }
     }
   });
 }
 
-static void scale_bilinear_func(
-    const ImBuf *ibuf, int newx, int newy, uchar4 *dst_byte, float *dst_float, bool threaded)
+static void scale_mitchell_func(
+    const ImBuf *ibuf, int newx, int newy, uchar4 *dst_byte, float *dst_float)
 {
-  using namespace blender;
-  using namespace blender::imbuf;
+  scale_separable_func(ibuf, newx, newy, dst_byte, dst_float, IMBScaleFilter::Mitchell);
+}
 
-  const int grain_size = threaded ? 32 : newy;
-  threading::parallel_for(IndexRange(newy), grain_size, [&](IndexRange y_range) {
-    float factor_x = float(ibuf->x) / newx;
-    float factor_y = float(ibuf->y) / newy;
-
-    for (const int y : y_range) {
-      float v = (float(y) + 0.5f) * factor_y - 0.5f;
-      for (int x = 0; x < newx; x++) {
-        float u = (float(x) + 0.5f) * factor_x - 0.5f;
-        int64_t offset = int64_t(y) * newx + x;
-        if (dst_byte) {
-          interpolate_bilinear_byte(ibuf, (uchar *)(dst_byte + offset), u, v);
-        }
-        if (dst_float) {
-          float *pixel = dst_float + ibuf->channels * offset;
-          math::interpolate_bilinear_fl(
-              ibuf->float_buffer.data, pixel, ibuf->x, ibuf->y, ibuf->channels, u, v);
-        }
-      }
-    }
-  });
+static void scale_lanczos_func(
+    const ImBuf *ibuf, int newx, int newy, uchar4 *dst_byte, float *dst_float)
+{
+  scale_separable_func(ibuf, newx, newy, dst_byte, dst_float, IMBScaleFilter::Lanczos);
 }
 
-bool IMB_scale(ImBuf *ibuf, uint newx, uint newy, IMBScaleFilter filter, bool threaded)
+}  // namespace blender::imbuf
+
+/** \} */
+
+bool IMB_scale(ImBuf *ibuf, uint newx, uint newy, IMBScaleFilter filter)
 {
   BLI_assert_msg(newx > 0 && newy > 0, "Images must be at least 1 on both dimensions!");
   if (ibuf == nullptr) {
@@ -787,20 +1036,25 @@ bool IMB_scale(ImBuf *ibuf, uint newx, uint newy, IMBScaleFilter filter, bool th
 
   switch (filter) {
     case IMBScaleFilter::Nearest:
-      scale_with_function(ibuf, newx, newy, scale_nearest_func, threaded);
+      scale_with_function(ibuf, newx, newy, scale_nearest_func);
       break;
     case IMBScaleFilter::Bilinear:
-      scale_with_function(ibuf, newx, newy, scale_bilinear_func, threaded);
+      scale_with_function(ibuf, newx, newy, scale_bilinear_func);
       break;
     case IMBScaleFilter::Box:
-      imb_scale_box(ibuf, newx, newy, threaded);
+      imb_scale_box(ibuf, newx, newy);
+      break;
+    case IMBScaleFilter::Mitchell:
+      scale_with_function(ibuf, newx, newy, blender::imbuf::scale_mitchell_func);
+      break;
+    case IMBScaleFilter::Lanczos:
+      scale_with_function(ibuf, newx, newy, blender::imbuf::scale_lanczos_func);
       break;
   }
   return true;
 }
 
-ImBuf *IMB_scale_into_new(
-    const ImBuf *ibuf, uint newx, uint newy, IMBScaleFilter filter, bool threaded)
+ImBuf *IMB_scale_into_new(const ImBuf *ibuf, uint newx, uint newy, IMBScaleFilter filter)
 {
   BLI_assert_msg(newx > 0 && newy > 0, "Images must be at least 1 on both dimensions!");
   if (ibuf == nullptr) {
@@ -823,10 +1077,16 @@ ImBuf *IMB_scale_into_new(
 
   switch (filter) {
     case IMBScaleFilter::Nearest:
-      scale_nearest_func(ibuf, newx, newy, dst_byte, dst_float, threaded);
+      scale_nearest_func(ibuf, newx, newy, dst_byte, dst_float);
       break;
     case IMBScaleFilter::Bilinear:
-      scale_bilinear_func(ibuf, newx, newy, dst_byte, dst_float, threaded);
+      scale_bilinear_func(ibuf, newx, newy, dst_byte, dst_float);
+      break;
+    case IMBScaleFilter::Mitchell:
+      blender::imbuf::scale_mitchell_func(ibuf, newx, newy, dst_byte, dst_float);
+      break;
+    case IMBScaleFilter::Lanczos:
+      blender::imbuf::scale_lanczos_func(ibuf, newx, newy, dst_byte, dst_float);
       break;
     case IMBScaleFilter::Box: {
       /* Horizontal scale. */
@@ -843,10 +1103,10 @@ ImBuf *IMB_scale_into_new(
         return nullptr;
       }
       if (newx < ibuf->x) {
-        scale_down_x_func(ibuf, newx, ibuf->y, tmp_byte, tmp_float, threaded);
+        scale_down_x_func(ibuf, newx, ibuf->y, tmp_byte, tmp_float);
       }
       else {
-        scale_up_x_func(ibuf, newx, ibuf->y, tmp_byte, tmp_float, threaded);
+        scale_up_x_func(ibuf, newx, ibuf->y, tmp_byte, tmp_float);
       }
 
       /* Vertical scale. */
@@ -860,10 +1120,10 @@ ImBuf *IMB_scale_into_new(
         IMB_assign_float_buffer(&tmpbuf, tmp_float, IB_DO_NOT_TAKE_OWNERSHIP);
       }
       if (newy < ibuf->y) {
-        scale_down_y_func(&tmpbuf, newx, newy, dst_byte, dst_float, threaded);
+        scale_down_y_func(&tmpbuf, newx, newy, dst_byte, dst_float);
       }
       else {
-        scale_up_y_func(&tmpbuf, newx, newy, dst_byte, dst_float, threaded);
+        scale_up_y_func(&tmpbuf, newx, newy, dst_byte, dst_float);
       }
 
       if (tmp_byte != nullptr) {
@@ -425,7 +425,7 @@ static ImBuf *thumb_create_ex(const char *file_path,
           }
           imb_freerectfloatImBuf(img);
         }
-        IMB_scale(img, ex, ey, IMBScaleFilter::Box, false);
+        IMB_scale(img, ex, ey, IMBScaleFilter::Mitchell);
       }
     }
     SNPRINTF(desc, "Thumbnail for %s", uri);
@@ -16,6 +16,7 @@
 
 #include "BLI_set.hh"
 
+#include <cstdint>
 #include <string>
 
 struct IDProperty;
@@ -129,6 +130,46 @@ void MOV_get_filename(const MovieReader *anim, char *filename, int filename_maxn
  */
 IDProperty *MOV_load_metadata(MovieReader *anim);
 
+/**
+ * Statistics of the decoded frame cache of a movie.
+ */
+struct MovieDecodeCacheStats {
+  /** Number of decoded frames currently in the cache. */
+  int frames_num;
+  /** Memory used by the cached frames, in bytes. */
+  size_t memory_used;
+  /** Maximum memory the caches of all movies may use together, in bytes. */
+  size_t memory_budget;
+  /** Number of frame requests served from the cache, and requests that needed decoding. */
+  int64_t hits;
+  int64_t misses;
+};
+
+/**
+ * Set the maximum memory (in bytes) that the decoded frame caches of all movies may use together.
+ * When it is exceeded, the least recently used frames are removed first, from whichever movie they
+ * belong to. Zero disables the caches, which is the default.
+ */
+void MOV_set_decode_cache_budget(size_t budget);
+
+/**
+ * Keep decoded frames of the movie and its proxies around, so that seeking backward, reverse
+ * playback and scrubbing do not have to decode the whole group of pictures again. Disabled by
+ * default, frames are only kept while the global budget is not zero.
+ */
+void MOV_set_use_decode_cache(MovieReader *anim, bool use);
+
+/**
+ * Memory (in bytes) used by the decoded frame caches of all open movies. The frames are
+ * allocated by FFmpeg, so they are not part of #MEM_get_memory_in_use.
+ */
+size_t MOV_get_decode_cache_memory_total();
+
+/**
+ * Get statistics of the decoded frame cache of the movie.
+ */
+void MOV_get_decode_cache_stats(const MovieReader *anim, MovieDecodeCacheStats *r_stats);
+
 /*-------------------------------------------------------------------- */
 /*
  * Movie proxy / timecode index related functionality.
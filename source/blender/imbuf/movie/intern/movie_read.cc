@@ -13,6 +13,7 @@
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
+#include <mutex>
 #include <sys/types.h>
 
 #include "BLI_path_utils.hh"
@@ -604,7 +605,7 @@ static void ffmpeg_postprocess(MovieReader *anim, AVFrame *input, ImBuf *ibuf)
 
   if (anim->ib_flags & IB_animdeinterlace) {
     if (ffmpeg_deinterlace(anim->pFrameDeinterlaced,
-                           anim->pFrame,
+                           input,
                            anim->pCodecCtx->pix_fmt,
                            anim->pCodecCtx->width,
                            anim->pCodecCtx->height) < 0)
@@ -754,9 +755,141 @@ static AVFrame *ffmpeg_frame_by_pts_get(MovieReader *anim, int64_t pts_to_search
   return best_frame;
 }
 
+static size_t ffmpeg_frame_memory_size(const AVFrame *frame)
+{
+  size_t size = 0;
+  for (int i = 0; i < AV_NUM_DATA_POINTERS; i++) {
+    if (frame->buf[i]) {
+      size += frame->buf[i]->size;
+    }
+  }
+  return size;
+}
+
+/* The decoded frame caches of all movies share one memory budget. When it is exceeded, the least
+ * recently used frames are removed first, regardless of the movie they belong to. Movies may be
+ * decoded from different threads, so all caches are only accessed with the mutex locked. */
+static std::mutex decode_cache_mutex;
+static blender::Vector<MovieReader *> decode_cache_readers;
+static size_t decode_cache_budget = 0;
+static size_t decode_cache_memory_total = 0;
+static uint64_t decode_cache_clock = 0;
+
+static void ffmpeg_decode_cache_clear_locked(MovieReader *anim)
+{
+  for (MovieDecodedFrame &cached : anim->decode_cache) {
+    av_frame_free(&cached.frame);
+  }
+  anim->decode_cache.clear();
+  decode_cache_memory_total -= anim->decode_cache_memory;
+  anim->decode_cache_memory = 0;
+  decode_cache_readers.remove_first_occurrence_and_reorder(anim);
+}
+
+static void ffmpeg_decode_cache_clear(MovieReader *anim)
+{
+  std::scoped_lock lock(decode_cache_mutex);
+  if (!anim->decode_cache.is_empty()) {
+    ffmpeg_decode_cache_clear_locked(anim);
+  }
+}
+
+/* Remove the least recently used frames of all movies, until the caches fit the budget. */
+static void ffmpeg_decode_cache_evict_locked()
+{
+  while (decode_cache_memory_total > decode_cache_budget && !decode_cache_readers.is_empty()) {
+    MovieReader *oldest_anim = nullptr;
+    int64_t oldest_index = 0;
+    for (MovieReader *anim : decode_cache_readers) {
+      for (const int64_t i : anim->decode_cache.index_range()) {
+        if (oldest_anim == nullptr ||
+            anim->decode_cache[i].last_used < oldest_anim->decode_cache[oldest_index].last_used)
+        {
+          oldest_anim = anim;
+          oldest_index = i;
+        }
+      }
+    }
+
+    MovieDecodedFrame &cached = oldest_anim->decode_cache[oldest_index];
+    oldest_anim->decode_cache_memory -= cached.memory_size;
+    decode_cache_memory_total -= cached.memory_size;
+    av_frame_free(&cached.frame);
+    oldest_anim->decode_cache.remove_and_reorder(oldest_index);
+    if (oldest_anim->decode_cache.is_empty()) {
+      decode_cache_readers.remove_first_occurrence_and_reorder(oldest_anim);
+    }
+  }
+}
+
+/* Keep a reference to the frame that was just decoded. This does not copy the frame data. */
+static void ffmpeg_decode_cache_add(MovieReader *anim)
+{
+  if (!anim->use_decode_cache || anim->never_seek_decode_one_frame) {
+    return;
+  }
+
+  const int64_t pts_start = av_get_pts_from_frame(anim->pFrame);
+  const int64_t pts_end = pts_start + av_get_frame_duration_in_pts_units(anim->pFrame);
+  if (pts_end <= pts_start) {
+    return;
+  }
+
+  std::scoped_lock lock(decode_cache_mutex);
+  if (decode_cache_budget == 0) {
+    return;
+  }
+
+  for (const MovieDecodedFrame &cached : anim->decode_cache) {
+    if (cached.pts_start == pts_start) {
+      return;
+    }
+  }
+
+  AVFrame *frame = av_frame_clone(anim->pFrame);
+  if (frame == nullptr) {
+    return;
+  }
+
+  if (anim->decode_cache.is_empty()) {
+    decode_cache_readers.append(anim);
+  }
+
+  const size_t memory_size = ffmpeg_frame_memory_size(frame);
+  anim->decode_cache.append({pts_start, pts_end, frame, memory_size, ++decode_cache_clock});
+  anim->decode_cache_memory += memory_size;
+  decode_cache_memory_total += memory_size;
+  ffmpeg_decode_cache_evict_locked();
+}
+
+/* Return a new reference to the cached frame that matches `pts_to_search`, nullptr if there is no
+ * such frame. The reference keeps the frame valid when it is evicted by another movie, it must be
+ * freed by the caller. */
+static AVFrame *ffmpeg_decode_cache_lookup(MovieReader *anim, int64_t pts_to_search)
+{
+  std::scoped_lock lock(decode_cache_mutex);
+
+  for (MovieDecodedFrame &cached : anim->decode_cache) {
+    if (ffmpeg_pts_isect(cached.pts_start, cached.pts_end, pts_to_search)) {
+      /* Resolution can change per-frame with WebM, such frames can not be post-processed with
+       * current conversion context. */
+      if (cached.frame->width != anim->pCodecCtx->width ||
+          cached.frame->height != anim->pCodecCtx->height)
+      {
+        return nullptr;
+      }
+      final_frame_log(anim, cached.pts_start, cached.pts_end, "Cached");
+      cached.last_used = ++decode_cache_clock;
+      return av_frame_clone(cached.frame);
+    }
+  }
+  return nullptr;
+}
+
 static void ffmpeg_decode_store_frame_pts(MovieReader *anim)
 {
   anim->cur_pts = av_get_pts_from_frame(anim->pFrame);
+  ffmpeg_decode_cache_add(anim);
 
 #  ifdef FFMPEG_OLD_KEY_FRAME_QUERY_METHOD
   if (anim->pFrame->key_frame)
@@ -1154,13 +1287,26 @@ static ImBuf *ffmpeg_fetchibuf(MovieReader *anim, int position, IMB_Timecode_Typ
   double pts_time_base = av_q2d(v_st->time_base);
   int64_t start_pts = v_st->start_time;
 
+  /* Frames decoded earlier, for example while scanning forward from a key frame after seeking
+   * backward, are used directly. Decoder state is left as is in this case. */
+  AVFrame *cached_frame = nullptr;
+  if (!anim->never_seek_decode_one_frame) {
+    cached_frame = ffmpeg_decode_cache_lookup(anim, pts_to_search);
+    if (cached_frame) {
+      anim->decode_cache_hits++;
+    }
+    else {
+      anim->decode_cache_misses++;
+    }
+  }
+
   if (anim->never_seek_decode_one_frame) {
     /* If we must only ever decode one frame, and never seek, do so here. */
     if (!anim->pFrame_complete) {
       ffmpeg_decode_video_frame(anim);
     }
   }
-  else {
+  else if (cached_frame == nullptr) {
     /* For all regular video files, do the seek/decode as needed. */
     av_log(anim->pFormatCtx,
            AV_LOG_DEBUG,
@@ -1207,7 +1353,8 @@ static ImBuf *ffmpeg_fetchibuf(MovieReader *anim, int position, IMB_Timecode_Typ
     cur_frame_final->byte_buffer.colorspace = colormanage_colorspace_get_named(anim->colorspace);
   }
 
-  AVFrame *final_frame = ffmpeg_frame_by_pts_get(anim, pts_to_search);
+  AVFrame *final_frame = cached_frame ? cached_frame :
+                                        ffmpeg_frame_by_pts_get(anim, pts_to_search);
   if (final_frame == nullptr) {
     /* No valid frame was decoded for requested PTS, fall back on most recent decoded frame, even
      * if it is incorrect. */
@@ -1220,7 +1367,12 @@ static ImBuf *ffmpeg_fetchibuf(MovieReader *anim, int position, IMB_Timecode_Typ
     ffmpeg_postprocess(anim, final_frame, cur_frame_final);
   }
 
-  anim->cur_position = position;
+  if (cached_frame == nullptr) {
+    anim->cur_position = position;
+  }
+  else {
+    av_frame_free(&cached_frame);
+  }
 
   return cur_frame_final;
 }
@@ -1231,6 +1383,8 @@ static void free_anim_ffmpeg(MovieReader *anim)
     return;
   }
 
+  ffmpeg_decode_cache_clear(anim);
+
   if (anim->pCodecCtx) {
     avcodec_free_context(&anim->pCodecCtx);
     avformat_close_input(&anim->pFormatCtx);
@@ -1349,18 +1503,68 @@ ImBuf *MOV_decode_frame(MovieReader *anim,
 #ifdef WITH_FFMPEG
   if (anim->state == MovieReader::State::Valid) {
     ibuf = ffmpeg_fetchibuf(anim, position, tc);
-    if (ibuf) {
-      anim->cur_position = position;
-    }
   }
 #endif
 
   if (ibuf) {
-    SNPRINTF(ibuf->filepath, "%s.%04d", anim->filepath, anim->cur_position + 1);
+    SNPRINTF(ibuf->filepath, "%s.%04d", anim->filepath, position + 1);
   }
   return ibuf;
 }
 
+void MOV_set_decode_cache_budget(size_t budget)
+{
+#ifdef WITH_FFMPEG
+  std::scoped_lock lock(decode_cache_mutex);
+  decode_cache_budget = budget;
+  ffmpeg_decode_cache_evict_locked();
+#else
+  UNUSED_VARS(budget);
+#endif
+}
+
+void MOV_set_use_decode_cache(MovieReader *anim, bool use)
+{
+#ifdef WITH_FFMPEG
+  anim->use_decode_cache = use;
+  if (!use) {
+    ffmpeg_decode_cache_clear(anim);
+  }
+  for (MovieReader *proxy : anim->proxy_anim) {
+    if (proxy != nullptr) {
+      MOV_set_use_decode_cache(proxy, use);
+    }
+  }
+#else
+  UNUSED_VARS(anim, use);
+#endif
+}
+
+size_t MOV_get_decode_cache_memory_total()
+{
+#ifdef WITH_FFMPEG
+  std::scoped_lock lock(decode_cache_mutex);
+  return decode_cache_memory_total;
+#else
+  return 0;
+#endif
+}
+
+void MOV_get_decode_cache_stats(const MovieReader *anim, MovieDecodeCacheStats *r_stats)
+{
+  *r_stats = {};
+#ifdef WITH_FFMPEG
+  std::scoped_lock lock(decode_cache_mutex);
+  r_stats->frames_num = int(anim->decode_cache.size());
+  r_stats->memory_used = anim->decode_cache_memory;
+  r_stats->memory_budget = decode_cache_budget;
+  r_stats->hits = anim->decode_cache_hits;
+  r_stats->misses = anim->decode_cache_misses;
+#else
+  UNUSED_VARS(anim);
+#endif
+}
+
 int MOV_get_duration_frames(MovieReader *anim, IMB_Timecode_Type tc)
 {
   if (tc == IMB_TC_NONE) {
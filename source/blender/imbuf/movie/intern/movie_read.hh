@@ -13,6 +13,8 @@
 
 #include "IMB_imbuf_enums.h"
 
+#include "BLI_vector.hh"
+
 #ifdef WITH_FFMPEG
 
 extern "C" {
@@ -30,6 +32,20 @@ struct SwsContext;
 struct IDProperty;
 struct MovieIndex;
 
+#ifdef WITH_FFMPEG
+/** Decoded frame kept in #MovieReader::decode_cache. */
+struct MovieDecodedFrame {
+  /** PTS range covered by the frame. */
+  int64_t pts_start;
+  int64_t pts_end;
+  /** Reference to the decoded frame data. */
+  AVFrame *frame;
+  size_t memory_size;
+  /** Time of the last use, for least recently used eviction across all movies. */
+  uint64_t last_used;
+};
+#endif
+
 struct MovieReader {
   enum class State { Uninitialized, Failed, Valid };
   int ib_flags = 0;
@@ -77,6 +93,15 @@ struct MovieReader {
    * ffmpeg crashes/aborts when trying to seek within them
    * (https://trac.ffmpeg.org/ticket/10755). */
   bool never_seek_decode_one_frame = false;
+
+  /* Decoded frames, so that frames of a group of pictures don't have to be decoded again when
+   * seeking backward. The caches of all movies share one memory budget. Disabled until the owner
+   * of the movie enables it. */
+  blender::Vector<MovieDecodedFrame> decode_cache;
+  size_t decode_cache_memory = 0;
+  bool use_decode_cache = false;
+  int64_t decode_cache_hits = 0;
+  int64_t decode_cache_misses = 0;
 #endif
 
   char index_dir[768] = {};
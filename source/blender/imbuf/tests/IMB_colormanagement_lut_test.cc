@@ -0,0 +1,214 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include <cmath>
+
+#include "BLI_math_vector_types.hh"
+#include "BLI_path_utils.hh"
+#include "BLI_rand.hh"
+#include "BLI_vector.hh"
+
+#include "intern/colormanagement_lut.hh"
+
+#include "ocio_capi.h"
+
+namespace blender::imbuf::tests {
+
+/* Display transform like function: channel mixing, a tone curve and a display encoding. */
+static float3 test_display_transform(const float3 &color)
+{
+  const float3 mixed(0.80f * color.x + 0.15f * color.y + 0.05f * color.z,
+                     0.10f * color.x + 0.80f * color.y + 0.10f * color.z,
+                     0.05f * color.x + 0.15f * color.y + 0.80f * color.z);
+  float3 result;
+  for (int i = 0; i < 3; i++) {
+    const float value = std::max(mixed[i], 0.0f);
+    result[i] = std::pow(value / (value + 0.6f), 1.0f / 2.2f);
+  }
+  return result;
+}
+
+static ColorLut3D create_test_lut()
+{
+  return ColorLut3D([](MutableSpan<float3> colors) {
+    for (float3 &color : colors) {
+      color = test_display_transform(color);
+    }
+  });
+}
+
+TEST(colormanagement_lut, shaper)
+{
+  EXPECT_FLOAT_EQ(ColorLut3D::shaper(0.0f), 0.0f);
+  EXPECT_FLOAT_EQ(ColorLut3D::shaper(-1.0f), 0.0f);
+  EXPECT_FLOAT_EQ(ColorLut3D::shaper(NAN), 0.0f);
+  EXPECT_FLOAT_EQ(ColorLut3D::shaper(ColorLut3D::max_value), 1.0f);
+  EXPECT_FLOAT_EQ(ColorLut3D::shaper(ColorLut3D::max_value * 2.0f), 1.0f);
+
+  for (const float value : {0.001f, 0.01f, 0.18f, 1.0f, 16.0f}) {
+    EXPECT_NEAR(ColorLut3D::shaper_inverse(ColorLut3D::shaper(value)), value, value * 1e-4f);
+  }
+}
+
+/* Display transforms of the configuration bundled with Blender, which the table is used for. */
+class ColormanagementLutOCIOTest : public testing::Test {
+ protected:
+  OCIO_ConstConfigRcPtr *config_ = nullptr;
+
+  void SetUp() override
+  {
+    char filepath[FILE_MAX];
+    BLI_path_join(filepath,
+                  sizeof(filepath),
+                  blender::tests::flags_test_release_dir().c_str(),
+                  "datafiles",
+                  "colormanagement",
+                  "config.ocio");
+    OCIO_init();
+    config_ = OCIO_configCreateFromFile(filepath);
+    if (config_ == nullptr) {
+      GTEST_SKIP() << "OpenColorIO configuration not found: " << filepath;
+    }
+  }
+
+  void TearDown() override
+  {
+    if (config_) {
+      OCIO_configRelease(config_);
+    }
+    OCIO_exit();
+  }
+
+  OCIO_ConstCPUProcessorRcPtr *create_display_processor(const char *view)
+  {
+    OCIO_ConstProcessorRcPtr *processor = OCIO_createDisplayProcessor(
+        config_, "Linear Rec.709", view, "sRGB", "", 1.0f, 1.0f, 0.0f, 0.0f, false, false);
+    EXPECT_NE(processor, nullptr);
+    if (processor == nullptr) {
+      return nullptr;
+    }
+    OCIO_ConstCPUProcessorRcPtr *cpu_processor = OCIO_processorGetCPUProcessor(processor);
+    OCIO_processorRelease(processor);
+    return cpu_processor;
+  }
+};
+
+static void cpu_processor_apply(OCIO_ConstCPUProcessorRcPtr *cpu_processor,
+                                float *buffer,
+                                const int64_t pixels_num,
+                                const int channels,
+                                const bool predivide)
+{
+  OCIO_PackedImageDesc *img = OCIO_createOCIO_PackedImageDesc(buffer,
+                                                              int(pixels_num),
+                                                              1,
+                                                              channels,
+                                                              sizeof(float),
+                                                              channels * sizeof(float),
+                                                              channels * sizeof(float) *
+                                                                  pixels_num);
+  if (predivide) {
+    OCIO_cpuProcessorApply_predivide(cpu_processor, img);
+  }
+  else {
+    OCIO_cpuProcessorApply(cpu_processor, img);
+  }
+  OCIO_PackedImageDescRelease(img);
+}
+
+static ColorLut3D create_lut(OCIO_ConstCPUProcessorRcPtr *cpu_processor)
+{
+  return ColorLut3D([&](MutableSpan<float3> colors) {
+    cpu_processor_apply(cpu_processor, &colors.data()->x, colors.size(), 3, false);
+  });
+}
+
+TEST_F(ColormanagementLutOCIOTest, accuracy)
+{
+  for (const char *view : {"Standard", "AgX", "Filmic", "Khronos PBR Neutral"}) {
+    OCIO_ConstCPUProcessorRcPtr *cpu_processor = create_display_processor(view);
+    if (cpu_processor == nullptr) {
+      continue;
+    }
+    const ColorLut3D lut = create_lut(cpu_processor);
+
+    /* Compare against the exact transform, on a logarithmic distribution of scene linear values
+     * and on the [0, 1] range. The error must stay below one step after quantization to 8 bits. */
+    RandomNumberGenerator rng(0);
+    Vector<float3> colors;
+    for (int i = 0; i < 100000; i++) {
+      float3 color;
+      for (int j = 0; j < 3; j++) {
+        color[j] = (i % 2) ? std::exp2(rng.get_float() * 17.0f - 12.0f) : rng.get_float();
+      }
+      colors.append(color);
+    }
+    Vector<float3> expected = colors;
+    cpu_processor_apply(cpu_processor, &expected.data()->x, expected.size(), 3, false);
+
+    float max_error = 0.0f;
+    for (const int64_t i : colors.index_range()) {
+      const float3 result = lut.evaluate(colors[i]);
+      for (int j = 0; j < 3; j++) {
+        max_error = std::max(max_error, std::abs(result[j] - expected[i][j]));
+      }
+    }
+    EXPECT_LT(max_error, 1.0f / 255.0f) << view;
+
+    OCIO_cpuProcessorRelease(cpu_processor);
+  }
+}
+
+TEST_F(ColormanagementLutOCIOTest, apply_out_of_range)
+{
+  OCIO_ConstCPUProcessorRcPtr *cpu_processor = create_display_processor("AgX");
+  ASSERT_NE(cpu_processor, nullptr);
+  const ColorLut3D lut = create_lut(cpu_processor);
+
+  /* Negative values of wide gamut colors and values above the table range must match the exact
+   * transform, instead of being clamped by the table. */
+  float4 buffer[] = {float4(0.2f, 0.3f, 0.4f, 1.0f),
+                     float4(-0.05f, 0.3f, 0.4f, 1.0f),
+                     float4(0.2f, -0.3f, 0.4f, 0.5f),
+                     float4(0.2f, 0.3f, 0.4f, 0.5f),
+                     float4(100.0f, 0.3f, 0.4f, 1.0f)};
+  constexpr int64_t pixels_num = ARRAY_SIZE(buffer);
+  float4 expected[pixels_num];
+  std::copy_n(buffer, pixels_num, expected);
+  cpu_processor_apply(cpu_processor, &expected[0].x, pixels_num, 4, true);
+
+  int64_t fallback_pixels_num = 0;
+  lut.apply(&buffer[0].x, pixels_num, 4, true, [&](float *fallback_buffer, const int64_t num) {
+    fallback_pixels_num += num;
+    cpu_processor_apply(cpu_processor, fallback_buffer, num, 4, true);
+  });
+
+  EXPECT_EQ(fallback_pixels_num, 3);
+  for (const int64_t i : IndexRange(pixels_num)) {
+    EXPECT_V4_NEAR(buffer[i], expected[i], 1.0f / 255.0f);
+  }
+
+  OCIO_cpuProcessorRelease(cpu_processor);
+}
+
+TEST(colormanagement_lut, apply_predivide)
+{
+  const ColorLut3D lut = create_test_lut();
+
+  const float4 color(0.1f, 0.4f, 0.8f, 1.0f);
+  const float alpha = 0.5f;
+  float4 buffer[2] = {color, float4(color.xyz() * alpha, alpha)};
+  lut.apply(&buffer[0].x, 2, 4, true, [](float * /*buffer*/, int64_t /*pixels_num*/) {
+    FAIL() << "Colors in the table range must not use the fallback";
+  });
+
+  const float3 expected = lut.evaluate(color.xyz());
+  EXPECT_V3_NEAR(buffer[0].xyz(), expected, 1e-6f);
+  EXPECT_V3_NEAR(buffer[1].xyz(), float3(expected * alpha), 1e-6f);
+  EXPECT_FLOAT_EQ(buffer[1].w, alpha);
+}
+
+}  // namespace blender::imbuf::tests
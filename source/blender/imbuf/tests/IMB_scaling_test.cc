@@ -58,13 +58,13 @@ static ImBuf *scale_2x_smaller(bool nearest, bool threaded, int float_channels =
                                     create_6x2_test_image();
   int ww = 3, hh = 1;
   if (threaded) {
-    IMB_scale(img, ww, hh, IMBScaleFilter::Bilinear, true);
+    IMB_scale(img, ww, hh, IMBScaleFilter::Bilinear);
   }
   else if (nearest) {
-    IMB_scale(img, ww, hh, IMBScaleFilter::Nearest, false);
+    IMB_scale(img, ww, hh, IMBScaleFilter::Nearest);
   }
   else {
-    IMB_scale(img, ww, hh, IMBScaleFilter::Box, false);
+    IMB_scale(img, ww, hh, IMBScaleFilter::Box);
   }
   return img;
 }
@@ -75,13 +75,13 @@ static ImBuf *scale_to_1x1(bool nearest, bool threaded, int float_channels = 0)
                                     create_6x2_test_image();
   int ww = 1, hh = 1;
   if (threaded) {
-    IMB_scale(img, ww, hh, IMBScaleFilter::Bilinear, true);
+    IMB_scale(img, ww, hh, IMBScaleFilter::Bilinear);
   }
   else if (nearest) {
-    IMB_scale(img, ww, hh, IMBScaleFilter::Nearest, false);
+    IMB_scale(img, ww, hh, IMBScaleFilter::Nearest);
   }
   else {
-    IMB_scale(img, ww, hh, IMBScaleFilter::Box, false);
+    IMB_scale(img, ww, hh, IMBScaleFilter::Box);
   }
   return img;
 }
@@ -92,13 +92,13 @@ static ImBuf *scale_fractional_larger(bool nearest, bool threaded, int float_cha
                                     create_6x2_test_image();
   int ww = 9, hh = 7;
   if (threaded) {
-    IMB_scale(img, ww, hh, IMBScaleFilter::Bilinear, true);
+    IMB_scale(img, ww, hh, IMBScaleFilter::Bilinear);
   }
   else if (nearest) {
-    IMB_scale(img, ww, hh, IMBScaleFilter::Nearest, false);
+    IMB_scale(img, ww, hh, IMBScaleFilter::Nearest);
   }
   else {
-    IMB_scale(img, ww, hh, IMBScaleFilter::Box, false);
+    IMB_scale(img, ww, hh, IMBScaleFilter::Box);
   }
   return img;
 }
@@ -294,4 +294,69 @@ TEST(imbuf_scaling, threaded_2x_smaller_fl4)
   IMB_freeImBuf(res);
 }
 
+static ImBuf *create_constant_test_image(int width, int height, uchar4 color)
+{
+  ImBuf *img = IMB_allocImBuf(width, height, 32, IB_rect);
+  uchar4 *col = reinterpret_cast<uchar4 *>(img->byte_buffer.data);
+  for (int i = 0; i < width * height; i++) {
+    col[i] = color;
+  }
+  return img;
+}
+
+static void test_constant_image(IMBScaleFilter filter, int width, int height)
+{
+  const uchar4 color(200, 100, 0, 255);
+  ImBuf *img = create_constant_test_image(13, 7, color);
+  IMB_scale(img, width, height, filter);
+  const uchar4 *got = reinterpret_cast<uchar4 *>(img->byte_buffer.data);
+  for (int i = 0; i < width * height; i++) {
+    EXPECT_EQ(uint4(got[i]), uint4(color));
+  }
+  IMB_freeImBuf(img);
+}
+
+TEST(imbuf_scaling, mitchell_constant)
+{
+  test_constant_image(IMBScaleFilter::Mitchell, 5, 3);
+  test_constant_image(IMBScaleFilter::Mitchell, 31, 17);
+  test_constant_image(IMBScaleFilter::Mitchell, 13, 2);
+}
+
+TEST(imbuf_scaling, lanczos_constant)
+{
+  test_constant_image(IMBScaleFilter::Lanczos, 5, 3);
+  test_constant_image(IMBScaleFilter::Lanczos, 31, 17);
+  test_constant_image(IMBScaleFilter::Lanczos, 4, 7);
+}
+
+TEST(imbuf_scaling, mitchell_2x_smaller_fl4)
+{
+  /* The middle pixel has symmetric filter weights, so it is the average of the linear gradient. */
+  ImBuf *img = create_6x2_test_image_fl(4);
+  IMB_scale(img, 3, 1, IMBScaleFilter::Mitchell);
+  const float4 *got = reinterpret_cast<float4 *>(img->float_buffer.data);
+  EXPECT_V4_NEAR(got[1], float4(3.375f, 3.5f, 3.625f, 3.75f), EPS);
+  IMB_freeImBuf(img);
+}
+
+TEST(imbuf_scaling, lanczos_2x_smaller_fl1)
+{
+  ImBuf *img = create_6x2_test_image_fl(1);
+  IMB_scale(img, 3, 1, IMBScaleFilter::Lanczos);
+  EXPECT_NEAR(img->float_buffer.data[1], 3.375f, EPS);
+  IMB_freeImBuf(img);
+}
+
+TEST(imbuf_scaling, lanczos_into_new_byte)
+{
+  ImBuf *img = create_6x2_test_image();
+  ImBuf *res = IMB_scale_into_new(img, 9, 7, IMBScaleFilter::Lanczos);
+  EXPECT_EQ(res->x, 9);
+  EXPECT_EQ(res->y, 7);
+  EXPECT_NE(res->byte_buffer.data, nullptr);
+  IMB_freeImBuf(img);
+  IMB_freeImBuf(res);
+}
+
 }  // namespace blender::imbuf::tests
@@ -0,0 +1,125 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include <cmath>
+#include <cstdio>
+#include <optional>
+#include <string>
+
+#include "BLI_array.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_path_utils.hh"
+#include "BLI_rand.hh"
+#include "BLI_timeit.hh"
+
+#include "intern/colormanagement_lut.hh"
+
+#include "ocio_capi.h"
+
+namespace blender::imbuf::tests {
+
+static constexpr int IMAGE_X = 3840;
+static constexpr int IMAGE_Y = 2160;
+
+static void cpu_processor_apply(OCIO_ConstCPUProcessorRcPtr *cpu_processor,
+                                float *buffer,
+                                const int64_t pixels_num,
+                                const int channels)
+{
+  OCIO_PackedImageDesc *img = OCIO_createOCIO_PackedImageDesc(buffer,
+                                                              int(pixels_num),
+                                                              1,
+                                                              channels,
+                                                              sizeof(float),
+                                                              channels * sizeof(float),
+                                                              channels * sizeof(float) *
+                                                                  pixels_num);
+  OCIO_cpuProcessorApply(cpu_processor, img);
+  OCIO_PackedImageDescRelease(img);
+}
+
+/* Time a 4K RGBA frame through the exact display transform and through the baked table, on a
+ * single thread, and report the largest difference between them. Run with `--test-release-dir`
+ * pointing to the directory that contains the bundled OpenColorIO configuration. */
+static void display_transform_perf(OCIO_ConstConfigRcPtr *config, const char *view)
+{
+  OCIO_ConstProcessorRcPtr *processor = OCIO_createDisplayProcessor(
+      config, "Linear Rec.709", view, "sRGB", "", 1.0f, 1.0f, 0.0f, 0.0f, false, false);
+  ASSERT_NE(processor, nullptr);
+  OCIO_ConstCPUProcessorRcPtr *cpu_processor = OCIO_processorGetCPUProcessor(processor);
+  OCIO_processorRelease(processor);
+
+  /* Scene linear values with a logarithmic distribution, and a few negative ones. */
+  const int64_t pixels_num = int64_t(IMAGE_X) * IMAGE_Y;
+  Array<float4> source(pixels_num);
+  RandomNumberGenerator rng(0);
+  for (float4 &pixel : source) {
+    for (int j = 0; j < 3; j++) {
+      pixel[j] = std::exp2(rng.get_float() * 14.0f - 10.0f) - 0.002f;
+    }
+    pixel.w = 1.0f;
+  }
+
+  std::optional<ColorLut3D> lut;
+  {
+    SCOPED_TIMER(std::string(view) + " bake");
+    lut.emplace([&](MutableSpan<float3> colors) {
+      cpu_processor_apply(cpu_processor, &colors.data()->x, colors.size(), 3);
+    });
+  }
+
+  Array<float4> exact = source;
+  {
+    SCOPED_TIMER(std::string(view) + " exact");
+    cpu_processor_apply(cpu_processor, &exact.data()->x, pixels_num, 4);
+  }
+
+  Array<float4> result = source;
+  int64_t fallback_pixels_num = 0;
+  {
+    SCOPED_TIMER(std::string(view) + " table");
+    lut->apply(&result.data()->x, pixels_num, 4, false, [&](float *buffer, const int64_t num) {
+      fallback_pixels_num += num;
+      cpu_processor_apply(cpu_processor, buffer, num, 4);
+    });
+  }
+
+  float max_error = 0.0f;
+  for (const int64_t i : source.index_range()) {
+    for (int j = 0; j < 3; j++) {
+      max_error = std::max(max_error, std::abs(result[i][j] - exact[i][j]));
+    }
+  }
+  printf("%s: max error %.2f / 255, %.1f%% of pixels used the exact transform\n",
+         view,
+         max_error * 255.0f,
+         100.0 * double(fallback_pixels_num) / double(pixels_num));
+
+  OCIO_cpuProcessorRelease(cpu_processor);
+}
+
+TEST(colormanagement_lut, display_transform_perf)
+{
+  char filepath[FILE_MAX];
+  BLI_path_join(filepath,
+                sizeof(filepath),
+                blender::tests::flags_test_release_dir().c_str(),
+                "datafiles",
+                "colormanagement",
+                "config.ocio");
+  OCIO_init();
+  OCIO_ConstConfigRcPtr *config = OCIO_configCreateFromFile(filepath);
+  ASSERT_NE(config, nullptr) << filepath;
+
+  for (const char *view : {"Standard", "AgX", "Filmic"}) {
+    display_transform_perf(config, view);
+  }
+
+  OCIO_configRelease(config);
+  OCIO_exit();
+}
+
+}  // namespace blender::imbuf::tests
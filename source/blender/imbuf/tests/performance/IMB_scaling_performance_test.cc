@@ -78,29 +78,25 @@ static void imb_xform_box(ImBuf *&src, int width, int height)
                           width < src->x && height < src->y ? IMB_FILTER_BOX :
                                                               IMB_FILTER_BILINEAR);
 }
-static void imb_scale_nearest_st(ImBuf *&src, int width, int height)
-{
-  IMB_scale(src, width, height, IMBScaleFilter::Nearest, false);
-}
 static void imb_scale_nearest(ImBuf *&src, int width, int height)
 {
-  IMB_scale(src, width, height, IMBScaleFilter::Nearest, true);
+  IMB_scale(src, width, height, IMBScaleFilter::Nearest);
 }
-static void imb_scale_bilinear_st(ImBuf *&src, int width, int height)
+static void imb_scale_bilinear(ImBuf *&src, int width, int height)
 {
-  IMB_scale(src, width, height, IMBScaleFilter::Bilinear, false);
+  IMB_scale(src, width, height, IMBScaleFilter::Bilinear);
 }
-static void imb_scale_bilinear(ImBuf *&src, int width, int height)
+static void imb_scale_box(ImBuf *&src, int width, int height)
 {
-  IMB_scale(src, width, height, IMBScaleFilter::Bilinear, true);
+  IMB_scale(src, width, height, IMBScaleFilter::Box);
 }
-static void imb_scale_box_st(ImBuf *&src, int width, int height)
+static void imb_scale_mitchell(ImBuf *&src, int width, int height)
 {
-  IMB_scale(src, width, height, IMBScaleFilter::Box, false);
+  IMB_scale(src, width, height, IMBScaleFilter::Mitchell);
 }
-static void imb_scale_box(ImBuf *&src, int width, int height)
+static void imb_scale_lanczos(ImBuf *&src, int width, int height)
 {
-  IMB_scale(src, width, height, IMBScaleFilter::Box, true);
+  IMB_scale(src, width, height, IMBScaleFilter::Lanczos);
 }
 
 static void scale_perf_impl(const char *name,
@@ -120,17 +116,17 @@ static void scale_perf_impl(const char *name,
 
 static void test_scaling_perf(bool use_float)
 {
-  scale_perf_impl("scale_neare_s", use_float, imb_scale_nearest_st);
   scale_perf_impl("scale_neare_m", use_float, imb_scale_nearest);
   scale_perf_impl("xform_neare_m", use_float, imb_xform_nearest);
 
-  scale_perf_impl("scale_bilin_s", use_float, imb_scale_bilinear_st);
   scale_perf_impl("scale_bilin_m", use_float, imb_scale_bilinear);
   scale_perf_impl("xform_bilin_m", use_float, imb_xform_bilinear);
 
-  scale_perf_impl("scale_boxfl_s", use_float, imb_scale_box_st);
   scale_perf_impl("scale_boxfl_m", use_float, imb_scale_box);
   scale_perf_impl("xform_boxfl_m", use_float, imb_xform_box);
+
+  scale_perf_impl("scale_mitch_m", use_float, imb_scale_mitchell);
+  scale_perf_impl("scale_lancz_m", use_float, imb_scale_lanczos);
 }
 
 TEST(imbuf_scaling, scaling_perf_byte)
@@ -865,6 +865,7 @@ enum {
 
   SEQ_CACHE_PREFETCH_ENABLE = (1 << 10),
   SEQ_CACHE_DISK_CACHE_ENABLE = (1 << 11),
+  SEQ_CACHE_PREFETCH_MULTI_FRAME = (1 << 12),
 };
 
 /** #Strip.color_tag. */
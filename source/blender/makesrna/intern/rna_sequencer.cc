@@ -309,6 +309,14 @@ static void rna_SequenceEditor_update_cache(Main * /*bmain*/, Scene *scene, Poin
   SEQ_cache_cleanup(scene);
 }
 
+static void rna_SequenceEditor_update_prefetch(Main * /*bmain*/,
+                                               Scene *scene,
+                                               PointerRNA * /*ptr*/)
+{
+  /* Restart prefetching with the new number of threads. */
+  SEQ_prefetch_stop(scene);
+}
+
 /* internal use */
 static int rna_Strip_elements_length(PointerRNA *ptr)
 {
@@ -864,6 +872,34 @@ static bool rna_MovieStrip_reload_if_needed(ID *scene_id, Strip *strip, Main *bm
   return can_produce_frames;
 }
 
+static MovieDecodeCacheStats rna_MovieStrip_decode_cache_stats(PointerRNA *ptr)
+{
+  MovieDecodeCacheStats stats = {};
+  Strip *strip = static_cast<Strip *>(ptr->data);
+  StripAnim *sanim = static_cast<StripAnim *>(strip->anims.first);
+  if (sanim != nullptr && sanim->anim != nullptr) {
+    MOV_get_decode_cache_stats(sanim->anim, &stats);
+  }
+  return stats;
+}
+
+static int rna_MovieStrip_decode_cache_frames_get(PointerRNA *ptr)
+{
+  return rna_MovieStrip_decode_cache_stats(ptr).frames_num;
+}
+
+static float rna_MovieStrip_decode_cache_memory_get(PointerRNA *ptr)
+{
+  return float(rna_MovieStrip_decode_cache_stats(ptr).memory_used) / (1024.0f * 1024.0f);
+}
+
+static float rna_MovieStrip_decode_cache_hit_ratio_get(PointerRNA *ptr)
+{
+  const MovieDecodeCacheStats stats = rna_MovieStrip_decode_cache_stats(ptr);
+  const int64_t requests = stats.hits + stats.misses;
+  return requests > 0 ? float(stats.hits) / float(requests) : 0.0f;
+}
+
 static PointerRNA rna_MovieStrip_metadata_get(ID *scene_id, Strip *strip)
 {
   if (strip == nullptr || strip->anims.first == nullptr) {
@@ -2541,6 +2577,14 @@ static void rna_def_editor(BlenderRNA *brna)
       "Render frames ahead of current frame in the background for faster playback");
   RNA_def_property_update(prop, NC_SCENE | ND_SEQUENCER, nullptr);
 
+  prop = RNA_def_property(srna, "use_prefetch_multi_frame", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "cache_flag", SEQ_CACHE_PREFETCH_MULTI_FRAME);
+  RNA_def_property_ui_text(prop,
+                           "Multi-Frame Prefetch",
+                           "Render several frames ahead at the same time, each on its own copy "
+                           "of the scene, at the cost of memory usage");
+  RNA_def_property_update(prop, NC_SCENE | ND_SEQUENCER, "rna_SequenceEditor_update_prefetch");
+
   /* functions */
 
   func = RNA_def_function(srna, "display_stack", "rna_SequenceEditor_display_stack");
@@ -2977,6 +3021,30 @@ static void rna_def_movie(BlenderRNA *brna)
   RNA_def_parameter_flags(parm, PropertyFlag(0), PARM_RNAPTR);
   RNA_def_function_return(func, parm);
 
+  /* Decoded frame cache statistics. */
+  prop = RNA_def_property(srna, "decode_cache_frames", PROP_INT, PROP_NONE);
+  RNA_def_property_int_funcs(prop, "rna_MovieStrip_decode_cache_frames_get", nullptr, nullptr);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE | PROP_ANIMATABLE);
+  RNA_def_property_ui_text(prop,
+                           "Decode Cache Frames",
+                           "Number of decoded frames of the movie kept to speed up seeking");
+
+  prop = RNA_def_property(srna, "decode_cache_memory", PROP_FLOAT, PROP_NONE);
+  RNA_def_property_float_funcs(prop, "rna_MovieStrip_decode_cache_memory_get", nullptr, nullptr);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE | PROP_ANIMATABLE);
+  RNA_def_property_ui_text(prop,
+                           "Decode Cache Memory",
+                           "Memory used by the decoded frames of the movie (in megabytes)");
+
+  prop = RNA_def_property(srna, "decode_cache_hit_ratio", PROP_FLOAT, PROP_FACTOR);
+  RNA_def_property_float_funcs(
+      prop, "rna_MovieStrip_decode_cache_hit_ratio_get", nullptr, nullptr);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE | PROP_ANIMATABLE);
+  RNA_def_property_ui_text(prop,
+                           "Decode Cache Hit Ratio",
+                           "Fraction of the requested frames that were found in the decoded "
+                           "frame cache, instead of being decoded from the file");
+
   /* multiview */
   prop = RNA_def_property(srna, "use_multiview", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, nullptr, "flag", SEQ_USE_VIEWS);
@@ -514,6 +514,29 @@ static NodeOperation *get_compositor_operation(Context &context, DNode node)
   return new BlurOperation(context, node);
 }
 
+/* Only blurs of a constant size in pixels read a bounded neighborhood around each pixel, so the
+ * blur can only be evaluated in tiles if its size is neither relative nor variable and its bounds
+ * are not extended. The recursive Gaussian filter is not supported because its response decays
+ * but never ends. */
+static std::optional<int> get_compositor_tile_halo(const bNode &node)
+{
+  const NodeBlurData &data = node_storage(node);
+  if (data.relative || data.filtertype == R_FILTER_FAST_GAUSS ||
+      node.custom1 & (CMP_NODEFLAG_BLUR_EXTEND_BOUNDS | CMP_NODEFLAG_BLUR_VARIABLE_SIZE))
+  {
+    return std::nullopt;
+  }
+
+  const bNodeSocket &size_socket = node.input_by_identifier("Size");
+  if (size_socket.is_directly_linked()) {
+    return std::nullopt;
+  }
+
+  const float size = math::clamp(
+      size_socket.default_value_typed<bNodeSocketValueFloat>()->value, 0.0f, 1.0f);
+  return int(math::ceil(math::max(data.sizex, data.sizey) * size));
+}
+
 }  // namespace blender::nodes::node_composite_blur_cc
 
 void register_node_type_cmp_blur()
@@ -534,6 +557,7 @@ void register_node_type_cmp_blur()
   blender::bke::node_type_storage(
       &ntype, "NodeBlurData", node_free_standard_storage, node_copy_standard_storage);
   ntype.get_compositor_operation = file_ns::get_compositor_operation;
+  ntype.get_compositor_tile_halo = file_ns::get_compositor_tile_halo;
 
   blender::bke::node_register_type(&ntype);
 }
@@ -12,6 +12,7 @@
 #include "UI_interface.hh"
 #include "UI_resources.hh"
 
+#include "COM_algorithm_layered_bokeh_blur.hh"
 #include "COM_algorithm_parallel_reduction.hh"
 #include "COM_node_operation.hh"
 #include "COM_utilities.hh"
@@ -238,6 +239,13 @@ class BokehBlurOperation : public NodeOperation {
     const Result &size_image = get_input("Size");
     const Result &mask_image = get_input("Bounding box");
 
+#if defined(WITH_FFTW3)
+    if (use_layered_bokeh_blur(search_radius)) {
+      this->execute_variable_size_layered(search_radius);
+      return;
+    }
+#endif
+
     const Domain domain = compute_domain();
     Result &output = get_result("Image");
     output.allocate_texture(domain);
@@ -311,6 +319,41 @@ class BokehBlurOperation : public NodeOperation {
     });
   }
 
+  /* Identical to execute_variable_size_cpu but uses the layered bokeh blur algorithm, which is
+   * much faster for large search radii. */
+  void execute_variable_size_layered(const int search_radius)
+  {
+    const float base_size = this->compute_blur_radius();
+
+    const Result &input = get_input("Image");
+    const Result &weights = get_input("Bokeh");
+    const Result &size_image = get_input("Size");
+    const Result &mask_image = get_input("Bounding box");
+
+    const Domain domain = compute_domain();
+    Result radius = context().create_result(ResultType::Float);
+    radius.allocate_texture(domain);
+    parallel_for(domain.size, [&](const int2 texel) {
+      radius.store_pixel(texel, math::max(0.0f, size_image.load_pixel<float>(texel) * base_size));
+    });
+
+    Result &output = get_result("Image");
+    layered_bokeh_blur(this->context(), input, radius, weights, output, search_radius);
+    radius.release();
+
+    /* The mask input is treated as a boolean. If it is zero, then no blurring happens for this
+     * pixel. Otherwise, the pixel is blurred normally and the mask value is irrelevant. */
+    if (mask_image.is_single_value()) {
+      return;
+    }
+
+    parallel_for(domain.size, [&](const int2 texel) {
+      if (mask_image.load_pixel<float>(texel) == 0.0f) {
+        output.store_pixel(texel, input.load_pixel<float4>(texel));
+      }
+    });
+  }
+
   /* Compute a blur kernel from the bokeh result by interpolating it to the size of the kernel.
    * Note that we load the bokeh result inverted along both directions to maintain the shape of the
    * weights if it was not symmetrical. To understand why inversion makes sense, consider a 1D
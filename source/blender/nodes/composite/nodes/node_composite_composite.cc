@@ -78,13 +78,12 @@ class CompositeOperation : public NodeOperation {
       color.w = alpha.get_single_value<float>();
     }
 
-    const Domain domain = compute_domain();
     Result output = context().get_output_result();
     if (this->context().use_gpu()) {
       GPU_texture_clear(output, GPU_DATA_FLOAT, color);
     }
     else {
-      parallel_for(domain.size, [&](const int2 texel) { output.store_pixel(texel, color); });
+      this->write_output_cpu(output, [&](const int2 /*texel*/) { return color; });
     }
   }
 
@@ -125,18 +124,10 @@ class CompositeOperation : public NodeOperation {
 
   void execute_ignore_alpha_cpu()
   {
-    const Domain domain = compute_domain();
     const Result &image = get_input("Image");
     Result output = context().get_output_result();
-
-    const Bounds<int2> bounds = get_output_bounds();
-    parallel_for(domain.size, [&](const int2 texel) {
-      const int2 output_texel = texel + bounds.min;
-      if (output_texel.x > bounds.max.x || output_texel.y > bounds.max.y) {
-        return;
-      }
-      output.store_pixel(texel + bounds.min,
-                         float4(image.load_pixel<float4, true>(texel).xyz(), 1.0f));
+    this->write_output_cpu(output, [&](const int2 texel) {
+      return float4(image.load_pixel<float4, true>(texel).xyz(), 1.0f);
     });
   }
 
@@ -178,18 +169,10 @@ class CompositeOperation : public NodeOperation {
 
   void execute_copy_cpu()
   {
-    const Domain domain = compute_domain();
     const Result &image = get_input("Image");
     Result output = context().get_output_result();
-
-    const Bounds<int2> bounds = get_output_bounds();
-    parallel_for(domain.size, [&](const int2 texel) {
-      const int2 output_texel = texel + bounds.min;
-      if (output_texel.x > bounds.max.x || output_texel.y > bounds.max.y) {
-        return;
-      }
-      output.store_pixel(texel + bounds.min, image.load_pixel<float4>(texel));
-    });
+    this->write_output_cpu(output,
+                           [&](const int2 texel) { return image.load_pixel<float4>(texel); });
   }
 
   /* Executes when the alpha channel of the image is set as the value of the input alpha. */
@@ -233,20 +216,32 @@ class CompositeOperation : public NodeOperation {
 
   void execute_set_alpha_cpu()
   {
-    const Domain domain = compute_domain();
     const Result &image = get_input("Image");
     const Result &alpha = get_input("Alpha");
     Result output = context().get_output_result();
+    this->write_output_cpu(output, [&](const int2 texel) {
+      return float4(image.load_pixel<float4, true>(texel).xyz(),
+                    alpha.load_pixel<float, true>(texel));
+    });
+  }
 
-    const Bounds<int2> bounds = get_output_bounds();
-    parallel_for(domain.size, [&](const int2 texel) {
-      const int2 output_texel = texel + bounds.min;
-      if (output_texel.x > bounds.max.x || output_texel.y > bounds.max.y) {
-        return;
-      }
-      output.store_pixel(texel + bounds.min,
-                         float4(image.load_pixel<float4, true>(texel).xyz(),
-                                alpha.load_pixel<float, true>(texel)));
+  /* Writes the colors returned by the given function for the texels of the compositing region
+   * into the output, but only for the texels inside the output region of the context, which is
+   * smaller than the compositing region when the compositor is evaluated in tiles, since the
+   * halo around the tile is only needed to compute the tile. The function gets the texel in the
+   * space of the compositing region and returns the color that should be written. */
+  template<typename Function> void write_output_cpu(Result &output, const Function &function)
+  {
+    const rcti compositing_region = context().get_compositing_region();
+    const int2 compositing_lower_bound = int2(compositing_region.xmin, compositing_region.ymin);
+
+    const rcti output_region = context().get_output_region();
+    const int2 lower_bound = int2(output_region.xmin, output_region.ymin);
+    const int2 upper_bound = int2(output_region.xmax, output_region.ymax);
+
+    parallel_for(upper_bound - lower_bound, [&](const int2 texel) {
+      const int2 output_texel = texel + lower_bound;
+      output.store_pixel(output_texel, function(output_texel - compositing_lower_bound));
     });
   }
 
@@ -280,6 +275,11 @@ static NodeOperation *get_compositor_operation(Context &context, DNode node)
   return new CompositeOperation(context, node);
 }
 
+static std::optional<int> get_compositor_tile_halo(const bNode & /*node*/)
+{
+  return 0;
+}
+
 }  // namespace blender::nodes::node_composite_composite_cc
 
 void register_node_type_cmp_composite()
@@ -296,6 +296,7 @@ void register_node_type_cmp_composite()
   ntype.declare = file_ns::cmp_node_composite_declare;
   ntype.draw_buttons = file_ns::node_composit_buts_composite;
   ntype.get_compositor_operation = file_ns::get_compositor_operation;
+  ntype.get_compositor_tile_halo = file_ns::get_compositor_tile_halo;
   ntype.no_muting = true;
 
   blender::bke::node_register_type(&ntype);
@@ -189,6 +189,11 @@ static NodeOperation *get_compositor_operation(Context &context, DNode node)
   return new ConvertColorSpaceOperation(context, node);
 }
 
+static std::optional<int> get_compositor_tile_halo(const bNode & /*node*/)
+{
+  return 0;
+}
+
 }  // namespace blender::nodes::node_composite_convert_color_space_cc
 
 void register_node_type_cmp_convert_color_space()
@@ -208,6 +213,7 @@ void register_node_type_cmp_convert_color_space()
   blender::bke::node_type_storage(
       &ntype, "NodeConvertColorSpace", node_free_standard_storage, node_copy_standard_storage);
   ntype.get_compositor_operation = file_ns::get_compositor_operation;
+  ntype.get_compositor_tile_halo = file_ns::get_compositor_tile_halo;
 
   blender::bke::node_register_type(&ntype);
 }
@@ -21,6 +21,7 @@
 #include "UI_resources.hh"
 
 #include "COM_algorithm_gamma_correct.hh"
+#include "COM_algorithm_layered_bokeh_blur.hh"
 #include "COM_algorithm_morphological_blur.hh"
 #include "COM_bokeh_kernel.hh"
 #include "COM_node_operation.hh"
@@ -189,6 +190,13 @@ class DefocusOperation : public NodeOperation {
                    Result &output,
                    const int search_radius)
   {
+#if defined(WITH_FFTW3)
+    if (use_layered_bokeh_blur(search_radius)) {
+      layered_bokeh_blur(this->context(), input, radius, bokeh_kernel, output, search_radius);
+      return;
+    }
+#endif
+
     const Domain domain = compute_domain();
     output.allocate_texture(domain);
 
@@ -548,6 +556,16 @@ static NodeOperation *get_compositor_operation(Context &context, DNode node)
   return new DefocusOperation(context, node);
 }
 
+/* The node reads the camera of the scene when it uses the Z buffer, whose changes can't be
+ * tracked, otherwise, it reads no external data. */
+static std::optional<uint64_t> get_compositor_external_data_hash(Context & /*context*/, DNode node)
+{
+  if (node_storage(*node).no_zbuf) {
+    return 0;
+  }
+  return std::nullopt;
+}
+
 }  // namespace blender::nodes::node_composite_defocus_cc
 
 void register_node_type_cmp_defocus()
@@ -567,6 +585,7 @@ void register_node_type_cmp_defocus()
   blender::bke::node_type_storage(
       &ntype, "NodeDefocus", node_free_standard_storage, node_copy_standard_storage);
   ntype.get_compositor_operation = file_ns::get_compositor_operation;
+  ntype.get_compositor_external_data_hash = file_ns::get_compositor_external_data_hash;
 
   blender::bke::node_register_type(&ntype);
 }
@@ -194,6 +194,12 @@ static NodeOperation *get_compositor_operation(Context &context, DNode node)
   return new DespeckleOperation(context, node);
 }
 
+/* The despeckle reads the 3x3 neighborhood of each pixel. */
+static std::optional<int> get_compositor_tile_halo(const bNode & /*node*/)
+{
+  return 1;
+}
+
 }  // namespace blender::nodes::node_composite_despeckle_cc
 
 void register_node_type_cmp_despeckle()
@@ -214,6 +220,7 @@ void register_node_type_cmp_despeckle()
   ntype.flag |= NODE_PREVIEW;
   ntype.initfunc = file_ns::node_composit_init_despeckle;
   ntype.get_compositor_operation = file_ns::get_compositor_operation;
+  ntype.get_compositor_tile_halo = file_ns::get_compositor_tile_halo;
 
   blender::bke::node_register_type(&ntype);
 }
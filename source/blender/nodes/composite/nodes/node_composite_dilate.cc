@@ -548,6 +548,19 @@ static NodeOperation *get_compositor_operation(Context &context, DNode node)
   return new DilateErodeOperation(context, node);
 }
 
+/* The step and distance methods only read pixels within the distance of each pixel, while the
+ * threshold and feather methods compute distance fields over the whole image. */
+static std::optional<int> get_compositor_tile_halo(const bNode &node)
+{
+  switch (node.custom1) {
+    case CMP_NODE_DILATE_ERODE_STEP:
+    case CMP_NODE_DILATE_ERODE_DISTANCE:
+      return math::abs(int(node.custom2));
+    default:
+      return std::nullopt;
+  }
+}
+
 }  // namespace blender::nodes::node_composite_dilate_cc
 
 void register_node_type_cmp_dilateerode()
@@ -567,6 +580,7 @@ void register_node_type_cmp_dilateerode()
   blender::bke::node_type_storage(
       &ntype, "NodeDilateErode", node_free_standard_storage, node_copy_standard_storage);
   ntype.get_compositor_operation = file_ns::get_compositor_operation;
+  ntype.get_compositor_tile_halo = file_ns::get_compositor_tile_halo;
 
   blender::bke::node_register_type(&ntype);
 }
@@ -239,6 +239,12 @@ static NodeOperation *get_compositor_operation(Context &context, DNode node)
   return new FilterOperation(context, node);
 }
 
+/* The filter reads the 3x3 neighborhood of each pixel. */
+static std::optional<int> get_compositor_tile_halo(const bNode & /*node*/)
+{
+  return 1;
+}
+
 }  // namespace blender::nodes::node_composite_filter_cc
 
 void register_node_type_cmp_filter()
@@ -257,6 +263,7 @@ void register_node_type_cmp_filter()
   ntype.labelfunc = node_filter_label;
   ntype.flag |= NODE_PREVIEW;
   ntype.get_compositor_operation = file_ns::get_compositor_operation;
+  ntype.get_compositor_tile_halo = file_ns::get_compositor_tile_halo;
 
   blender::bke::node_register_type(&ntype);
 }
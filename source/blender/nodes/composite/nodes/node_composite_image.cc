@@ -9,6 +9,7 @@
 #include "node_composite_util.hh"
 
 #include "BLI_assert.h"
+#include "BLI_hash.hh"
 #include "BLI_linklist.h"
 #include "BLI_math_vector_types.hh"
 #include "BLI_string.h"
@@ -812,6 +813,37 @@ static NodeOperation *get_compositor_operation(Context &context, DNode node)
   return new RenderLayerOperation(context, node);
 }
 
+static std::optional<int> get_compositor_tile_halo(const bNode & /*node*/)
+{
+  return 0;
+}
+
+/* The node reads the passes of the render, so identify them by the hashes of the passes of its
+ * linked outputs. */
+static std::optional<uint64_t> get_compositor_external_data_hash(Context &context, DNode node)
+{
+  const Scene *scene = reinterpret_cast<const Scene *>(node->id);
+  const int view_layer = node->custom1;
+
+  uint64_t hash = 0;
+  for (const bNodeSocket *output : node->output_sockets()) {
+    if (!output->is_logically_linked()) {
+      continue;
+    }
+
+    const char *pass_name = STR_ELEM(output->identifier, "Image", "Alpha") ?
+                                RE_PASSNAME_COMBINED :
+                                static_cast<NodeImageLayer *>(output->storage)->pass_name;
+    const std::optional<uint64_t> pass_hash = context.get_pass_hash(scene, view_layer, pass_name);
+    if (!pass_hash) {
+      return std::nullopt;
+    }
+    hash = get_default_hash(hash, *pass_hash);
+  }
+
+  return hash;
+}
+
 }  // namespace blender::nodes::node_composite_render_layer_cc
 
 void register_node_type_cmp_rlayers()
@@ -830,6 +862,8 @@ void register_node_type_cmp_rlayers()
   ntype.initfunc_api = file_ns::node_composit_init_rlayers;
   ntype.poll = file_ns::node_composit_poll_rlayers;
   ntype.get_compositor_operation = file_ns::get_compositor_operation;
+  ntype.get_compositor_tile_halo = file_ns::get_compositor_tile_halo;
+  ntype.get_compositor_external_data_hash = file_ns::get_compositor_external_data_hash;
   ntype.compositor_unsupported_message = N_(
       "Render passes in the Viewport compositor are only supported in EEVEE");
   ntype.flag |= NODE_PREVIEW;
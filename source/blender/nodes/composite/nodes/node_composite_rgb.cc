@@ -46,6 +46,11 @@ static NodeOperation *get_compositor_operation(Context &context, DNode node)
   return new RGBOperation(context, node);
 }
 
+static std::optional<int> get_compositor_tile_halo(const bNode & /*node*/)
+{
+  return 0;
+}
+
 }  // namespace blender::nodes::node_composite_rgb_cc
 
 void register_node_type_cmp_rgb()
@@ -62,6 +67,7 @@ void register_node_type_cmp_rgb()
   ntype.declare = file_ns::cmp_node_rgb_declare;
   blender::bke::node_type_size_preset(&ntype, blender::bke::eNodeSizePreset::Default);
   ntype.get_compositor_operation = file_ns::get_compositor_operation;
+  ntype.get_compositor_tile_halo = file_ns::get_compositor_tile_halo;
 
   blender::bke::node_register_type(&ntype);
 }
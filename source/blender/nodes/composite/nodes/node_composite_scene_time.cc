@@ -49,6 +49,11 @@ static NodeOperation *get_compositor_operation(Context &context, DNode node)
   return new SceneTimeOperation(context, node);
 }
 
+static std::optional<int> get_compositor_tile_halo(const bNode & /*node*/)
+{
+  return 0;
+}
+
 }  // namespace blender::nodes
 
 void register_node_type_cmp_scene_time()
@@ -62,6 +67,7 @@ void register_node_type_cmp_scene_time()
   ntype.nclass = NODE_CLASS_INPUT;
   ntype.declare = blender::nodes::cmp_node_scene_time_declare;
   ntype.get_compositor_operation = blender::nodes::get_compositor_operation;
+  ntype.get_compositor_tile_halo = blender::nodes::get_compositor_tile_halo;
 
   blender::bke::node_register_type(&ntype);
 }
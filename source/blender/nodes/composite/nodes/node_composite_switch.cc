@@ -53,6 +53,11 @@ static NodeOperation *get_compositor_operation(Context &context, DNode node)
   return new SwitchOperation(context, node);
 }
 
+static std::optional<int> get_compositor_tile_halo(const bNode & /*node*/)
+{
+  return 0;
+}
+
 }  // namespace blender::nodes::node_composite_switch_cc
 
 void register_node_type_cmp_switch()
@@ -70,6 +75,7 @@ void register_node_type_cmp_switch()
   ntype.draw_buttons = file_ns::node_composit_buts_switch;
   blender::bke::node_type_size_preset(&ntype, blender::bke::eNodeSizePreset::Default);
   ntype.get_compositor_operation = file_ns::get_compositor_operation;
+  ntype.get_compositor_tile_halo = file_ns::get_compositor_tile_halo;
 
   blender::bke::node_register_type(&ntype);
 }
@@ -404,6 +404,17 @@ bool RE_ReadRenderResult(struct Scene *scene, struct Scene *scenode);
 
 struct RenderResult *RE_MultilayerConvert(
     void *exrhandle, const char *colorspace, bool predivide, int rectx, int recty);
+/**
+ * Read the pixels of the passes of a render result that was converted from an EXR handle whose
+ * pixels were not read, see #IB_multilayer_lazy, from the multilayer EXR file at the given path.
+ * Only the given pass is read if it is not null, otherwise, all passes whose pixels were not read
+ * yet are read at once.
+ */
+bool RE_MultilayerLoadPasses(struct RenderResult *rr,
+                             struct RenderPass *only_rpass,
+                             const char *filepath,
+                             const char *colorspace,
+                             bool predivide);
 
 /* Display and event callbacks. */
 
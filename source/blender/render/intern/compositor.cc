@@ -3,22 +3,33 @@
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
 #include <cstring>
+#include <optional>
 #include <string>
 
+#include <fmt/format.h>
+
+#include "BLI_hash.hh"
+#include "BLI_map.hh"
+#include "BLI_math_vector.hh"
 #include "BLI_math_vector_types.hh"
+#include "BLI_string.h"
 #include "BLI_threads.h"
 #include "BLI_vector.hh"
 
 #include "MEM_guardedalloc.h"
 
 #include "DNA_ID.h"
+#include "DNA_userdef_types.h"
 
 #include "BKE_cryptomatte.hh"
 #include "BKE_global.hh"
 #include "BKE_image.hh"
 #include "BKE_node.hh"
+#include "BKE_node_runtime.hh"
 #include "BKE_scene.hh"
 
+#include "BLT_translation.hh"
+
 #include "DRW_engine.hh"
 #include "DRW_render.hh"
 
@@ -27,7 +38,9 @@
 #include "COM_context.hh"
 #include "COM_domain.hh"
 #include "COM_evaluator.hh"
+#include "COM_node_result_cache.hh"
 #include "COM_render_context.hh"
+#include "COM_tiling.hh"
 
 #include "RE_compositor.hh"
 #include "RE_pipeline.h"
@@ -168,6 +181,25 @@ class Context : public compositor::Context {
   Vector<GPUTexture *> cached_gpu_passes_;
   Vector<ImBuf *> cached_cpu_passes_;
 
+  /* The region of the tile that is currently being evaluated extended by its halo, as well as the
+   * region of the tile itself. Those are only set while the compositor is evaluated in tiles. See
+   * Compositor::execute_tiled. */
+  std::optional<rcti> tile_region_;
+  std::optional<rcti> tile_output_region_;
+
+  /* The cache of the results of nodes across interactive evaluations. See node_result_cache. */
+  compositor::NodeResultCache node_result_cache_;
+
+  /* The passes that were identified for the node result cache in the current and the previous
+   * evaluations, mapped to their unique identifiers. Their reference counts are incremented such
+   * that their pointers can't be reused by other passes while they are identified, and the
+   * passes of the previous evaluation that are not identified again are released at the end of
+   * the evaluation, getting new identifiers if they are ever allocated at the same address again.
+   * See get_pass_hash. */
+  Map<ImBuf *, uint64_t> hashed_passes_;
+  Map<ImBuf *, uint64_t> previous_hashed_passes_;
+  uint64_t hashed_passes_count_ = 0;
+
  public:
   Context(const ContextInputData &input_data, TexturePool &texture_pool)
       : compositor::Context(texture_pool),
@@ -187,6 +219,13 @@ class Context : public compositor::Context {
     for (ImBuf *pass : cached_cpu_passes_) {
       IMB_freeImBuf(pass);
     }
+    node_result_cache_.clear();
+    for (ImBuf *pass : hashed_passes_.keys()) {
+      IMB_freeImBuf(pass);
+    }
+    for (ImBuf *pass : previous_hashed_passes_.keys()) {
+      IMB_freeImBuf(pass);
+    }
   }
 
   void update_input_data(const ContextInputData &input_data)
@@ -239,12 +278,40 @@ class Context : public compositor::Context {
 
   rcti get_compositing_region() const override
   {
+    if (tile_region_) {
+      return *tile_region_;
+    }
+
     const int2 render_size = get_render_size();
     const rcti render_region = rcti{0, render_size.x, 0, render_size.y};
 
     return render_region;
   }
 
+  rcti get_output_region() const override
+  {
+    if (tile_output_region_) {
+      return *tile_output_region_;
+    }
+
+    return this->get_compositing_region();
+  }
+
+  /* Limit the evaluation of the compositor to the given tile, where the region includes the halo
+   * needed to compute the tile and the output region is the tile itself. */
+  void set_tile(const rcti &region, const rcti &output_region)
+  {
+    tile_region_ = region;
+    tile_output_region_ = output_region;
+  }
+
+  /* Evaluate the compositor on the whole render region again. */
+  void clear_tile()
+  {
+    tile_region_.reset();
+    tile_output_region_.reset();
+  }
+
   compositor::Result get_output_result() override
   {
     const int2 render_size = get_render_size();
@@ -355,6 +422,77 @@ class Context : public compositor::Context {
     return pass;
   }
 
+  std::optional<uint64_t> get_pass_hash(const Scene *scene,
+                                        int view_layer_id,
+                                        const char *pass_name) override
+  {
+    /* Passes are written in place while rendering, so they can't be identified by their
+     * buffers. */
+    if (G.is_rendering) {
+      return std::nullopt;
+    }
+
+    if (!scene) {
+      return 0;
+    }
+
+    ViewLayer *view_layer = static_cast<ViewLayer *>(
+        BLI_findlink(&scene->view_layers, view_layer_id));
+    if (!view_layer) {
+      return 0;
+    }
+
+    Render *render = RE_GetSceneRender(scene);
+    if (!render) {
+      return 0;
+    }
+
+    RenderResult *render_result = RE_AcquireResultRead(render);
+    if (!render_result) {
+      RE_ReleaseResult(render);
+      return 0;
+    }
+
+    RenderLayer *render_layer = RE_GetRenderLayer(render_result, view_layer->name);
+    if (!render_layer) {
+      RE_ReleaseResult(render);
+      return 0;
+    }
+
+    RenderPass *render_pass = RE_pass_find_by_name(
+        render_layer, pass_name, this->get_view_name().data());
+    if (!render_pass || !render_pass->ibuf || !render_pass->ibuf->float_buffer.data) {
+      RE_ReleaseResult(render);
+      return 0;
+    }
+
+    ImBuf *pass = render_pass->ibuf;
+    RE_ReleaseResult(render);
+
+    const uint64_t identifier = hashed_passes_.lookup_or_add_cb(pass, [&]() {
+      /* The pass was already identified in the previous evaluation and still holds a reference. */
+      if (const std::optional<uint64_t> identifier = previous_hashed_passes_.pop_try(pass)) {
+        return *identifier;
+      }
+      IMB_refImBuf(pass);
+      return ++hashed_passes_count_;
+    });
+
+    return get_default_hash(identifier, pass->x, pass->y, render_pass->channels);
+  }
+
+  /* Release the passes that were identified in the previous evaluation but not in the current
+   * one, then consider the passes of the current evaluation the previous ones for the next
+   * evaluation. */
+  void release_previous_hashed_passes()
+  {
+    for (ImBuf *pass : previous_hashed_passes_.keys()) {
+      IMB_freeImBuf(pass);
+    }
+    previous_hashed_passes_ = std::move(hashed_passes_);
+    hashed_passes_.clear();
+  }
+
   StringRef get_view_name() const override
   {
     return input_data_.view_name;
@@ -600,6 +738,28 @@ class Context : public compositor::Context {
     return input_data_.profiler;
   }
 
+  /* Only interactive evaluations use the node result cache, since final renders are evaluated
+   * once and tiled evaluations only compute a part of the results. */
+  compositor::NodeResultCache *node_result_cache() override
+  {
+    if (this->render_context() || tile_region_) {
+      return nullptr;
+    }
+
+    return &node_result_cache_;
+  }
+
+  /* Update the memory limit of the node result cache from the user preferences. */
+  void update_node_result_cache_limit()
+  {
+    node_result_cache_.set_limit(int64_t(U.compositor_cache_limit) * 1024 * 1024);
+  }
+
+  const compositor::NodeResultCache &get_node_result_cache() const
+  {
+    return node_result_cache_;
+  }
+
   void evaluate_operation_post() const override
   {
     /* If no render context exist, that means this is an interactive compositor evaluation due to
@@ -633,6 +793,10 @@ class Compositor {
   bool uses_gpu_;
   compositor::ResultPrecision used_precision_;
 
+  /* The size of the tiles that the CPU compositor is evaluated in for large renders. See
+   * execute_tiled. */
+  static constexpr int tile_size = 2048;
+
  public:
   Compositor(Render &render, const ContextInputData &input_data) : render_(render)
   {
@@ -699,13 +863,23 @@ class Compositor {
       }
     }
 
-    /* Always recreate the evaluator, as this only runs on compositing node changes and
-     * there is no reason to cache this. Unlike the viewport where it helps for navigation. */
-    {
+    context_->reset_peak_memory_usage();
+    context_->update_node_result_cache_limit();
+
+    const std::optional<int> tile_halo = this->compute_tile_halo();
+    if (tile_halo) {
+      this->execute_tiled(*tile_halo);
+    }
+    else {
+      /* Always recreate the evaluator, as this only runs on compositing node changes and
+       * there is no reason to cache this. Unlike the viewport where it helps for navigation. */
       compositor::Evaluator evaluator(*context_);
       evaluator.evaluate();
+      context_->release_previous_hashed_passes();
     }
 
+    this->report_memory_usage(tile_halo.has_value());
+
     context_->output_to_render_result();
     context_->viewer_output_to_viewer_image();
     texture_pool_->free_unused_and_reset();
@@ -724,6 +898,109 @@ class Compositor {
     }
   }
 
+  /* Returns the halo of the tiles if the compositor should be evaluated in tiles, otherwise,
+   * returns std::nullopt. Only the CPU compositor is evaluated in tiles, since its intermediate
+   * results can exhaust the system memory for large renders, and only if the render is larger
+   * than a single tile and all nodes can be evaluated in tiles. Node previews are computed from
+   * the whole image, so the compositor is not evaluated in tiles if they are needed. */
+  std::optional<int> compute_tile_halo()
+  {
+    if (context_->use_gpu()) {
+      return std::nullopt;
+    }
+
+    if (bool(context_->needed_outputs() & compositor::OutputTypes::Previews)) {
+      return std::nullopt;
+    }
+
+    const int2 render_size = context_->get_render_size();
+    if (render_size.x <= tile_size && render_size.y <= tile_size) {
+      return std::nullopt;
+    }
+
+    const std::optional<int> tile_halo = compositor::compute_tile_halo(*context_);
+
+    /* Large halos make the tiles overlap too much to be worth it. */
+    if (!tile_halo || *tile_halo > tile_size / 4) {
+      return std::nullopt;
+    }
+
+    return tile_halo;
+  }
+
+  /* Evaluate the compositor on each tile of the render separately, extending the tiles by the
+   * given halo, such that the intermediate results only ever cover a single tile and are freed
+   * before evaluating the next tile, which bounds the memory needed for the intermediate results
+   * regardless of the render size. */
+  void execute_tiled(const int tile_halo)
+  {
+    const bNodeTree &node_tree = context_->get_node_tree();
+    const int2 render_size = context_->get_render_size();
+    const int2 tiles_count = math::divide_ceil(render_size, int2(tile_size));
+    const int total_tiles_count = tiles_count.x * tiles_count.y;
+
+    for (const int y : IndexRange(tiles_count.y)) {
+      for (const int x : IndexRange(tiles_count.x)) {
+        if (context_->is_canceled()) {
+          context_->clear_tile();
+          return;
+        }
+
+        const int tile_index = y * tiles_count.x + x;
+        char message[128];
+        SNPRINTF(message, RPT_("Compositing | Tile %d-%d"), tile_index + 1, total_tiles_count);
+        node_tree.runtime->stats_draw(node_tree.runtime->sdh, message);
+
+        const int2 lower_bound = int2(x, y) * tile_size;
+        const int2 upper_bound = math::min(lower_bound + tile_size, render_size);
+        const int2 halo_lower_bound = math::max(lower_bound - tile_halo, int2(0));
+        const int2 halo_upper_bound = math::min(upper_bound + tile_halo, render_size);
+        context_->set_tile(
+            rcti{halo_lower_bound.x, halo_upper_bound.x, halo_lower_bound.y, halo_upper_bound.y},
+            rcti{lower_bound.x, upper_bound.x, lower_bound.y, upper_bound.y});
+
+        /* Each tile has a different compositing region, so a new evaluator is needed. */
+        compositor::Evaluator evaluator(*context_);
+        evaluator.evaluate();
+
+        node_tree.runtime->progress(node_tree.runtime->prh,
+                                    float(tile_index + 1) / float(total_tiles_count));
+      }
+    }
+
+    context_->clear_tile();
+  }
+
+  /* Report the peak memory used by the intermediate results of the last evaluation, which is
+   * only tracked on the CPU, as well as the statistics of the node result cache if it was used in
+   * the last evaluation, which is not the case for tiled evaluations. */
+  void report_memory_usage(const bool is_tiled)
+  {
+    const bool use_node_result_cache = !is_tiled && context_->node_result_cache() &&
+                                       U.compositor_cache_limit > 0;
+    if (context_->use_gpu() && !use_node_result_cache) {
+      return;
+    }
+
+    std::string message = RPT_("Compositing");
+    if (!context_->use_gpu()) {
+      const float peak_memory_usage = context_->get_peak_memory_usage() / (1024.0f * 1024.0f);
+      message += fmt::format(fmt::runtime(RPT_(" | Intermediate Results Peak {:.2f}M")),
+                             peak_memory_usage);
+    }
+
+    if (use_node_result_cache) {
+      const compositor::NodeResultCache &cache = context_->get_node_result_cache();
+      message += fmt::format(fmt::runtime(RPT_(" | Cached Results {} ({:.2f}M) | Reused {} Nodes")),
+                             cache.entries_count(),
+                             cache.size() / (1024.0f * 1024.0f),
+                             cache.hits_count());
+    }
+
+    const bNodeTree &node_tree = context_->get_node_tree();
+    node_tree.runtime->stats_draw(node_tree.runtime->sdh, message.c_str());
+  }
+
   /* Returns true if the compositor should be freed and reconstructed, which is needed when the
    * compositor execution device or precision changed, because we either need to update all cached
    * and pooled resources for the new execution device and precision, or we simply recreate the
@@ -282,6 +282,15 @@ RenderResult *RE_MultilayerConvert(
   return render_result_new_from_exr(exrhandle, colorspace, predivide, rectx, recty);
 }
 
+bool RE_MultilayerLoadPasses(RenderResult *rr,
+                             RenderPass *only_rpass,
+                             const char *filepath,
+                             const char *colorspace,
+                             bool predivide)
+{
+  return render_result_passes_load_from_exr(rr, only_rpass, filepath, colorspace, predivide);
+}
+
 RenderLayer *render_get_single_layer(Render *re, RenderResult *rr)
 {
   if (re->single_view_layer[0]) {
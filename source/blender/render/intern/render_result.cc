@@ -20,6 +20,7 @@
 #include "BLI_string.h"
 #include "BLI_string_utils.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_appdir.hh"
 #include "BKE_image.hh"
@@ -601,7 +602,10 @@ static void ml_addpass_cb(void *base,
   /* channel id chars */
   STRNCPY(rpass->chan_id, chan_id);
 
-  RE_pass_set_buffer_data(rpass, rect);
+  /* The pixels might not be read yet, see #render_result_passes_load_from_exr. */
+  if (rect) {
+    RE_pass_set_buffer_data(rpass, rect);
+  }
 
   STRNCPY(rpass->name, name);
   STRNCPY(rpass->view, view);
@@ -702,13 +706,33 @@ static int order_render_passes(const void *a, const void *b)
   return (rpa->view_id < rpb->view_id);
 }
 
+/* Convert the pixels of the given pass loaded from an EXR file from the given color space to the
+ * scene linear color space if it stores colors, otherwise, assign it the data color space. */
+static void render_result_pass_colorspace_from_exr(RenderPass *rpass,
+                                                   const char *colorspace,
+                                                   bool predivide)
+{
+  if (RE_RenderPassIsColor(rpass)) {
+    const char *to_colorspace = IMB_colormanagement_role_colorspace_name_get(
+        COLOR_ROLE_SCENE_LINEAR);
+    IMB_colormanagement_transform(rpass->ibuf->float_buffer.data,
+                                  rpass->rectx,
+                                  rpass->recty,
+                                  rpass->channels,
+                                  colorspace,
+                                  to_colorspace,
+                                  predivide);
+  }
+  else {
+    const char *data_colorspace = IMB_colormanagement_role_colorspace_name_get(COLOR_ROLE_DATA);
+    IMB_colormanagement_assign_float_colorspace(rpass->ibuf, data_colorspace);
+  }
+}
+
 RenderResult *render_result_new_from_exr(
     void *exrhandle, const char *colorspace, bool predivide, int rectx, int recty)
 {
   RenderResult *rr = MEM_cnew<RenderResult>(__func__);
-  const char *to_colorspace = IMB_colormanagement_role_colorspace_name_get(
-      COLOR_ROLE_SCENE_LINEAR);
-  const char *data_colorspace = IMB_colormanagement_role_colorspace_name_get(COLOR_ROLE_DATA);
 
   rr->rectx = rectx;
   rr->recty = recty;
@@ -725,17 +749,8 @@ RenderResult *render_result_new_from_exr(
       rpass->rectx = rectx;
       rpass->recty = recty;
 
-      if (RE_RenderPassIsColor(rpass)) {
-        IMB_colormanagement_transform(rpass->ibuf->float_buffer.data,
-                                      rpass->rectx,
-                                      rpass->recty,
-                                      rpass->channels,
-                                      colorspace,
-                                      to_colorspace,
-                                      predivide);
-      }
-      else {
-        IMB_colormanagement_assign_float_colorspace(rpass->ibuf, data_colorspace);
+      if (rpass->ibuf) {
+        render_result_pass_colorspace_from_exr(rpass, colorspace, predivide);
       }
     }
   }
@@ -743,6 +758,55 @@ RenderResult *render_result_new_from_exr(
   return rr;
 }
 
+bool render_result_passes_load_from_exr(RenderResult *rr,
+                                        RenderPass *only_rpass,
+                                        const char *filepath,
+                                        const char *colorspace,
+                                        bool predivide)
+{
+  void *exrhandle = IMB_exr_get_handle();
+  int rectx, recty;
+  /* The file might have changed since the render result was created. */
+  const bool is_valid_file = IMB_exr_begin_read(exrhandle, filepath, &rectx, &recty, true) &&
+                             rectx == rr->rectx && recty == rr->recty;
+  bool success = is_valid_file;
+
+  /* Assign buffers to all passes to load, then read them from the file at once. */
+  blender::Vector<RenderPass *> loaded_passes;
+  LISTBASE_FOREACH (RenderLayer *, rl, &rr->layers) {
+    LISTBASE_FOREACH (RenderPass *, rpass, &rl->passes) {
+      if (rpass->ibuf || (only_rpass && rpass != only_rpass)) {
+        continue;
+      }
+
+      float *rect = static_cast<float *>(MEM_calloc_arrayN(
+          size_t(rpass->rectx) * size_t(rpass->recty), sizeof(float) * rpass->channels, __func__));
+      if (!(is_valid_file &&
+            IMB_exr_pass_assign_rect(
+                exrhandle, rl->name, rpass->name, rpass->view, rpass->channels, rect)))
+      {
+        printf("cannot read pass %s of layer %s from: %s\n", rpass->name, rl->name, filepath);
+        success = false;
+      }
+
+      /* Assign the buffer even if reading fails to avoid reading the pass again. */
+      RE_pass_set_buffer_data(rpass, rect);
+      loaded_passes.append(rpass);
+    }
+  }
+
+  if (is_valid_file) {
+    IMB_exr_read_assigned_passes(exrhandle);
+  }
+  IMB_exr_close(exrhandle);
+
+  for (RenderPass *rpass : loaded_passes) {
+    render_result_pass_colorspace_from_exr(rpass, colorspace, predivide);
+  }
+
+  return success;
+}
+
 void render_result_view_new(RenderResult *rr, const char *viewname)
 {
   RenderView *rv = MEM_cnew<RenderView>("new render view");
@@ -51,6 +51,16 @@ void render_result_passes_allocated_ensure(struct RenderResult *rr);
  */
 struct RenderResult *render_result_new_from_exr(
     void *exrhandle, const char *colorspace, bool predivide, int rectx, int recty);
+/**
+ * Read the pixels of the passes of a render result that was created from an EXR handle that was
+ * not read, see #IB_multilayer_lazy, from the file at the given path. Only the given pass is read
+ * if it is not null, otherwise, all passes whose pixels were not read yet are read at once.
+ */
+bool render_result_passes_load_from_exr(struct RenderResult *rr,
+                                        struct RenderPass *only_rpass,
+                                        const char *filepath,
+                                        const char *colorspace,
+                                        bool predivide);
 
 void render_result_view_new(struct RenderResult *rr, const char *viewname);
 void render_result_views_new(struct RenderResult *rr, const struct RenderData *rd);
@@ -31,6 +31,11 @@ bool SEQ_proxy_rebuild_context(Main *bmain,
                                ListBase *queue,
                                bool build_only_on_bad_performance);
 void SEQ_proxy_rebuild(SeqIndexBuildContext *context, wmJobWorkerStatus *worker_status);
+/**
+ * Build proxies for all #SeqIndexBuildContext in the `queue`. Movie strips are built
+ * concurrently, the number of concurrent builds depends on the number of available threads.
+ */
+void SEQ_proxy_rebuild_queue(ListBase *queue, wmJobWorkerStatus *worker_status);
 void SEQ_proxy_rebuild_finish(SeqIndexBuildContext *context, bool stop);
 void SEQ_proxy_set(Strip *strip, bool value);
 bool SEQ_can_use_proxy(const SeqRenderData *context, const Strip *strip, int psize);
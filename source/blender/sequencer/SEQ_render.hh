@@ -43,6 +43,9 @@ struct SeqRenderData {
   int view_id = 0;
   /* ID of task for assigning temp cache entries to particular task(thread, etc.) */
   eSeqTaskId task_id = SEQ_TASK_MAIN_RENDER;
+  /* Prefetch thread rendering with this context. Each one has its own temp cache entries and
+   * chain of linked cache keys. */
+  int prefetch_thread = 0;
 
   /* special case for OpenGL render */
   GPUOffScreen *gpu_offscreen = nullptr;
@@ -6,10 +6,21 @@
  * \ingroup sequencer
  */
 
+#include <atomic>
 #include <cstddef>
 #include <ctime>
+#include <fcntl.h>
 #include <memory.h>
 
+#ifdef WIN32
+#  include "BLI_winstuff.h"
+#  include <io.h>
+#else
+#  include <unistd.h>
+#endif
+
+#include <zstd.h>
+
 #include "MEM_guardedalloc.h"
 
 #include "DNA_scene_types.h"
@@ -19,17 +30,26 @@
 #include "IMB_imbuf.hh"
 #include "IMB_imbuf_types.hh"
 
+#include "BLI_array.hh"
 #include "BLI_endian_defines.h"
 #include "BLI_endian_switch.h"
 #include "BLI_fileops.h"
 #include "BLI_fileops_types.h"
 #include "BLI_listbase.h"
+#include "BLI_math_base.h"
+#include "BLI_mmap.h"
 #include "BLI_path_utils.hh"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
+#include "BLI_time.h"
+#include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_main.hh"
 
+#include "CLG_log.h"
+
 #include "SEQ_render.hh"
 #include "SEQ_time.hh"
 
@@ -44,7 +64,9 @@
  * For each cached non-temp image, image data and supplementary info are written to HDD.
  * Multiple(DCACHE_IMAGES_PER_FILE) images share the same file.
  * Each of these files contains header DiskCacheHeader followed by image data.
- * ZLIB compression with user definable level can be used to compress image data(per image)
+ * ZSTD compression with user definable level can be used to compress image data(per image).
+ * Large images are compressed as several independent ZSTD frames, so they can be compressed and
+ * decompressed on multiple threads. Files are memory-mapped for reading.
  * Images are written in order in which they are rendered.
  * Overwriting of individual entry is not possible.
  * Stored images are deleted by invalidation, or when size of all files exceeds maximum
@@ -59,6 +81,10 @@
 #define DCACHE_IMAGES_PER_FILE 100
 #define DCACHE_CURRENT_VERSION 2
 #define COLORSPACE_NAME_MAX 64 /* XXX: defined in IMB intern. */
+/* Size of image data compressed into one ZSTD frame. */
+#define DCACHE_COMPRESSION_CHUNK_SIZE (4 * 1024 * 1024)
+
+static CLG_LogRef LOG = {"seq.disk_cache"};
 
 struct DiskCacheHeaderEntry {
   uchar encoding;
@@ -107,6 +133,9 @@ static int seq_disk_cache_compression_level()
   switch (U.sequencer_disk_cache_compression) {
     case USER_SEQ_DISK_CACHE_COMPRESSION_NONE:
       return 0;
+    case USER_SEQ_DISK_CACHE_COMPRESSION_FAST:
+      /* Negative levels trade compression ratio for speed. */
+      return -5;
     case USER_SEQ_DISK_CACHE_COMPRESSION_LOW:
       return 1;
     case USER_SEQ_DISK_CACHE_COMPRESSION_HIGH:
@@ -418,36 +447,141 @@ static size_t deflate_imbuf_to_file(ImBuf *ibuf,
                                     int level,
                                     DiskCacheHeaderEntry *header_entry)
 {
-  void *data = (ibuf->byte_buffer.data != nullptr) ? (void *)ibuf->byte_buffer.data :
-                                                     (void *)ibuf->float_buffer.data;
+  const char *data = (ibuf->byte_buffer.data != nullptr) ?
+                         reinterpret_cast<const char *>(ibuf->byte_buffer.data) :
+                         reinterpret_cast<const char *>(ibuf->float_buffer.data);
+  const size_t size = header_entry->size_raw;
+
+  fseek(file, header_entry->offset, SEEK_SET);
 
   /* Apply compression if wanted, otherwise just write directly to the file. */
-  if (level > 0) {
-    return BLI_file_zstd_from_mem_at_pos(
-        data, header_entry->size_raw, file, header_entry->offset, level);
+  if (level == 0) {
+    return fwrite(data, 1, size, file);
+  }
+
+  /* Compress chunks of the image in parallel. The frames are written one after another, which is
+   * still a valid ZSTD stream. */
+  const int64_t chunks_num = int64_t(divide_ceil_ul(size, DCACHE_COMPRESSION_CHUNK_SIZE));
+  blender::Array<blender::Array<char>> chunks(chunks_num);
+  blender::Array<size_t> chunk_sizes(chunks_num);
+
+  /* Isolate the tasks, the disk cache mutex is held while compressing. */
+  blender::threading::isolate_task([&]() {
+    blender::threading::parallel_for(
+        chunks.index_range(), 1, [&](const blender::IndexRange range) {
+          for (const int64_t i : range) {
+            const size_t offset = size_t(i) * DCACHE_COMPRESSION_CHUNK_SIZE;
+            const size_t chunk_size = std::min<size_t>(DCACHE_COMPRESSION_CHUNK_SIZE,
+                                                       size - offset);
+            chunks[i].reinitialize(ZSTD_compressBound(chunk_size));
+            chunk_sizes[i] = ZSTD_compress(
+                chunks[i].data(), chunks[i].size(), data + offset, chunk_size, level);
+          }
+        });
+  });
+
+  size_t total_written = 0;
+  for (const int64_t i : chunks.index_range()) {
+    if (ZSTD_isError(chunk_sizes[i]) ||
+        fwrite(chunks[i].data(), 1, chunk_sizes[i], file) != chunk_sizes[i])
+    {
+      return 0;
+    }
+    total_written += chunk_sizes[i];
   }
 
-  fseek(file, header_entry->offset, SEEK_SET);
-  return fwrite(data, 1, header_entry->size_raw, file);
+  return total_written;
 }
 
-static size_t inflate_file_to_imbuf(ImBuf *ibuf, FILE *file, DiskCacheHeaderEntry *header_entry)
+static size_t inflate_file_to_imbuf(ImBuf *ibuf,
+                                    BLI_mmap_file *mmap_file,
+                                    const DiskCacheHeaderEntry *header_entry)
 {
-  void *data = (ibuf->byte_buffer.data != nullptr) ? (void *)ibuf->byte_buffer.data :
-                                                     (void *)ibuf->float_buffer.data;
-  char header[4];
-  fseek(file, header_entry->offset, SEEK_SET);
-  if (fread(header, 1, sizeof(header), file) != sizeof(header)) {
+  char *data = (ibuf->byte_buffer.data != nullptr) ?
+                   reinterpret_cast<char *>(ibuf->byte_buffer.data) :
+                   reinterpret_cast<char *>(ibuf->float_buffer.data);
+  const size_t size_raw = header_entry->size_raw;
+  const size_t size_compressed = header_entry->size_compressed;
+
+  if (size_compressed < 4 ||
+      header_entry->offset + size_compressed > BLI_mmap_get_length(mmap_file))
+  {
     return 0;
   }
 
+  /* The compressed data is decompressed straight from the mapped memory. Reading it that way
+   * bypasses the checks of #BLI_mmap_read, so IO errors are checked for once done instead: the
+   * pages that failed to read are zeroed, which may still decompress into a valid image. */
+  const char *compressed = static_cast<const char *>(BLI_mmap_get_pointer(mmap_file)) +
+                           header_entry->offset;
+
   /* Check if the data is compressed or raw. */
-  if (BLI_file_magic_is_zstd(header)) {
-    return BLI_file_unzstd_to_mem_at_pos(data, header_entry->size_raw, file, header_entry->offset);
-  }
+  if (!BLI_file_magic_is_zstd(compressed)) {
+    return BLI_mmap_read(mmap_file, data, header_entry->offset, size_raw) ? size_raw : 0;
+  }
+
+  /* Locate the ZSTD frames, so that they can be decompressed in parallel directly into the image
+   * buffer. */
+  struct Frame {
+    size_t src_offset;
+    size_t src_size;
+    size_t dst_offset;
+    size_t dst_size;
+  };
+  blender::Vector<Frame> frames;
+  size_t src_offset = 0;
+  size_t dst_offset = 0;
+
+  while (src_offset < size_compressed) {
+    const char *src = compressed + src_offset;
+    const size_t src_size = ZSTD_findFrameCompressedSize(src, size_compressed - src_offset);
+    const unsigned long long dst_size = ZSTD_isError(src_size) ?
+                                            ZSTD_CONTENTSIZE_ERROR :
+                                            ZSTD_getFrameContentSize(src, src_size);
+
+    if (ELEM(dst_size, ZSTD_CONTENTSIZE_UNKNOWN, ZSTD_CONTENTSIZE_ERROR) ||
+        dst_offset + dst_size > size_raw)
+    {
+      /* Data streamed without frame sizes, as written by older versions. */
+      const size_t result = ZSTD_decompress(data, size_raw, compressed, size_compressed);
+      return (ZSTD_isError(result) || BLI_mmap_any_io_error(mmap_file)) ? 0 : result;
+    }
 
-  fseek(file, header_entry->offset, SEEK_SET);
-  return fread(data, 1, header_entry->size_raw, file);
+    frames.append({src_offset, src_size, dst_offset, size_t(dst_size)});
+    src_offset += src_size;
+    dst_offset += size_t(dst_size);
+  }
+
+  std::atomic<bool> failed = false;
+  blender::threading::isolate_task([&]() {
+    blender::threading::parallel_for(
+        frames.index_range(), 1, [&](const blender::IndexRange range) {
+          for (const int64_t i : range) {
+            const Frame &frame = frames[i];
+            const size_t result = ZSTD_decompress(data + frame.dst_offset,
+                                                  frame.dst_size,
+                                                  compressed + frame.src_offset,
+                                                  frame.src_size);
+            if (ZSTD_isError(result) || result != frame.dst_size) {
+              failed = true;
+            }
+          }
+        });
+  });
+
+  return (failed || BLI_mmap_any_io_error(mmap_file)) ? 0 : dst_offset;
+}
+
+static void seq_disk_cache_header_endian_switch(DiskCacheHeader *header)
+{
+  for (int i = 0; i < DCACHE_IMAGES_PER_FILE; i++) {
+    if ((ENDIAN_ORDER == B_ENDIAN) && header->entry[i].encoding == 0) {
+      BLI_endian_switch_uint64(&header->entry[i].frameno);
+      BLI_endian_switch_uint64(&header->entry[i].offset);
+      BLI_endian_switch_uint64(&header->entry[i].size_compressed);
+      BLI_endian_switch_uint64(&header->entry[i].size_raw);
+    }
+  }
 }
 
 static bool seq_disk_cache_read_header(FILE *file, DiskCacheHeader *header)
@@ -460,14 +594,7 @@ static bool seq_disk_cache_read_header(FILE *file, DiskCacheHeader *header)
     return false;
   }
 
-  for (int i = 0; i < DCACHE_IMAGES_PER_FILE; i++) {
-    if ((ENDIAN_ORDER == B_ENDIAN) && header->entry[i].encoding == 0) {
-      BLI_endian_switch_uint64(&header->entry[i].frameno);
-      BLI_endian_switch_uint64(&header->entry[i].offset);
-      BLI_endian_switch_uint64(&header->entry[i].size_compressed);
-      BLI_endian_switch_uint64(&header->entry[i].size_raw);
-    }
-  }
+  seq_disk_cache_header_endian_switch(header);
 
   return true;
 }
@@ -574,10 +701,20 @@ bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf
   }
   int entry_index = seq_disk_cache_add_header_entry(key, ibuf, &header);
 
+  const double start_time = BLI_time_now_seconds();
   size_t bytes_written = deflate_imbuf_to_file(
       ibuf, file, seq_disk_cache_compression_level(), &header.entry[entry_index]);
 
   if (bytes_written != 0) {
+    const double time = BLI_time_now_seconds() - start_time;
+    CLOG_INFO(&LOG,
+              1,
+              "Wrote %.2f MB in %.2f ms (%.1f MB/s), compression ratio %.2f",
+              header.entry[entry_index].size_raw / (1024.0 * 1024.0),
+              time * 1000.0,
+              header.entry[entry_index].size_raw / (1024.0 * 1024.0) / std::max(time, 1e-6),
+              double(header.entry[entry_index].size_raw) / bytes_written);
+
     /* Last step is writing header, as image data can be overwritten,
      * but missing data would cause problems.
      */
@@ -604,22 +741,36 @@ ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *key)
   seq_disk_cache_get_file_path(disk_cache, key, filepath, sizeof(filepath));
   BLI_file_ensure_parent_dir_exists(filepath);
 
-  FILE *file = BLI_fopen(filepath, "rb");
-  if (!file) {
+  const int file = BLI_open(filepath, O_BINARY | O_RDONLY, 0);
+  if (file == -1) {
     BLI_mutex_unlock(&disk_cache->read_write_mutex);
     return nullptr;
   }
 
-  if (!seq_disk_cache_read_header(file, &header)) {
-    fclose(file);
+  BLI_mmap_file *mmap_file = BLI_mmap_open(file);
+  if (mmap_file == nullptr) {
+    close(file);
     BLI_mutex_unlock(&disk_cache->read_write_mutex);
     return nullptr;
   }
+
+  auto close_file = [&]() {
+    BLI_mmap_free(mmap_file);
+    close(file);
+  };
+
+  if (!BLI_mmap_read(mmap_file, &header, 0, sizeof(header))) {
+    close_file();
+    BLI_mutex_unlock(&disk_cache->read_write_mutex);
+    return nullptr;
+  }
+  seq_disk_cache_header_endian_switch(&header);
+
   int entry_index = seq_disk_cache_get_header_entry(key, &header);
 
   /* Item not found. */
   if (entry_index < 0) {
-    fclose(file);
+    close_file();
     BLI_mutex_unlock(&disk_cache->read_write_mutex);
     return nullptr;
   }
@@ -642,23 +793,33 @@ ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *key)
     IMB_colormanagement_assign_float_colorspace(ibuf, header.entry[entry_index].colorspace_name);
   }
   else {
-    fclose(file);
+    close_file();
     BLI_mutex_unlock(&disk_cache->read_write_mutex);
     return nullptr;
   }
 
-  size_t bytes_read = inflate_file_to_imbuf(ibuf, file, &header.entry[entry_index]);
+  const double start_time = BLI_time_now_seconds();
+  size_t bytes_read = inflate_file_to_imbuf(ibuf, mmap_file, &header.entry[entry_index]);
+  close_file();
 
   /* Sanity check. */
   if (bytes_read != expected_size) {
-    fclose(file);
     IMB_freeImBuf(ibuf);
     BLI_mutex_unlock(&disk_cache->read_write_mutex);
     return nullptr;
   }
+
+  const double time = BLI_time_now_seconds() - start_time;
+  CLOG_INFO(&LOG,
+            1,
+            "Read %.2f MB in %.2f ms (%.1f MB/s), compression ratio %.2f",
+            expected_size / (1024.0 * 1024.0),
+            time * 1000.0,
+            expected_size / (1024.0 * 1024.0) / std::max(time, 1e-6),
+            double(expected_size) / header.entry[entry_index].size_compressed);
+
   BLI_file_touch(filepath);
   seq_disk_cache_update_file(disk_cache, filepath);
-  fclose(file);
 
   BLI_mutex_unlock(&disk_cache->read_write_mutex);
   return ibuf;
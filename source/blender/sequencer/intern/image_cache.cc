@@ -25,6 +25,8 @@
 
 #include "BKE_main.hh"
 
+#include "MOV_read.hh"
+
 #include "SEQ_prefetch.hh"
 #include "SEQ_relations.hh"
 #include "SEQ_render.hh"
@@ -66,7 +68,9 @@ struct SeqCache {
   ThreadMutex iterator_mutex;
   BLI_mempool *keys_pool;
   BLI_mempool *items_pool;
-  SeqCacheKey *last_key;
+  /* Last key put in the cache by each task, for linking the entries used to render a frame.
+   * Index 0 is the main render, the others are the prefetch threads. */
+  SeqCacheKey *last_key[1 + SEQ_PREFETCH_MAX_WORKERS];
   SeqDiskCache *disk_cache;
 };
 
@@ -77,6 +81,22 @@ struct SeqCacheItem {
 
 static ThreadMutex cache_create_lock = BLI_MUTEX_INITIALIZER;
 
+static SeqCacheKey *&seq_cache_last_key(SeqCache *cache, const SeqRenderData *context)
+{
+  if (context->task_id == SEQ_TASK_MAIN_RENDER) {
+    return cache->last_key[0];
+  }
+  BLI_assert(context->prefetch_thread < SEQ_PREFETCH_MAX_WORKERS);
+  return cache->last_key[1 + context->prefetch_thread];
+}
+
+static void seq_cache_clear_last_keys(SeqCache *cache)
+{
+  for (SeqCacheKey *&last_key : cache->last_key) {
+    last_key = nullptr;
+  }
+}
+
 static bool seq_cmp_render_data(const SeqRenderData *a, const SeqRenderData *b)
 {
   return ((a->preview_render_size != b->preview_render_size) || (a->rectx != b->rectx) ||
@@ -217,10 +237,13 @@ static void seq_cache_put_ex(Scene *scene, SeqCacheKey *key, ImBuf *ibuf)
 
   const int stored_types_flag = get_stored_types_flag(scene, key);
 
+  /* Keys are linked to the previous key put by the same task. */
+  SeqCacheKey *&last_key = seq_cache_last_key(cache, &key->context);
+
   /* Item stored for later use. */
   if (stored_types_flag & key->type) {
     key->is_temp_cache = false;
-    key->link_prev = cache->last_key;
+    key->link_prev = last_key;
   }
 
   BLI_assert(!BLI_ghash_haskey(cache->hash, key));
@@ -228,19 +251,19 @@ static void seq_cache_put_ex(Scene *scene, SeqCacheKey *key, ImBuf *ibuf)
   IMB_refImBuf(ibuf);
 
   /* Store pointer to last cached key. */
-  SeqCacheKey *temp_last_key = cache->last_key;
-  cache->last_key = key;
+  SeqCacheKey *temp_last_key = last_key;
+  last_key = key;
 
   /* Set last_key's reference to this key so we can look up chain backwards.
-   * Item is already put in cache, so cache->last_key points to current key.
+   * Item is already put in cache, so last_key points to current key.
    */
   if (!key->is_temp_cache && temp_last_key) {
-    temp_last_key->link_next = cache->last_key;
+    temp_last_key->link_next = last_key;
   }
 
   /* Reset linking. */
   if (key->type == SEQ_CACHE_STORE_FINAL_OUT) {
-    cache->last_key = nullptr;
+    last_key = nullptr;
   }
 }
 
@@ -355,7 +378,7 @@ static void seq_cache_recycle_linked(Scene *scene, SeqCacheKey *base)
 
     seq_cache_key_unlink(base);
     BLI_ghash_remove(cache->hash, base, seq_cache_keyfree, seq_cache_valfree);
-    BLI_assert(base != cache->last_key);
+    BLI_assert(base != seq_cache_last_key(cache, &base->context));
     base = prev;
   }
 
@@ -374,7 +397,7 @@ static void seq_cache_recycle_linked(Scene *scene, SeqCacheKey *base)
 
     seq_cache_key_unlink(base);
     BLI_ghash_remove(cache->hash, base, seq_cache_keyfree, seq_cache_valfree);
-    BLI_assert(base != cache->last_key);
+    BLI_assert(base != seq_cache_last_key(cache, &base->context));
     base = next;
   }
 }
@@ -493,7 +516,7 @@ static void seq_cache_create(Main *bmain, Scene *scene)
     cache->keys_pool = BLI_mempool_create(sizeof(SeqCacheKey), 0, 64, BLI_MEMPOOL_NOP);
     cache->items_pool = BLI_mempool_create(sizeof(SeqCacheItem), 0, 64, BLI_MEMPOOL_NOP);
     cache->hash = BLI_ghash_new(seq_cache_hashhash, seq_cache_hashcmp, "SeqCache hash");
-    cache->last_key = nullptr;
+    seq_cache_clear_last_keys(cache);
     cache->bmain = bmain;
     BLI_mutex_init(&cache->iterator_mutex);
     scene->ed->cache = cache;
@@ -537,7 +560,7 @@ static SeqCacheKey *seq_cache_allocate_key(SeqCache *cache,
 
 /* ***************************** API ****************************** */
 
-void seq_cache_free_temp_cache(Scene *scene, short id, int timeline_frame)
+void seq_cache_free_temp_cache(Scene *scene, const SeqRenderData *context, int timeline_frame)
 {
   SeqCache *cache = seq_cache_get_from_scene(scene);
   if (!cache) {
@@ -553,7 +576,9 @@ void seq_cache_free_temp_cache(Scene *scene, short id, int timeline_frame)
     BLI_ghashIterator_step(&gh_iter);
     BLI_assert(key->cache_owner == cache);
 
-    if (key->is_temp_cache && key->task_id == id) {
+    if (key->is_temp_cache && key->task_id == context->task_id &&
+        key->context.prefetch_thread == context->prefetch_thread)
+    {
       /* Use frame_index here to avoid freeing raw images if they are used for multiple frames. */
       float frame_index = seq_cache_timeline_frame_to_frame_index(
           scene, key->strip, timeline_frame, key->type);
@@ -561,11 +586,12 @@ void seq_cache_free_temp_cache(Scene *scene, short id, int timeline_frame)
           timeline_frame > SEQ_time_right_handle_frame_get(scene, key->strip) ||
           timeline_frame < SEQ_time_left_handle_frame_get(scene, key->strip))
       {
+        SeqCacheKey *&last_key = seq_cache_last_key(cache, &key->context);
+        if (key == last_key) {
+          last_key = nullptr;
+        }
         seq_cache_key_unlink(key);
         BLI_ghash_remove(cache->hash, key, seq_cache_keyfree, seq_cache_valfree);
-        if (key == cache->last_key) {
-          cache->last_key = nullptr;
-        }
       }
     }
   }
@@ -614,7 +640,7 @@ void SEQ_cache_cleanup(Scene *scene)
     /* NOTE: no need to call #seq_cache_key_unlink as all keys are removed. */
     BLI_ghash_remove(cache->hash, key, seq_cache_keyfree, seq_cache_valfree);
   }
-  cache->last_key = nullptr;
+  seq_cache_clear_last_keys(cache);
   seq_cache_unlock(scene);
 }
 
@@ -679,7 +705,7 @@ void seq_cache_cleanup_sequence(Scene *scene,
       BLI_ghash_remove(cache->hash, key, seq_cache_keyfree, seq_cache_valfree);
     }
   }
-  cache->last_key = nullptr;
+  seq_cache_clear_last_keys(cache);
   seq_cache_unlock(scene);
 }
 
@@ -740,8 +766,11 @@ ImBuf *seq_cache_get(const SeqRenderData *context, Strip *strip, float timeline_
 
     /* Store read image in RAM. Only recycle item for final type. */
     if (key.type != SEQ_CACHE_STORE_FINAL_OUT || seq_cache_recycle_item(scene)) {
+      /* Prefetch threads may be putting their entries at the same time. */
+      seq_cache_lock(scene);
       SeqCacheKey *new_key = seq_cache_allocate_key(cache, context, strip, timeline_frame, type);
       seq_cache_put_ex(scene, new_key, ibuf);
+      seq_cache_unlock(scene);
     }
   }
 
@@ -769,8 +798,11 @@ bool seq_cache_put_if_possible(
   }
 
   if (scene->ed->cache) {
-    seq_cache_set_temp_cache_linked(scene, scene->ed->cache->last_key);
-    scene->ed->cache->last_key = nullptr;
+    seq_cache_lock(scene);
+    SeqCacheKey *&last_key = seq_cache_last_key(scene->ed->cache, context);
+    seq_cache_set_temp_cache_linked(scene, last_key);
+    last_key = nullptr;
+    seq_cache_unlock(scene);
   }
 
   return false;
@@ -866,11 +898,13 @@ void SEQ_cache_iterate(
     interrupt = callback_iter(userdata, key->strip, timeline_frame, key->type);
   }
 
-  cache->last_key = nullptr;
+  seq_cache_clear_last_keys(cache);
   seq_cache_unlock(scene);
 }
 
 bool seq_cache_is_full()
 {
-  return seq_cache_get_mem_total() < MEM_get_memory_in_use();
+  /* Decoded movie frames are kept to speed up seeking within strips, count them too. All movies
+   * share one budget, see #MOV_set_decode_cache_budget. */
+  return seq_cache_get_mem_total() < MEM_get_memory_in_use() + MOV_get_decode_cache_memory_total();
 }
@@ -42,7 +42,11 @@ bool seq_cache_put_if_possible(
  * Sources(other types) for a frame must be freed all at once.
  */
 bool seq_cache_recycle_item(Scene *scene);
-void seq_cache_free_temp_cache(Scene *scene, short id, int timeline_frame);
+/**
+ * Free temporary entries of the task rendering with the given context which are not used by the
+ * given frame.
+ */
+void seq_cache_free_temp_cache(Scene *scene, const SeqRenderData *context, int timeline_frame);
 void seq_cache_destruct(Scene *scene);
 void seq_cache_cleanup_sequence(Scene *scene,
                                 Strip *strip,
@@ -18,8 +18,10 @@
 #include "DNA_sequence_types.h"
 #include "DNA_space_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_listbase.h"
 #include "BLI_threads.h"
+#include "BLI_time.h"
 #include "BLI_vector_set.hh"
 
 #include "IMB_imbuf.hh"
@@ -43,10 +45,33 @@
 #include "SEQ_render.hh"
 #include "SEQ_sequencer.hh"
 
+#include "CLG_log.h"
+
 #include "image_cache.hh"
 #include "prefetch.hh"
 #include "render.hh"
 
+static CLG_LogRef LOG = {"seq.prefetch"};
+
+struct PrefetchJob;
+
+/**
+ * Renders prefetched frames on its own thread. Every worker evaluates its own copy of the scene,
+ * so that several frames can be rendered at the same time.
+ */
+struct PrefetchWorker {
+  PrefetchJob *pfjob = nullptr;
+
+  Scene *scene_eval = nullptr;
+  Depsgraph *depsgraph = nullptr;
+  SeqRenderData context_cpy = {};
+  /* Context of the original scene which the cache entries rendered by this worker use. */
+  SeqRenderData context = {};
+
+  /* Frame that is being rendered. */
+  float cfra = 0.0f;
+};
+
 struct PrefetchJob {
   PrefetchJob *next = nullptr;
   PrefetchJob *prev = nullptr;
@@ -54,26 +79,33 @@ struct PrefetchJob {
   Main *bmain = nullptr;
   Main *bmain_eval = nullptr;
   Scene *scene = nullptr;
-  Scene *scene_eval = nullptr;
-  Depsgraph *depsgraph = nullptr;
 
   ThreadMutex prefetch_suspend_mutex = {};
   ThreadCondition prefetch_suspend_cond = {};
 
   ListBase threads = {};
+  blender::Array<PrefetchWorker> workers;
+  /* Number of workers used by the current run, the others have no depsgraph. */
+  int num_workers = 0;
 
   /* context */
   SeqRenderData context = {};
-  SeqRenderData context_cpy = {};
   ListBase *seqbasep = nullptr;
   ListBase *seqbasep_cpy = nullptr;
 
   /* prefetch area */
   float cfra = 0.0f;
+  /* Frames after `cfra` which are rendered or being rendered by a worker. */
   int num_frames_prefetched = 0;
 
+  /* Statistics, to report the achieved frame rate. */
+  int num_frames_rendered = 0;
+  double render_start_time = 0.0;
+
   /* Control: */
-  /* Set by prefetch. */
+  /* Set by prefetch, counters are protected by `prefetch_suspend_mutex`. */
+  int num_workers_running = 0;
+  int num_workers_waiting = 0;
   bool running = false;
   bool waiting = false;
   bool stop = false;
@@ -150,7 +182,17 @@ SeqRenderData *seq_prefetch_get_original_context(const SeqRenderData *context)
 {
   PrefetchJob *pfjob = seq_prefetch_job_get(context->scene);
 
-  return &pfjob->context;
+  return &pfjob->workers[context->prefetch_thread].context;
+}
+
+bool seq_prefetch_is_parallel_render(const SeqRenderData *context)
+{
+  if (!context->is_prefetch_render) {
+    return false;
+  }
+
+  PrefetchJob *pfjob = seq_prefetch_job_get(context->scene);
+  return pfjob && pfjob->num_workers > 1;
 }
 
 static bool seq_prefetch_is_cache_full(Scene *scene)
@@ -168,9 +210,19 @@ static float seq_prefetch_cfra(PrefetchJob *pfjob)
 {
   return pfjob->cfra + pfjob->num_frames_prefetched;
 }
-static AnimationEvalContext seq_prefetch_anim_eval_context(PrefetchJob *pfjob)
+static AnimationEvalContext seq_prefetch_anim_eval_context(PrefetchWorker *worker)
+{
+  return BKE_animsys_eval_context_construct(worker->depsgraph, worker->cfra);
+}
+
+static int seq_prefetch_num_workers(const Scene *scene)
 {
-  return BKE_animsys_eval_context_construct(pfjob->depsgraph, seq_prefetch_cfra(pfjob));
+  if ((scene->ed->cache_flag & SEQ_CACHE_PREFETCH_MULTI_FRAME) == 0) {
+    return 1;
+  }
+
+  /* Rendering a frame is multi-threaded already, leave threads for that. */
+  return std::clamp(BLI_system_thread_count() / 4, 1, SEQ_PREFETCH_MAX_WORKERS);
 }
 
 void seq_prefetch_get_time_range(Scene *scene, int *r_start, int *r_end)
@@ -181,37 +233,39 @@ void seq_prefetch_get_time_range(Scene *scene, int *r_start, int *r_end)
   *r_end = seq_prefetch_cfra(pfjob);
 }
 
-static void seq_prefetch_free_depsgraph(PrefetchJob *pfjob)
+static void seq_prefetch_free_depsgraph(PrefetchWorker *worker)
 {
-  if (pfjob->depsgraph != nullptr) {
-    DEG_graph_free(pfjob->depsgraph);
+  if (worker->depsgraph != nullptr) {
+    DEG_graph_free(worker->depsgraph);
   }
-  pfjob->depsgraph = nullptr;
-  pfjob->scene_eval = nullptr;
+  worker->depsgraph = nullptr;
+  worker->scene_eval = nullptr;
 }
 
-static void seq_prefetch_update_depsgraph(PrefetchJob *pfjob)
+static void seq_prefetch_update_depsgraph(PrefetchWorker *worker)
 {
-  DEG_evaluate_on_framechange(pfjob->depsgraph, seq_prefetch_cfra(pfjob));
+  DEG_evaluate_on_framechange(worker->depsgraph, worker->cfra);
 }
 
-static void seq_prefetch_init_depsgraph(PrefetchJob *pfjob)
+static void seq_prefetch_init_depsgraph(PrefetchWorker *worker)
 {
+  PrefetchJob *pfjob = worker->pfjob;
   Main *bmain = pfjob->bmain_eval;
   Scene *scene = pfjob->scene;
   ViewLayer *view_layer = BKE_view_layer_default_render(scene);
 
-  pfjob->depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_RENDER);
-  DEG_debug_name_set(pfjob->depsgraph, "SEQUENCER PREFETCH");
+  worker->depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_RENDER);
+  DEG_debug_name_set(worker->depsgraph, "SEQUENCER PREFETCH");
 
   /* Make sure there is a correct evaluated scene pointer. */
-  DEG_graph_build_for_render_pipeline(pfjob->depsgraph);
+  DEG_graph_build_for_render_pipeline(worker->depsgraph);
 
   /* Update immediately so we have proper evaluated scene. */
-  seq_prefetch_update_depsgraph(pfjob);
+  worker->cfra = seq_prefetch_cfra(pfjob);
+  seq_prefetch_update_depsgraph(worker);
 
-  pfjob->scene_eval = DEG_get_evaluated_scene(pfjob->depsgraph);
-  pfjob->scene_eval->ed->cache_flag = 0;
+  worker->scene_eval = DEG_get_evaluated_scene(worker->depsgraph);
+  worker->scene_eval->ed->cache_flag = 0;
 }
 
 static void seq_prefetch_update_area(PrefetchJob *pfjob)
@@ -256,7 +310,7 @@ void SEQ_prefetch_stop(Scene *scene)
   pfjob->stop = true;
 
   while (pfjob->running) {
-    BLI_condition_notify_one(&pfjob->prefetch_suspend_cond);
+    BLI_condition_notify_all(&pfjob->prefetch_suspend_cond);
   }
 }
 
@@ -265,19 +319,23 @@ static void seq_prefetch_update_context(const SeqRenderData *context)
   PrefetchJob *pfjob;
   pfjob = seq_prefetch_job_get(context->scene);
 
-  SEQ_render_new_render_data(pfjob->bmain_eval,
-                             pfjob->depsgraph,
-                             pfjob->scene_eval,
-                             context->rectx,
-                             context->recty,
-                             context->preview_render_size,
-                             false,
-                             &pfjob->context_cpy);
-  pfjob->context_cpy.is_prefetch_render = true;
-  pfjob->context_cpy.task_id = SEQ_TASK_PREFETCH_RENDER;
+  for (const int i : blender::IndexRange(pfjob->num_workers)) {
+    PrefetchWorker &worker = pfjob->workers[i];
+    SEQ_render_new_render_data(pfjob->bmain_eval,
+                               worker.depsgraph,
+                               worker.scene_eval,
+                               context->rectx,
+                               context->recty,
+                               context->preview_render_size,
+                               false,
+                               &worker.context_cpy);
+    worker.context_cpy.is_prefetch_render = true;
+    worker.context_cpy.task_id = SEQ_TASK_PREFETCH_RENDER;
+    worker.context_cpy.prefetch_thread = i;
+  }
 
   SEQ_render_new_render_data(pfjob->bmain,
-                             pfjob->depsgraph,
+                             pfjob->workers[0].depsgraph,
                              pfjob->scene,
                              context->rectx,
                              context->recty,
@@ -291,6 +349,13 @@ static void seq_prefetch_update_context(const SeqRenderData *context)
    * This is to allow "temp cache" work correctly for both threads.
    */
   pfjob->context.task_id = SEQ_TASK_PREFETCH_RENDER;
+
+  /* Every worker links and frees its cache entries separately from the other workers. */
+  for (const int i : blender::IndexRange(pfjob->num_workers)) {
+    PrefetchWorker &worker = pfjob->workers[i];
+    worker.context = pfjob->context;
+    worker.context.prefetch_thread = i;
+  }
 }
 
 static void seq_prefetch_update_scene(Scene *scene)
@@ -302,21 +367,30 @@ static void seq_prefetch_update_scene(Scene *scene)
   }
 
   pfjob->scene = scene;
-  seq_prefetch_free_depsgraph(pfjob);
-  seq_prefetch_init_depsgraph(pfjob);
+  for (const int i : pfjob->workers.index_range()) {
+    PrefetchWorker &worker = pfjob->workers[i];
+    seq_prefetch_free_depsgraph(&worker);
+    if (i < pfjob->num_workers) {
+      seq_prefetch_init_depsgraph(&worker);
+    }
+  }
 }
 
 static void seq_prefetch_update_active_seqbase(PrefetchJob *pfjob)
 {
   MetaStack *ms_orig = SEQ_meta_stack_active_get(SEQ_editing_get(pfjob->scene));
-  Editing *ed_eval = SEQ_editing_get(pfjob->scene_eval);
 
-  if (ms_orig != nullptr) {
-    Strip *meta_eval = seq_prefetch_get_original_sequence(ms_orig->parseq, pfjob->scene_eval);
-    SEQ_seqbase_active_set(ed_eval, &meta_eval->seqbase);
-  }
-  else {
-    SEQ_seqbase_active_set(ed_eval, &ed_eval->seqbase);
+  for (const int i : blender::IndexRange(pfjob->num_workers)) {
+    Scene *scene_eval = pfjob->workers[i].scene_eval;
+    Editing *ed_eval = SEQ_editing_get(scene_eval);
+
+    if (ms_orig != nullptr) {
+      Strip *meta_eval = seq_prefetch_get_original_sequence(ms_orig->parseq, scene_eval);
+      SEQ_seqbase_active_set(ed_eval, &meta_eval->seqbase);
+    }
+    else {
+      SEQ_seqbase_active_set(ed_eval, &ed_eval->seqbase);
+    }
   }
 }
 
@@ -324,8 +398,8 @@ static void seq_prefetch_resume(Scene *scene)
 {
   PrefetchJob *pfjob = seq_prefetch_job_get(scene);
 
-  if (pfjob && pfjob->waiting) {
-    BLI_condition_notify_one(&pfjob->prefetch_suspend_cond);
+  if (pfjob && pfjob->num_workers_waiting > 0) {
+    BLI_condition_notify_all(&pfjob->prefetch_suspend_cond);
   }
 }
 
@@ -338,22 +412,24 @@ void seq_prefetch_free(Scene *scene)
 
   SEQ_prefetch_stop(scene);
 
-  BLI_threadpool_remove(&pfjob->threads, pfjob);
+  BLI_threadpool_clear(&pfjob->threads);
   BLI_threadpool_end(&pfjob->threads);
   BLI_mutex_end(&pfjob->prefetch_suspend_mutex);
   BLI_condition_end(&pfjob->prefetch_suspend_cond);
-  seq_prefetch_free_depsgraph(pfjob);
+  for (PrefetchWorker &worker : pfjob->workers) {
+    seq_prefetch_free_depsgraph(&worker);
+  }
   BKE_main_free(pfjob->bmain_eval);
   scene->ed->prefetch_job = nullptr;
   MEM_delete(pfjob);
 }
 
-static bool seq_prefetch_seq_has_disk_cache(PrefetchJob *pfjob,
+static bool seq_prefetch_seq_has_disk_cache(PrefetchWorker *worker,
                                             Strip *strip,
                                             bool can_have_final_image)
 {
-  SeqRenderData *ctx = &pfjob->context_cpy;
-  float cfra = seq_prefetch_cfra(pfjob);
+  SeqRenderData *ctx = &worker->context_cpy;
+  float cfra = worker->cfra;
 
   ImBuf *ibuf = seq_cache_get(ctx, strip, cfra, SEQ_CACHE_STORE_PREPROCESSED);
   if (ibuf != nullptr) {
@@ -380,28 +456,28 @@ static bool seq_prefetch_seq_has_disk_cache(PrefetchJob *pfjob,
   return false;
 }
 
-static bool seq_prefetch_scene_strip_is_rendered(PrefetchJob *pfjob,
+static bool seq_prefetch_scene_strip_is_rendered(PrefetchWorker *worker,
                                                  ListBase *channels,
                                                  ListBase *seqbase,
                                                  blender::Span<Strip *> scene_strips,
                                                  bool is_recursive_check)
 {
-  float cfra = seq_prefetch_cfra(pfjob);
+  float cfra = worker->cfra;
   blender::Vector<Strip *> strips = seq_get_shown_sequences(
-      pfjob->scene_eval, channels, seqbase, cfra, 0);
+      worker->scene_eval, channels, seqbase, cfra, 0);
 
   /* Iterate over rendered strips. */
   for (Strip *strip : strips) {
     if (strip->type == STRIP_TYPE_META &&
         seq_prefetch_scene_strip_is_rendered(
-            pfjob, &strip->channels, &strip->seqbase, scene_strips, true))
+            worker, &strip->channels, &strip->seqbase, scene_strips, true))
     {
       return true;
     }
 
     /* Disable prefetching 3D scene strips, but check for disk cache. */
     if (strip->type == STRIP_TYPE_SCENE && (strip->flag & SEQ_SCENE_STRIPS) == 0 &&
-        !seq_prefetch_seq_has_disk_cache(pfjob, strip, !is_recursive_check))
+        !seq_prefetch_seq_has_disk_cache(worker, strip, !is_recursive_check))
     {
       return true;
     }
@@ -429,10 +505,12 @@ static blender::VectorSet<Strip *> query_scene_strips(ListBase *seqbase)
 
 /* Prefetch must avoid rendering scene strips, because rendering in background locks UI and can
  * make it unresponsive for long time periods. */
-static bool seq_prefetch_must_skip_frame(PrefetchJob *pfjob, ListBase *channels, ListBase *seqbase)
+static bool seq_prefetch_must_skip_frame(PrefetchWorker *worker,
+                                         ListBase *channels,
+                                         ListBase *seqbase)
 {
   blender::VectorSet<Strip *> scene_strips = query_scene_strips(seqbase);
-  if (seq_prefetch_scene_strip_is_rendered(pfjob, channels, seqbase, scene_strips, false)) {
+  if (seq_prefetch_scene_strip_is_rendered(worker, channels, seqbase, scene_strips, false)) {
     return true;
   }
   return false;
@@ -441,7 +519,25 @@ static bool seq_prefetch_must_skip_frame(PrefetchJob *pfjob, ListBase *channels,
 static bool seq_prefetch_need_suspend(PrefetchJob *pfjob)
 {
   return seq_prefetch_is_cache_full(pfjob->scene) || pfjob->is_scrubbing ||
-         (seq_prefetch_cfra(pfjob) >= pfjob->scene->r.efra);
+         (seq_prefetch_cfra(pfjob) > pfjob->scene->r.efra);
+}
+
+static void seq_prefetch_report_frame_rate(PrefetchJob *pfjob)
+{
+  if (pfjob->num_frames_rendered == 0) {
+    return;
+  }
+
+  const double time = BLI_time_now_seconds() - pfjob->render_start_time;
+  CLOG_INFO(&LOG,
+            1,
+            "%d frames prefetched in %.2f s (%.2f frames/s) using %d threads",
+            pfjob->num_frames_rendered,
+            time,
+            pfjob->num_frames_rendered / std::max(time, 1e-6),
+            pfjob->num_workers);
+
+  pfjob->num_frames_rendered = 0;
 }
 
 static void seq_prefetch_do_suspend(PrefetchJob *pfjob)
@@ -450,26 +546,57 @@ static void seq_prefetch_do_suspend(PrefetchJob *pfjob)
   while (seq_prefetch_need_suspend(pfjob) &&
          (pfjob->scene->ed->cache_flag & SEQ_CACHE_PREFETCH_ENABLE) && !pfjob->stop)
   {
-    pfjob->waiting = true;
+    pfjob->num_workers_waiting++;
+    pfjob->waiting = pfjob->num_workers_waiting == pfjob->num_workers_running;
+    if (pfjob->waiting) {
+      seq_prefetch_report_frame_rate(pfjob);
+    }
+
     BLI_condition_wait(&pfjob->prefetch_suspend_cond, &pfjob->prefetch_suspend_mutex);
+
+    if (pfjob->waiting) {
+      pfjob->render_start_time = BLI_time_now_seconds();
+    }
+    pfjob->num_workers_waiting--;
+    pfjob->waiting = false;
     seq_prefetch_update_area(pfjob);
   }
-  pfjob->waiting = false;
   BLI_mutex_unlock(&pfjob->prefetch_suspend_mutex);
 }
 
+/**
+ * Pick the next frame for the worker to render. Frames are handed out in order, so the ones
+ * closest to the playhead are rendered first.
+ */
+static bool seq_prefetch_claim_frame(PrefetchWorker *worker)
+{
+  PrefetchJob *pfjob = worker->pfjob;
+
+  BLI_mutex_lock(&pfjob->prefetch_suspend_mutex);
+  seq_prefetch_update_area(pfjob);
+  const bool has_frame = seq_prefetch_cfra(pfjob) <= pfjob->scene->r.efra;
+  if (has_frame) {
+    worker->cfra = seq_prefetch_cfra(pfjob);
+    pfjob->num_frames_prefetched++;
+  }
+  BLI_mutex_unlock(&pfjob->prefetch_suspend_mutex);
+
+  return has_frame;
+}
+
 static void *seq_prefetch_frames(void *job)
 {
-  PrefetchJob *pfjob = (PrefetchJob *)job;
+  PrefetchWorker *worker = static_cast<PrefetchWorker *>(job);
+  PrefetchJob *pfjob = worker->pfjob;
 
-  while (seq_prefetch_cfra(pfjob) <= pfjob->scene->r.efra) {
-    pfjob->scene_eval->ed->prefetch_job = nullptr;
+  while (seq_prefetch_claim_frame(worker)) {
+    worker->scene_eval->ed->prefetch_job = nullptr;
 
-    seq_prefetch_update_depsgraph(pfjob);
-    AnimData *adt = BKE_animdata_from_id(&pfjob->context_cpy.scene->id);
-    AnimationEvalContext anim_eval_context = seq_prefetch_anim_eval_context(pfjob);
+    seq_prefetch_update_depsgraph(worker);
+    AnimData *adt = BKE_animdata_from_id(&worker->context_cpy.scene->id);
+    AnimationEvalContext anim_eval_context = seq_prefetch_anim_eval_context(worker);
     BKE_animsys_evaluate_animdata(
-        &pfjob->context_cpy.scene->id, adt, &anim_eval_context, ADT_RECALC_ALL, false);
+        &worker->context_cpy.scene->id, adt, &anim_eval_context, ADT_RECALC_ALL, false);
 
     /* This is quite hacky solution:
      * We need cross-reference original scene with copy for cache.
@@ -477,12 +604,11 @@ static void *seq_prefetch_frames(void *job)
      * Scene copy don't reference original scene. Perhaps, this could be done by depsgraph.
      * Set to nullptr before return!
      */
-    pfjob->scene_eval->ed->prefetch_job = pfjob;
+    worker->scene_eval->ed->prefetch_job = pfjob;
 
-    ListBase *seqbase = SEQ_active_seqbase_get(SEQ_editing_get(pfjob->scene_eval));
-    ListBase *channels = SEQ_channels_displayed_get(SEQ_editing_get(pfjob->scene_eval));
-    if (seq_prefetch_must_skip_frame(pfjob, channels, seqbase)) {
-      pfjob->num_frames_prefetched++;
+    ListBase *seqbase = SEQ_active_seqbase_get(SEQ_editing_get(worker->scene_eval));
+    ListBase *channels = SEQ_channels_displayed_get(SEQ_editing_get(worker->scene_eval));
+    if (seq_prefetch_must_skip_frame(worker, channels, seqbase)) {
       /* Break instead of keep looping if the job should be terminated. */
       if (!(pfjob->scene->ed->cache_flag & SEQ_CACHE_PREFETCH_ENABLE) || pfjob->stop) {
         break;
@@ -490,30 +616,44 @@ static void *seq_prefetch_frames(void *job)
       continue;
     }
 
-    ImBuf *ibuf = SEQ_render_give_ibuf(&pfjob->context_cpy, seq_prefetch_cfra(pfjob), 0);
-    seq_cache_free_temp_cache(pfjob->scene, pfjob->context.task_id, seq_prefetch_cfra(pfjob));
+    ImBuf *ibuf = SEQ_render_give_ibuf(&worker->context_cpy, worker->cfra, 0);
+    seq_cache_free_temp_cache(pfjob->scene, &worker->context, worker->cfra);
     IMB_freeImBuf(ibuf);
 
+    BLI_mutex_lock(&pfjob->prefetch_suspend_mutex);
+    pfjob->num_frames_rendered++;
+    BLI_mutex_unlock(&pfjob->prefetch_suspend_mutex);
+
     /* Suspend thread if there is nothing to be prefetched. */
     seq_prefetch_do_suspend(pfjob);
 
     /* Avoid "collision" with main thread, but make sure to fetch at least few frames */
-    if (pfjob->num_frames_prefetched > 5 && (seq_prefetch_cfra(pfjob) - pfjob->scene->r.cfra) < 2)
-    {
+    if (pfjob->num_frames_prefetched > 5 && (worker->cfra - pfjob->scene->r.cfra) < 2) {
       break;
     }
 
     if (!(pfjob->scene->ed->cache_flag & SEQ_CACHE_PREFETCH_ENABLE) || pfjob->stop) {
       break;
     }
+  }
 
-    seq_prefetch_update_area(pfjob);
-    pfjob->num_frames_prefetched++;
+  worker->scene_eval->ed->prefetch_job = nullptr;
+
+  seq_cache_free_temp_cache(pfjob->scene, &worker->context, worker->cfra);
+
+  BLI_mutex_lock(&pfjob->prefetch_suspend_mutex);
+  pfjob->num_workers_running--;
+  const bool is_last_worker = pfjob->num_workers_running == 0;
+  pfjob->waiting = !is_last_worker &&
+                   pfjob->num_workers_waiting == pfjob->num_workers_running;
+  if (is_last_worker) {
+    seq_prefetch_report_frame_rate(pfjob);
   }
+  BLI_mutex_unlock(&pfjob->prefetch_suspend_mutex);
 
-  seq_cache_free_temp_cache(pfjob->scene, pfjob->context.task_id, seq_prefetch_cfra(pfjob));
-  pfjob->running = false;
-  pfjob->scene_eval->ed->prefetch_job = nullptr;
+  if (is_last_worker) {
+    pfjob->running = false;
+  }
 
   return nullptr;
 }
@@ -529,19 +669,30 @@ static PrefetchJob *seq_prefetch_start_ex(const SeqRenderData *context, float cf
     pfjob = MEM_new<PrefetchJob>("PrefetchJob");
     context->scene->ed->prefetch_job = pfjob;
 
-    BLI_threadpool_init(&pfjob->threads, seq_prefetch_frames, 1);
+    BLI_threadpool_init(&pfjob->threads, seq_prefetch_frames, SEQ_PREFETCH_MAX_WORKERS);
     BLI_mutex_init(&pfjob->prefetch_suspend_mutex);
     BLI_condition_init(&pfjob->prefetch_suspend_cond);
 
     pfjob->bmain_eval = BKE_main_new();
     pfjob->scene = context->scene;
-    seq_prefetch_init_depsgraph(pfjob);
+    pfjob->workers.reinitialize(SEQ_PREFETCH_MAX_WORKERS);
+    for (PrefetchWorker &worker : pfjob->workers) {
+      worker.pfjob = pfjob;
+    }
   }
   pfjob->bmain = context->bmain;
 
   pfjob->cfra = cfra;
   pfjob->num_frames_prefetched = 1;
+  pfjob->num_frames_rendered = 0;
+  pfjob->render_start_time = BLI_time_now_seconds();
 
+  /* Previous threads have finished, see #seq_prefetch_start. */
+  BLI_threadpool_clear(&pfjob->threads);
+
+  pfjob->num_workers = seq_prefetch_num_workers(context->scene);
+  pfjob->num_workers_running = pfjob->num_workers;
+  pfjob->num_workers_waiting = 0;
   pfjob->waiting = false;
   pfjob->stop = false;
   pfjob->running = true;
@@ -550,8 +701,9 @@ static PrefetchJob *seq_prefetch_start_ex(const SeqRenderData *context, float cf
   seq_prefetch_update_context(context);
   seq_prefetch_update_active_seqbase(pfjob);
 
-  BLI_threadpool_remove(&pfjob->threads, pfjob);
-  BLI_threadpool_insert(&pfjob->threads, pfjob);
+  for (const int i : blender::IndexRange(pfjob->num_workers)) {
+    BLI_threadpool_insert(&pfjob->threads, &pfjob->workers[i]);
+  }
 
   return pfjob;
 }
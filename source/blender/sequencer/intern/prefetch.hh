@@ -12,6 +12,9 @@ struct Scene;
 struct SeqRenderData;
 struct Strip;
 
+/* Upper limit of frames rendered at the same time with multi-frame prefetching. */
+#define SEQ_PREFETCH_MAX_WORKERS 8
+
 /**
  * Start or resume prefetching.
  */
@@ -23,6 +26,11 @@ void seq_prefetch_get_time_range(Scene *scene, int *r_start, int *r_end);
  * For cache context swapping.
  */
 SeqRenderData *seq_prefetch_get_original_context(const SeqRenderData *context);
+/**
+ * Multi-frame prefetching renders on separate copies of the scene, which do not need to wait for
+ * other renders to finish.
+ */
+bool seq_prefetch_is_parallel_render(const SeqRenderData *context);
 /**
  * For cache context swapping.
  */
@@ -8,16 +8,23 @@
  * \ingroup bke
  */
 
+#include <algorithm>
+#include <atomic>
+
 #include "MEM_guardedalloc.h"
 
 #include "DNA_scene_types.h"
 #include "DNA_sequence_types.h"
 #include "DNA_space_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_fileops.h"
 #include "BLI_listbase.h"
 #include "BLI_path_utils.hh"
 #include "BLI_string.h"
+#include "BLI_threads.h"
+#include "BLI_time.h"
+#include "BLI_vector.hh"
 
 #ifdef WIN32
 #  include "BLI_winstuff.h"
@@ -38,6 +45,8 @@
 
 #include "MOV_read.hh"
 
+#include "CLG_log.h"
+
 #include "SEQ_proxy.hh"
 #include "SEQ_relations.hh"
 #include "SEQ_render.hh"
@@ -50,6 +59,12 @@
 #include "sequencer.hh"
 #include "utils.hh"
 
+static CLG_LogRef LOG = {"seq.proxy"};
+
+/* Maximum number of movie strips for which proxies are built at the same time. FFmpeg decoders
+ * and encoders are multi-threaded already, so a few concurrent builders saturate the CPU. */
+#define SEQ_PROXY_MAX_CONCURRENT_BUILDS 4
+
 struct SeqIndexBuildContext {
   MovieProxyBuilder *proxy_builder;
 
@@ -285,7 +300,7 @@ static void seq_proxy_build_frame(const SeqRenderData *context,
   int recty = (proxy_render_size * ibuf_tmp->y) / 100;
 
   if (ibuf_tmp->x != rectx || ibuf_tmp->y != recty) {
-    ibuf = IMB_scale_into_new(ibuf_tmp, rectx, recty, IMBScaleFilter::Nearest, true);
+    ibuf = IMB_scale_into_new(ibuf_tmp, rectx, recty, IMBScaleFilter::Nearest);
     IMB_freeImBuf(ibuf_tmp);
   }
   else {
@@ -576,6 +591,126 @@ void SEQ_proxy_rebuild(SeqIndexBuildContext *context, wmJobWorkerStatus *worker_
   }
 }
 
+struct SeqProxyBuildQueue {
+  blender::Vector<SeqIndexBuildContext *> contexts;
+  /* Status of every context, so progress can be gathered from all running builders. */
+  blender::Array<wmJobWorkerStatus> statuses;
+  std::atomic<int> next_context = 0;
+  std::atomic<int> contexts_done = 0;
+};
+
+static void seq_proxy_rebuild_timed(SeqIndexBuildContext *context,
+                                    wmJobWorkerStatus *worker_status)
+{
+  const double start_time = BLI_time_now_seconds();
+  SEQ_proxy_rebuild(context, worker_status);
+  const double time = BLI_time_now_seconds() - start_time;
+
+  CLOG_INFO(&LOG,
+            1,
+            "Built proxies for \"%s\": %d frames in %.2f s (%.1f fps)",
+            context->orig_seq->name + 2,
+            context->strip->len,
+            time,
+            context->strip->len / std::max(time, 1e-6));
+}
+
+static void *seq_proxy_rebuild_thread(void *data)
+{
+  SeqProxyBuildQueue *queue = static_cast<SeqProxyBuildQueue *>(data);
+
+  while (true) {
+    const int index = queue->next_context++;
+    if (index >= queue->contexts.size()) {
+      break;
+    }
+    wmJobWorkerStatus *status = &queue->statuses[index];
+    if (!status->stop) {
+      seq_proxy_rebuild_timed(queue->contexts[index], status);
+    }
+    status->progress = 1.0f;
+    queue->contexts_done++;
+  }
+
+  return nullptr;
+}
+
+void SEQ_proxy_rebuild_queue(ListBase *queue, wmJobWorkerStatus *worker_status)
+{
+  const double start_time = BLI_time_now_seconds();
+
+  /* Movie strips are decoded once by their own FFmpeg builder and are independent of each other,
+   * so they are built concurrently. Other strips are rendered through the sequencer and are built
+   * one after another. */
+  SeqProxyBuildQueue movie_queue;
+  blender::Vector<SeqIndexBuildContext *> render_contexts;
+  LISTBASE_FOREACH (LinkData *, link, queue) {
+    SeqIndexBuildContext *context = static_cast<SeqIndexBuildContext *>(link->data);
+    if (context->proxy_builder) {
+      movie_queue.contexts.append(context);
+    }
+    else {
+      render_contexts.append(context);
+    }
+  }
+
+  const int contexts_num = movie_queue.contexts.size() + render_contexts.size();
+  if (contexts_num == 0) {
+    return;
+  }
+
+  if (!movie_queue.contexts.is_empty()) {
+    movie_queue.statuses.reinitialize(movie_queue.contexts.size());
+    movie_queue.statuses.fill({});
+
+    const int threads_num = std::min<int>(
+        {int(movie_queue.contexts.size()),
+         std::max(BLI_system_thread_count() / 4, 1),
+         SEQ_PROXY_MAX_CONCURRENT_BUILDS});
+
+    ListBase threads;
+    BLI_threadpool_init(&threads, seq_proxy_rebuild_thread, threads_num);
+    for (int i = 0; i < threads_num; i++) {
+      BLI_threadpool_insert(&threads, &movie_queue);
+    }
+
+    /* Gather progress and forward stop requests until all movie strips are done. */
+    while (movie_queue.contexts_done < movie_queue.contexts.size()) {
+      BLI_time_sleep_ms(50);
+
+      const bool stop = worker_status->stop || G.is_break;
+      float progress = 0.0f;
+      for (wmJobWorkerStatus &status : movie_queue.statuses) {
+        status.stop |= stop;
+        progress += status.progress;
+      }
+      worker_status->progress = progress / contexts_num;
+      worker_status->do_update = true;
+    }
+
+    BLI_threadpool_end(&threads);
+  }
+
+  for (const int i : render_contexts.index_range()) {
+    if (worker_status->stop || G.is_break) {
+      break;
+    }
+
+    wmJobWorkerStatus status = {};
+    status.stop = worker_status->stop;
+    seq_proxy_rebuild_timed(render_contexts[i], &status);
+
+    worker_status->progress = float(movie_queue.contexts.size() + i + 1) / contexts_num;
+    worker_status->do_update = true;
+  }
+
+  CLOG_INFO(&LOG,
+            1,
+            "Built proxies for %d strips in %.2f s",
+            contexts_num,
+            BLI_time_now_seconds() - start_time);
+}
+
 void SEQ_proxy_rebuild_finish(SeqIndexBuildContext *context, bool stop)
 {
   if (context->proxy_builder) {
@@ -17,6 +17,7 @@
 #include "DNA_scene_types.h"
 #include "DNA_sequence_types.h"
 #include "DNA_space_types.h"
+#include "DNA_userdef_types.h"
 
 #include "BLI_linklist.h"
 #include "BLI_listbase.h"
@@ -1066,6 +1067,17 @@ static IMB_Timecode_Type seq_render_movie_strip_timecode_get(Strip *strip)
                                                 IMB_TC_NONE);
 }
 
+/**
+ * Keep decoded frames of movies, so that seeking backward does not have to decode the group of
+ * pictures again. All movies share one budget, a quarter of the memory cache limit, which the
+ * sequencer cache counts as used. Final renders only go forward, so they don't keep frames.
+ */
+static void seq_movie_decode_cache_update(const SeqRenderData *context, MovieReader *anim)
+{
+  MOV_set_decode_cache_budget(size_t(U.memcachelimit) * 1024 * 1024 / 4);
+  MOV_set_use_decode_cache(anim, !context->for_render);
+}
+
 /**
  * Render individual view for multi-view or single (default view) for mono-view.
  */
@@ -1080,6 +1092,9 @@ static ImBuf *seq_render_movie_strip_view(const SeqRenderData *context,
   const int frame_index = round_fl_to_int(
       SEQ_give_frame_index(context->scene, strip, timeline_frame));
 
+  /* Updated on every frame, to follow changes of the limit in the preferences. */
+  seq_movie_decode_cache_update(context, sanim->anim);
+
   if (SEQ_can_use_proxy(context, strip, psize)) {
     /* Try to get a proxy image.
      * Movie proxies are handled by ImBuf module with exception of `custom file` setting. */
@@ -2038,12 +2053,15 @@ ImBuf *SEQ_render_give_ibuf(const SeqRenderData *context, float timeline_frame,
     out = seq_cache_get(context, strips.last(), timeline_frame, SEQ_CACHE_STORE_FINAL_OUT);
   }
 
-  seq_cache_free_temp_cache(context->scene, context->task_id, timeline_frame);
+  seq_cache_free_temp_cache(context->scene, context, timeline_frame);
   /* Make sure we only keep the `anim` data for strips that are in view. */
   SEQ_relations_free_all_anim_ibufs(context->scene, timeline_frame);
 
   if (!strips.is_empty() && !out) {
-    BLI_mutex_lock(&seq_render_mutex);
+    const bool use_render_mutex = !seq_prefetch_is_parallel_render(context);
+    if (use_render_mutex) {
+      BLI_mutex_lock(&seq_render_mutex);
+    }
     out = seq_render_strip_stack(context, &state, channels, seqbasep, timeline_frame, chanshown);
 
     if (context->is_prefetch_render) {
@@ -2053,7 +2071,9 @@ ImBuf *SEQ_render_give_ibuf(const SeqRenderData *context, float timeline_frame,
       seq_cache_put_if_possible(
           context, strips.last(), timeline_frame, SEQ_CACHE_STORE_FINAL_OUT, out);
     }
-    BLI_mutex_unlock(&seq_render_mutex);
+    if (use_render_mutex) {
+      BLI_mutex_unlock(&seq_render_mutex);
+    }
   }
 
   seq_prefetch_start(context, timeline_frame);
@@ -231,7 +231,7 @@ static void scale_to_thumbnail_size(ImBuf *ibuf)
   int width = ibuf->x;
   int height = ibuf->y;
   image_size_to_thumb_size(width, height);
-  IMB_scale(ibuf, width, height, IMBScaleFilter::Nearest, false);
+  IMB_scale(ibuf, width, height, IMBScaleFilter::Nearest);
 }
 
 /* Background job that processes in-flight thumbnail requests. */
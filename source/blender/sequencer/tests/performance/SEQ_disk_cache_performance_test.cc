@@ -0,0 +1,206 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include <cstdio>
+#include <string>
+
+#include "BLI_fileops.h"
+#include "BLI_fileops_types.h"
+#include "BLI_path_utils.hh"
+#include "BLI_rand.hh"
+#include "BLI_string.h"
+#include "BLI_system.h"
+#include "BLI_tempfile.h"
+#include "BLI_time.h"
+#include "BLI_vector.hh"
+
+#include "BKE_main.hh"
+
+#include "DNA_scene_types.h"
+#include "DNA_sequence_types.h"
+#include "DNA_userdef_types.h"
+
+#include "IMB_imbuf.hh"
+#include "IMB_imbuf_types.hh"
+
+#include "disk_cache.hh"
+#include "image_cache.hh"
+
+#include BLI_SYSTEM_PID_H
+
+namespace blender::seq::tests {
+
+static constexpr int IMAGE_X = 1920;
+static constexpr int IMAGE_Y = 1080;
+static constexpr int FRAMES_NUM = 16;
+
+/* Smooth gradients with a bit of noise, to get compression ratios closer to rendered footage than
+ * a constant or random image would. */
+static ImBuf *create_frame(const bool use_float, const int frame)
+{
+  ImBuf *ibuf = IMB_allocImBuf(IMAGE_X, IMAGE_Y, 32, use_float ? IB_rectfloat : IB_rect);
+  RandomNumberGenerator rng(frame);
+  for (int y = 0; y < IMAGE_Y; y++) {
+    for (int x = 0; x < IMAGE_X; x++) {
+      const size_t index = (size_t(y) * IMAGE_X + x) * 4;
+      const float color[4] = {float(x) / IMAGE_X + rng.get_float() * 0.02f,
+                              float(y) / IMAGE_Y + rng.get_float() * 0.02f,
+                              float((x + frame * 16) % IMAGE_X) / IMAGE_X,
+                              1.0f};
+      for (int c = 0; c < 4; c++) {
+        if (use_float) {
+          ibuf->float_buffer.data[index + c] = color[c];
+        }
+        else {
+          ibuf->byte_buffer.data[index + c] = uchar(std::min(color[c], 1.0f) * 255.0f);
+        }
+      }
+    }
+  }
+  return ibuf;
+}
+
+static int64_t directory_size(const char *dirpath)
+{
+  direntry *filelist;
+  const uint filelist_num = BLI_filelist_dir_contents(dirpath, &filelist);
+  int64_t size = 0;
+  for (uint i = 0; i < filelist_num; i++) {
+    if (FILENAME_IS_CURRPAR(filelist[i].relname)) {
+      continue;
+    }
+    size += S_ISDIR(filelist[i].type) ? directory_size(filelist[i].path) : filelist[i].s.st_size;
+  }
+  BLI_filelist_free(filelist, filelist_num);
+  return size;
+}
+
+class DiskCachePerformanceTest : public testing::Test {
+ public:
+  std::string temp_dir;
+
+  static void SetUpTestSuite()
+  {
+    IMB_init();
+  }
+
+  static void TearDownTestSuite()
+  {
+    IMB_exit();
+  }
+
+  void SetUp() override
+  {
+    char temp_dir_c[FILE_MAX];
+    BLI_temp_directory_path_get(temp_dir_c, sizeof(temp_dir_c));
+    temp_dir = std::string(temp_dir_c) + SEP_STR + "blender_seq_disk_cache_test_" +
+               std::to_string(getpid()) + SEP_STR;
+    BLI_dir_create_recursive(temp_dir.c_str());
+  }
+
+  void TearDown() override
+  {
+    if (BLI_exists(temp_dir.c_str())) {
+      BLI_delete(temp_dir.c_str(), true, true);
+    }
+  }
+
+  /* Write and read back frames through the disk cache with the given compression, and print the
+   * throughput relative to the uncompressed image size. The frames are read right after they were
+   * written, so they are likely to come from the page cache of the OS: the read numbers measure
+   * the decompression rather than the storage device. */
+  void run(const char *name, const int compression, const bool use_float)
+  {
+    /* Separate directory per run, so that the size of the files can be measured. */
+    const std::string cache_dir = temp_dir + name + SEP_STR;
+    STRNCPY(U.sequencer_disk_cache_dir, cache_dir.c_str());
+    U.sequencer_disk_cache_compression = compression;
+
+    Main *bmain = BKE_main_new();
+    BLI_path_join(bmain->filepath, sizeof(bmain->filepath), temp_dir.c_str(), "perf.blend");
+
+    Editing ed = {nullptr};
+    Scene scene = {{nullptr}};
+    STRNCPY(scene.id.name, "SCScene");
+    scene.ed = &ed;
+    Strip strip = {nullptr};
+    STRNCPY(strip.name, "SQStrip");
+
+    SeqDiskCache *disk_cache = seq_disk_cache_create(bmain, &scene);
+
+    SeqCacheKey key = {};
+    key.strip = &strip;
+    key.context.bmain = bmain;
+    key.context.scene = &scene;
+    key.context.rectx = IMAGE_X;
+    key.context.recty = IMAGE_Y;
+    key.context.preview_render_size = 100;
+    key.type = SEQ_CACHE_STORE_FINAL_OUT;
+
+    Vector<ImBuf *> frames;
+    for (int frame = 0; frame < FRAMES_NUM; frame++) {
+      frames.append(create_frame(use_float, frame));
+    }
+    const size_t frame_size = size_t(IMAGE_X) * IMAGE_Y * (use_float ? 16 : 4);
+    const double total_mb = double(frame_size) * FRAMES_NUM / (1024.0 * 1024.0);
+
+    double start_time = BLI_time_now_seconds();
+    for (int frame = 0; frame < FRAMES_NUM; frame++) {
+      key.frame_index = frame;
+      EXPECT_TRUE(seq_disk_cache_write_file(disk_cache, &key, frames[frame]));
+    }
+    const double write_time = BLI_time_now_seconds() - start_time;
+
+    start_time = BLI_time_now_seconds();
+    for (int frame = 0; frame < FRAMES_NUM; frame++) {
+      key.frame_index = frame;
+      ImBuf *ibuf = seq_disk_cache_read_file(disk_cache, &key);
+      ASSERT_NE(ibuf, nullptr);
+      if (frame == 0) {
+        const void *expected = use_float ? (void *)frames[frame]->float_buffer.data :
+                                           (void *)frames[frame]->byte_buffer.data;
+        const void *result = use_float ? (void *)ibuf->float_buffer.data :
+                                         (void *)ibuf->byte_buffer.data;
+        EXPECT_EQ(memcmp(expected, result, frame_size), 0);
+      }
+      IMB_freeImBuf(ibuf);
+    }
+    const double read_time = BLI_time_now_seconds() - start_time;
+
+    const int64_t disk_size = directory_size(cache_dir.c_str());
+    printf("%-4s: write %.1f MB/s, read %.1f MB/s, ratio %.2f\n",
+           name,
+           total_mb / write_time,
+           total_mb / read_time,
+           double(frame_size) * FRAMES_NUM / double(disk_size));
+
+    for (ImBuf *ibuf : frames) {
+      IMB_freeImBuf(ibuf);
+    }
+    seq_disk_cache_free(disk_cache);
+    BKE_main_free(bmain);
+  }
+
+  void run_all_codecs(const bool use_float)
+  {
+    run("none", USER_SEQ_DISK_CACHE_COMPRESSION_NONE, use_float);
+    run("fast", USER_SEQ_DISK_CACHE_COMPRESSION_FAST, use_float);
+    run("low", USER_SEQ_DISK_CACHE_COMPRESSION_LOW, use_float);
+    run("high", USER_SEQ_DISK_CACHE_COMPRESSION_HIGH, use_float);
+  }
+};
+
+TEST_F(DiskCachePerformanceTest, codecs_byte)
+{
+  run_all_codecs(false);
+}
+
+TEST_F(DiskCachePerformanceTest, codecs_float)
+{
+  run_all_codecs(true);
+}
+
+}  // namespace blender::seq::tests
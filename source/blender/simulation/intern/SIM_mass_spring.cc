@@ -18,6 +18,7 @@
 #include "BLI_math_geom.h"
 #include "BLI_math_vector.h"
 #include "BLI_math_vector.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "BKE_cloth.hh"
@@ -951,7 +952,6 @@ static void cloth_continuum_step(ClothModifierData *clmd, float dt)
   Cloth *cloth = clmd->clothObject;
   Implicit_Data *data = cloth->implicit;
   int mvert_num = cloth->mvert_num;
-  ClothVertex *vert;
 
   const float fluid_factor = 0.95f; /* blend between PIC and FLIP methods */
   float smoothfac = parms->velocity_smooth;
@@ -961,7 +961,6 @@ static void cloth_continuum_step(ClothModifierData *clmd, float dt)
   float density_target = parms->density_target;
   float density_strength = parms->density_strength;
   blender::float3 gmin, gmax;
-  int i;
 
   /* clear grid info */
   zero_v3_int(clmd->hair_grid_res);
@@ -981,20 +980,23 @@ static void cloth_continuum_step(ClothModifierData *clmd, float dt)
     /* main hair continuum solver */
     SIM_hair_volume_solve_divergence(grid, dt, density_target, density_strength);
 
-    for (i = 0, vert = cloth->verts; i < mvert_num; i++, vert++) {
-      float x[3], v[3], nv[3];
+    blender::threading::parallel_for(
+        blender::IndexRange(mvert_num), 1024, [&](const blender::IndexRange range) {
+          for (const int i : range) {
+            float x[3], v[3], nv[3];
 
-      /* calculate volumetric velocity influence */
-      SIM_mass_spring_get_position(data, i, x);
-      SIM_mass_spring_get_new_velocity(data, i, v);
+            /* calculate volumetric velocity influence */
+            SIM_mass_spring_get_position(data, i, x);
+            SIM_mass_spring_get_new_velocity(data, i, v);
 
-      SIM_hair_volume_grid_velocity(grid, x, v, fluid_factor, nv);
+            SIM_hair_volume_grid_velocity(grid, x, v, fluid_factor, nv);
 
-      interp_v3_v3v3(nv, v, nv, smoothfac);
+            interp_v3_v3v3(nv, v, nv, smoothfac);
 
-      /* apply on hair data */
-      SIM_mass_spring_set_new_velocity(data, i, nv);
-    }
+            /* apply on hair data */
+            SIM_mass_spring_set_new_velocity(data, i, nv);
+          }
+        });
 
     /* store basic grid info in the modifier data */
     SIM_hair_volume_grid_geometry(grid,
@@ -8,12 +8,24 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_math_matrix.h"
 #include "BLI_math_vector.h"
+#include "BLI_math_vector_types.hh"
+#include "BLI_offset_indices.hh"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
 
-#include "eigen_utils.h"
 #include "implicit.h"
 
+using blender::Array;
+using blender::float3;
+using blender::IndexRange;
+using blender::MutableSpan;
+using blender::OffsetIndices;
+using blender::Span;
+using blender::Vector;
+
 /* ================ Volumetric Hair Interaction ================
  * adapted from
  *
@@ -57,11 +69,20 @@ struct HairGridVert {
   float velocity_smooth[3];
 };
 
+/** Hair segment in grid space, buffered until the grid is normalized. */
+struct HairGridSegment {
+  float3 x2, v2;
+  float3 x3, v3;
+};
+
 struct HairGrid {
   HairGridVert *verts;
   int res[3];
   float gmin[3], gmax[3];
   float cellsize, inv_cellsize;
+
+  /** Segments added since the last normalization, see #SIM_hair_volume_add_segment. */
+  Vector<HairGridSegment> segments;
 };
 
 #define HAIR_GRID_INDEX_AXIS(vec, res, gmin, scale, axis) \
@@ -284,6 +305,7 @@ void SIM_hair_volume_grid_clear(HairGrid *grid)
     grid->verts[i].density = 0.0f;
     grid->verts[i].samples = 0;
   }
+  grid->segments.clear();
 }
 
 BLI_INLINE bool hair_grid_point_valid(const float vec[3], const float gmin[3], const float gmax[3])
@@ -627,8 +649,25 @@ void SIM_hair_volume_add_segment(HairGrid *grid,
                                  const float /*dir2*/[3],
                                  const float /*dir3*/[3])
 {
-  /* XXX simplified test implementation using a series of discrete sample along the segment,
-   * instead of finding the closest point for all affected grid vertices. */
+  /* Splatting is deferred to #SIM_hair_volume_normalize_vertex_grid,
+   * so that all segments can be added to the grid in parallel. */
+  grid->segments.append({float3(x2), float3(v2), float3(x3), float3(v3)});
+}
+
+/* Splat all buffered segments into the grid.
+ *
+ * XXX simplified test implementation using a series of discrete sample along the segment,
+ * instead of finding the closest point for all affected grid vertices.
+ *
+ * Each sample affects a 5x5x5 neighborhood of grid vertices. Segments are sorted into buckets by
+ * the lowest Z layer they affect, and threads then own disjoint ranges of Z layers, computing the
+ * samples of all segments that reach their layers. A grid vertex thus always receives its
+ * contributions in the same order, independent of the number of threads, which keeps the result
+ * deterministic without per-thread grids or atomics.
+ */
+static void hair_volume_splat_segments(HairGrid *grid)
+{
+  using namespace blender;
 
   const float radius = 1.5f;
   const float dist_scale = grid->inv_cellsize;
@@ -637,47 +676,95 @@ void SIM_hair_volume_add_segment(HairGrid *grid,
   const int stride[3] = {1, res[0], res[0] * res[1]};
   const int num_samples = 10;
 
-  int s;
-
-  for (s = 0; s < num_samples; s++) {
-    float x[3], v[3];
-    int i, j, k;
-
-    float f = float(s) / float(num_samples - 1);
-    interp_v3_v3v3(x, x2, x3, f);
-    interp_v3_v3v3(v, v2, v3, f);
-
-    int imin = max_ii(floor_int(x[0]) - 2, 0);
-    int imax = min_ii(floor_int(x[0]) + 2, res[0] - 1);
-    int jmin = max_ii(floor_int(x[1]) - 2, 0);
-    int jmax = min_ii(floor_int(x[1]) + 2, res[1] - 1);
-    int kmin = max_ii(floor_int(x[2]) - 2, 0);
-    int kmax = min_ii(floor_int(x[2]) + 2, res[2] - 1);
+  const Span<HairGridSegment> segments = grid->segments;
+  if (segments.is_empty()) {
+    return;
+  }
 
-    for (k = kmin; k <= kmax; k++) {
-      for (j = jmin; j <= jmax; j++) {
-        for (i = imin; i <= imax; i++) {
-          float loc[3] = {float(i), float(j), float(k)};
-          HairGridVert *vert = grid->verts + i * stride[0] + j * stride[1] + k * stride[2];
+  /* Range of Z layers affected by the samples of a segment, empty if it is outside the grid.
+   * Samples are interpolated linearly, so they lie in between the end points. */
+  auto segment_layers = [&](const HairGridSegment &segment) {
+    const int kmin = max_ii(floor_int(min_ff(segment.x2[2], segment.x3[2])) - 2, 0);
+    const int kmax = min_ii(floor_int(max_ff(segment.x2[2], segment.x3[2])) + 2, res[2] - 1);
+    return IndexRange::from_begin_end_inclusive(kmin, max_ii(kmax, kmin - 1));
+  };
+
+  /* Bucket segments by their lowest affected Z layer, segments outside the grid are skipped. */
+  Array<int> bucket_offsets(res[2] + 1, 0);
+  int max_layers_num = 0;
+  for (const HairGridSegment &segment : segments) {
+    const IndexRange layers = segment_layers(segment);
+    if (!layers.is_empty()) {
+      bucket_offsets[layers.first()]++;
+      max_layers_num = max_ii(max_layers_num, int(layers.size()));
+    }
+  }
+  const OffsetIndices<int> buckets = offset_indices::accumulate_counts_to_offsets(bucket_offsets);
+  Array<int> bucket_segments(buckets.total_size());
+  {
+    Array<int> bucket_fill(res[2], 0);
+    for (const int segment_i : segments.index_range()) {
+      const IndexRange layers = segment_layers(segments[segment_i]);
+      if (!layers.is_empty()) {
+        const int bucket = int(layers.first());
+        bucket_segments[buckets[bucket].start() + bucket_fill[bucket]++] = segment_i;
+      }
+    }
+  }
 
-          hair_volume_eval_grid_vertex_sample(vert, loc, radius, dist_scale, x, v);
+  threading::parallel_for(IndexRange(res[2]), 8, [&](const IndexRange layers) {
+    /* Segments affect at most #max_layers_num layers, starting from their bucket layer. */
+    const IndexRange layer_buckets = IndexRange::from_begin_end(
+        max_ii(int(layers.first()) - max_layers_num + 1, 0), layers.one_after_last());
+    for (const int segment_i : bucket_segments.as_span().slice(buckets[layer_buckets])) {
+      const HairGridSegment &segment = segments[segment_i];
+      if (segment_layers(segment).intersect(layers).is_empty()) {
+        continue;
+      }
+      for (int s = 0; s < num_samples; s++) {
+        const float f = float(s) / float(num_samples - 1);
+        float x[3], v[3];
+        interp_v3_v3v3(x, segment.x2, segment.x3, f);
+        interp_v3_v3v3(v, segment.v2, segment.v3, f);
+
+        const int imin = max_ii(floor_int(x[0]) - 2, 0);
+        const int imax = min_ii(floor_int(x[0]) + 2, res[0] - 1);
+        const int jmin = max_ii(floor_int(x[1]) - 2, 0);
+        const int jmax = min_ii(floor_int(x[1]) + 2, res[1] - 1);
+        const int kmin = max_ii(floor_int(x[2]) - 2, int(layers.first()));
+        const int kmax = min_ii(floor_int(x[2]) + 2, int(layers.last()));
+
+        for (int k = kmin; k <= kmax; k++) {
+          for (int j = jmin; j <= jmax; j++) {
+            for (int i = imin; i <= imax; i++) {
+              float loc[3] = {float(i), float(j), float(k)};
+              HairGridVert *vert = grid->verts + i * stride[0] + j * stride[1] + k * stride[2];
+
+              hair_volume_eval_grid_vertex_sample(vert, loc, radius, dist_scale, x, v);
+            }
+          }
         }
       }
     }
-  }
+  });
+  grid->segments.clear();
 }
 #endif
 
 void SIM_hair_volume_normalize_vertex_grid(HairGrid *grid)
 {
-  int i, size = hair_grid_size(grid->res);
+  hair_volume_splat_segments(grid);
+
+  const int size = hair_grid_size(grid->res);
   /* divide velocity with density */
-  for (i = 0; i < size; i++) {
-    float density = grid->verts[i].density;
-    if (density > 0.0f) {
-      mul_v3_fl(grid->verts[i].velocity, 1.0f / density);
+  blender::threading::parallel_for(IndexRange(size), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      float density = grid->verts[i].density;
+      if (density > 0.0f) {
+        mul_v3_fl(grid->verts[i].velocity, 1.0f / density);
+      }
     }
-  }
+  });
 }
 
 /* Cells with density below this are considered empty. */
@@ -698,6 +785,150 @@ BLI_INLINE float hair_volume_density_divergence(float density,
   return 0.0f;
 }
 
+/* Chunk size of reductions in the pressure solver. It is fixed rather than derived from the
+ * number of threads, so that results are deterministic. */
+static constexpr int64_t hair_grid_reduce_chunk = 4096;
+
+static double hair_grid_dot(const Span<float> a, const Span<float> b)
+{
+  using namespace blender;
+  const int64_t chunks_num = divide_ceil_u(uint64_t(a.size()), hair_grid_reduce_chunk);
+  Array<double> partial_sums(chunks_num);
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+    for (const int64_t chunk : chunks) {
+      double sum = 0.0;
+      for (const int64_t i :
+           IndexRange(chunk * hair_grid_reduce_chunk, hair_grid_reduce_chunk)
+               .intersect(a.index_range()))
+      {
+        sum += double(a[i]) * double(b[i]);
+      }
+      partial_sums[chunk] = sum;
+    }
+  });
+  double sum = 0.0;
+  for (const double partial_sum : partial_sums) {
+    sum += partial_sum;
+  }
+  return sum;
+}
+
+/* Multiply with the matrix of the Poisson equation system.
+ *
+ * This is derived from the discretization of the Poisson equation:
+ *   `div(grad(p)) = div(v)`
+ *
+ * The finite difference approximation yields the linear equation system described here:
+ * https://en.wikipedia.org/wiki/Discrete_Poisson_equation
+ *
+ * Each fluid cell has a factor 6 on the diagonal and factors -1 for its fluid neighbors,
+ * all other cells only have a factor 1 on the diagonal. The matrix is applied on the fly
+ * instead of being assembled, so that rows can be evaluated in parallel.
+ */
+static void hair_grid_poisson_mul(const Span<bool> is_fluid,
+                                  const int strides[3],
+                                  const Span<float> x,
+                                  MutableSpan<float> r_result)
+{
+  blender::threading::parallel_for(x.index_range(), 4096, [&](const IndexRange range) {
+    for (const int64_t u : range) {
+      if (!is_fluid[u]) {
+        r_result[u] = x[u];
+        continue;
+      }
+      float result = 6.0f * x[u];
+      for (int axis = 0; axis < 3; axis++) {
+        const int64_t lo = u - strides[axis];
+        const int64_t hi = u + strides[axis];
+        if (is_fluid[lo]) {
+          result -= x[lo];
+        }
+        if (is_fluid[hi]) {
+          result -= x[hi];
+        }
+      }
+      r_result[u] = result;
+    }
+  });
+}
+
+BLI_INLINE float hair_grid_poisson_inv_diagonal(const bool is_fluid)
+{
+  return is_fluid ? 1.0f / 6.0f : 1.0f;
+}
+
+/* Conjugate gradient solver with a Jacobi (diagonal) preconditioner for the pressure equation,
+ * using the same convergence test as the Eigen solver it replaces:
+ * the iteration stops once `|b - A * x| <= tolerance * |b|`.
+ */
+static bool hair_grid_poisson_solve(const Span<bool> is_fluid,
+                                    const int strides[3],
+                                    const Span<float> b,
+                                    const int max_iterations,
+                                    const float tolerance,
+                                    MutableSpan<float> r_x)
+{
+  using namespace blender;
+  const IndexRange cells = b.index_range();
+  const int64_t grain_size = 4096;
+
+  r_x.fill(0.0f);
+
+  const double rhs_norm2 = hair_grid_dot(b, b);
+  if (rhs_norm2 == 0.0) {
+    return true;
+  }
+  const double threshold = double(tolerance) * double(tolerance) * rhs_norm2;
+
+  Array<float> r(b);
+  Array<float> z(cells.size());
+  Array<float> d(cells.size());
+  Array<float> tmp(cells.size());
+
+  double residual_norm2 = rhs_norm2;
+  threading::parallel_for(cells, grain_size, [&](const IndexRange range) {
+    for (const int64_t u : range) {
+      d[u] = hair_grid_poisson_inv_diagonal(is_fluid[u]) * r[u];
+    }
+  });
+  double abs_new = hair_grid_dot(r, d);
+
+  for (int iteration = 0; iteration < max_iterations && residual_norm2 >= threshold; iteration++)
+  {
+    hair_grid_poisson_mul(is_fluid, strides, d, tmp);
+
+    const float alpha = float(abs_new / hair_grid_dot(d, tmp));
+    threading::parallel_for(cells, grain_size, [&](const IndexRange range) {
+      for (const int64_t u : range) {
+        r_x[u] += alpha * d[u];
+        r[u] -= alpha * tmp[u];
+      }
+    });
+
+    residual_norm2 = hair_grid_dot(r, r);
+    if (residual_norm2 < threshold) {
+      break;
+    }
+
+    threading::parallel_for(cells, grain_size, [&](const IndexRange range) {
+      for (const int64_t u : range) {
+        z[u] = hair_grid_poisson_inv_diagonal(is_fluid[u]) * r[u];
+      }
+    });
+
+    const double abs_old = abs_new;
+    abs_new = hair_grid_dot(r, z);
+    const float beta = float(abs_new / abs_old);
+    threading::parallel_for(cells, grain_size, [&](const IndexRange range) {
+      for (const int64_t u : range) {
+        d[u] = z[u] + beta * d[u];
+      }
+    });
+  }
+
+  return std::sqrt(residual_norm2 / rhs_norm2) <= tolerance;
+}
+
 bool SIM_hair_volume_solve_divergence(HairGrid *grid,
                                       float /*dt*/,
                                       float target_density,
@@ -721,8 +952,6 @@ bool SIM_hair_volume_solve_divergence(HairGrid *grid,
   const int num_cellsA = (res[0] + 2) * (res[1] + 2) * (res[2] + 2);
 
   HairGridVert *vert_start = grid->verts - (stride0 + stride1 + stride2);
-  HairGridVert *vert;
-  int i, j, k;
 
 #define MARGIN_i0 (i < 1)
 #define MARGIN_j0 (j < 1)
@@ -741,203 +970,137 @@ bool SIM_hair_volume_solve_divergence(HairGrid *grid,
   BLI_assert(num_cells >= 1);
 
   /* Calculate divergence */
-  lVector B(num_cellsA);
-  for (k = 0; k < resA[2]; k++) {
-    for (j = 0; j < resA[1]; j++) {
-      for (i = 0; i < resA[0]; i++) {
-        int u = i * strideA0 + j * strideA1 + k * strideA2;
-        bool is_margin = MARGIN_i0 || MARGIN_i1 || MARGIN_j0 || MARGIN_j1 || MARGIN_k0 ||
-                         MARGIN_k1;
-
-        if (is_margin) {
-          B[u] = 0.0f;
-          continue;
-        }
-
-        vert = vert_start + i * stride0 + j * stride1 + k * stride2;
-
-        const float *v0 = vert->velocity;
-        float dx = 0.0f, dy = 0.0f, dz = 0.0f;
-        if (!NEIGHBOR_MARGIN_i0) {
-          dx += v0[0] - (vert - stride0)->velocity[0];
-        }
-        if (!NEIGHBOR_MARGIN_i1) {
-          dx += (vert + stride0)->velocity[0] - v0[0];
-        }
-        if (!NEIGHBOR_MARGIN_j0) {
-          dy += v0[1] - (vert - stride1)->velocity[1];
-        }
-        if (!NEIGHBOR_MARGIN_j1) {
-          dy += (vert + stride1)->velocity[1] - v0[1];
-        }
-        if (!NEIGHBOR_MARGIN_k0) {
-          dz += v0[2] - (vert - stride2)->velocity[2];
-        }
-        if (!NEIGHBOR_MARGIN_k1) {
-          dz += (vert + stride2)->velocity[2] - v0[2];
-        }
-
-        float divergence = -0.5f * flowfac * (dx + dy + dz);
-
-        /* adjustment term for target density */
-        float target = hair_volume_density_divergence(
-            vert->density, target_density, target_strength);
-
-        /* B vector contains the finite difference approximation of the velocity divergence.
-         * NOTE: according to the discretized Navier-Stokes equation the RHS vector
-         * and resulting pressure gradient should be multiplied by the (inverse) density;
-         * however, this is already included in the weighting of hair velocities on the grid!
-         */
-        B[u] = divergence - target;
+  Array<float> B(num_cellsA);
+  Array<bool> is_fluid(num_cellsA);
+  blender::threading::parallel_for(IndexRange(resA[2]), 1, [&](const IndexRange layers) {
+    for (const int k : layers) {
+      for (int j = 0; j < resA[1]; j++) {
+        for (int i = 0; i < resA[0]; i++) {
+          int u = i * strideA0 + j * strideA1 + k * strideA2;
+          bool is_margin = MARGIN_i0 || MARGIN_i1 || MARGIN_j0 || MARGIN_j1 || MARGIN_k0 ||
+                           MARGIN_k1;
 
-#if 0
-        {
-          float wloc[3], loc[3];
-          float col0[3] = {0.0, 0.0, 0.0};
-          float colp[3] = {0.0, 1.0, 1.0};
-          float coln[3] = {1.0, 0.0, 1.0};
-          float col[3];
-          float fac;
-
-          loc[0] = float(i - 1);
-          loc[1] = float(j - 1);
-          loc[2] = float(k - 1);
-          grid_to_world(grid, wloc, loc);
-
-          if (divergence > 0.0f) {
-            fac = std::clamp(divergence * target_strength, 0.0, 1.0);
-            interp_v3_v3v3(col, col0, colp, fac);
-          }
-          else {
-            fac = std::clamp(-divergence * target_strength, 0.0, 1.0);
-            interp_v3_v3v3(col, col0, coln, fac);
-          }
-          if (fac > 0.05f) {
-            BKE_sim_debug_data_add_circle(
-                grid->debug_data, wloc, 0.01f, col[0], col[1], col[2], "grid", 5522, i, j, k);
+          if (is_margin) {
+            B[u] = 0.0f;
+            is_fluid[u] = false;
+            continue;
           }
-        }
-#endif
-      }
-    }
-  }
 
-  /* Main Poisson equation system:
-   * This is derived from the discretization of the Poisson equation:
-   *   `div(grad(p)) = div(v)`
-   *
-   * The finite difference approximation yields the linear equation system described here:
-   * https://en.wikipedia.org/wiki/Discrete_Poisson_equation
-   */
-  lMatrix A(num_cellsA, num_cellsA);
-  /* Reserve space for the base equation system (without boundary conditions).
-   * Each column contains a factor 6 on the diagonal
-   * and up to 6 factors -1 on other places.
-   */
-  A.reserve(Eigen::VectorXi::Constant(num_cellsA, 7));
-
-  for (k = 0; k < resA[2]; k++) {
-    for (j = 0; j < resA[1]; j++) {
-      for (i = 0; i < resA[0]; i++) {
-        int u = i * strideA0 + j * strideA1 + k * strideA2;
-        bool is_margin = MARGIN_i0 || MARGIN_i1 || MARGIN_j0 || MARGIN_j1 || MARGIN_k0 ||
-                         MARGIN_k1;
-
-        vert = vert_start + i * stride0 + j * stride1 + k * stride2;
-        if (!is_margin && vert->density > density_threshold) {
-          int neighbors_lo = 0;
-          int neighbors_hi = 0;
-          int non_solid_neighbors = 0;
-          int neighbor_lo_index[3];
-          int neighbor_hi_index[3];
-          int n;
-
-          /* check for upper bounds in advance
-           * to get the correct number of neighbors,
-           * needed for the diagonal element
-           */
-          if (!NEIGHBOR_MARGIN_k0 && (vert - stride2)->density > density_threshold) {
-            neighbor_lo_index[neighbors_lo++] = u - strideA2;
+          const HairGridVert *vert = vert_start + i * stride0 + j * stride1 + k * stride2;
+          is_fluid[u] = vert->density > density_threshold;
+
+          const float *v0 = vert->velocity;
+          float dx = 0.0f, dy = 0.0f, dz = 0.0f;
+          if (!NEIGHBOR_MARGIN_i0) {
+            dx += v0[0] - (vert - stride0)->velocity[0];
           }
-          if (!NEIGHBOR_MARGIN_j0 && (vert - stride1)->density > density_threshold) {
-            neighbor_lo_index[neighbors_lo++] = u - strideA1;
+          if (!NEIGHBOR_MARGIN_i1) {
+            dx += (vert + stride0)->velocity[0] - v0[0];
           }
-          if (!NEIGHBOR_MARGIN_i0 && (vert - stride0)->density > density_threshold) {
-            neighbor_lo_index[neighbors_lo++] = u - strideA0;
+          if (!NEIGHBOR_MARGIN_j0) {
+            dy += v0[1] - (vert - stride1)->velocity[1];
           }
-          if (!NEIGHBOR_MARGIN_i1 && (vert + stride0)->density > density_threshold) {
-            neighbor_hi_index[neighbors_hi++] = u + strideA0;
+          if (!NEIGHBOR_MARGIN_j1) {
+            dy += (vert + stride1)->velocity[1] - v0[1];
           }
-          if (!NEIGHBOR_MARGIN_j1 && (vert + stride1)->density > density_threshold) {
-            neighbor_hi_index[neighbors_hi++] = u + strideA1;
+          if (!NEIGHBOR_MARGIN_k0) {
+            dz += v0[2] - (vert - stride2)->velocity[2];
           }
-          if (!NEIGHBOR_MARGIN_k1 && (vert + stride2)->density > density_threshold) {
-            neighbor_hi_index[neighbors_hi++] = u + strideA2;
+          if (!NEIGHBOR_MARGIN_k1) {
+            dz += (vert + stride2)->velocity[2] - v0[2];
           }
 
-          // int liquid_neighbors = neighbors_lo + neighbors_hi;
-          non_solid_neighbors = 6;
+          float divergence = -0.5f * flowfac * (dx + dy + dz);
 
-          for (n = 0; n < neighbors_lo; n++) {
-            A.insert(neighbor_lo_index[n], u) = -1.0f;
-          }
-          A.insert(u, u) = float(non_solid_neighbors);
-          for (n = 0; n < neighbors_hi; n++) {
-            A.insert(neighbor_hi_index[n], u) = -1.0f;
+          /* adjustment term for target density */
+          float target = hair_volume_density_divergence(
+              vert->density, target_density, target_strength);
+
+          /* B vector contains the finite difference approximation of the velocity divergence.
+           * NOTE: according to the discretized Navier-Stokes equation the RHS vector
+           * and resulting pressure gradient should be multiplied by the (inverse) density;
+           * however, this is already included in the weighting of hair velocities on the grid!
+           */
+          B[u] = divergence - target;
+
+#if 0
+          {
+            float wloc[3], loc[3];
+            float col0[3] = {0.0, 0.0, 0.0};
+            float colp[3] = {0.0, 1.0, 1.0};
+            float coln[3] = {1.0, 0.0, 1.0};
+            float col[3];
+            float fac;
+
+            loc[0] = float(i - 1);
+            loc[1] = float(j - 1);
+            loc[2] = float(k - 1);
+            grid_to_world(grid, wloc, loc);
+
+            if (divergence > 0.0f) {
+              fac = std::clamp(divergence * target_strength, 0.0, 1.0);
+              interp_v3_v3v3(col, col0, colp, fac);
+            }
+            else {
+              fac = std::clamp(-divergence * target_strength, 0.0, 1.0);
+              interp_v3_v3v3(col, col0, coln, fac);
+            }
+            if (fac > 0.05f) {
+              BKE_sim_debug_data_add_circle(
+                  grid->debug_data, wloc, 0.01f, col[0], col[1], col[2], "grid", 5522, i, j, k);
+            }
           }
-        }
-        else {
-          A.insert(u, u) = 1.0f;
+#endif
         }
       }
     }
-  }
+  });
 
-  ConjugateGradient cg;
-  cg.setMaxIterations(100);
-  cg.setTolerance(0.01f);
+  /* Main Poisson equation system, see #hair_grid_poisson_mul.
+   * Margin cells are never fluid, so the stencil of fluid cells stays inside the grid. */
+  const int stridesA[3] = {strideA0, strideA1, strideA2};
+  Array<float> p(num_cellsA);
+  const bool success = hair_grid_poisson_solve(is_fluid, stridesA, B, 100, 0.01f, p);
 
-  cg.compute(A);
+  if (success) {
+    /* Calculate velocity = grad(p) */
+    blender::threading::parallel_for(IndexRange(resA[2]), 1, [&](const IndexRange layers) {
+      for (const int k : layers) {
+        for (int j = 0; j < resA[1]; j++) {
+          for (int i = 0; i < resA[0]; i++) {
+            int u = i * strideA0 + j * strideA1 + k * strideA2;
+            bool is_margin = MARGIN_i0 || MARGIN_i1 || MARGIN_j0 || MARGIN_j1 || MARGIN_k0 ||
+                             MARGIN_k1;
+            if (is_margin) {
+              continue;
+            }
 
-  lVector p = cg.solve(B);
+            HairGridVert *vert = vert_start + i * stride0 + j * stride1 + k * stride2;
+            if (vert->density > density_threshold) {
+              float p_left = p[u - strideA0];
+              float p_right = p[u + strideA0];
+              float p_down = p[u - strideA1];
+              float p_up = p[u + strideA1];
+              float p_bottom = p[u - strideA2];
+              float p_top = p[u + strideA2];
 
-  if (cg.info() == Eigen::Success) {
-    /* Calculate velocity = grad(p) */
-    for (k = 0; k < resA[2]; k++) {
-      for (j = 0; j < resA[1]; j++) {
-        for (i = 0; i < resA[0]; i++) {
-          int u = i * strideA0 + j * strideA1 + k * strideA2;
-          bool is_margin = MARGIN_i0 || MARGIN_i1 || MARGIN_j0 || MARGIN_j1 || MARGIN_k0 ||
-                           MARGIN_k1;
-          if (is_margin) {
-            continue;
-          }
+              /* finite difference estimate of pressure gradient */
+              float dvel[3];
+              dvel[0] = p_right - p_left;
+              dvel[1] = p_up - p_down;
+              dvel[2] = p_top - p_bottom;
+              mul_v3_fl(dvel, -0.5f * inv_flowfac);
 
-          vert = vert_start + i * stride0 + j * stride1 + k * stride2;
-          if (vert->density > density_threshold) {
-            float p_left = p[u - strideA0];
-            float p_right = p[u + strideA0];
-            float p_down = p[u - strideA1];
-            float p_up = p[u + strideA1];
-            float p_bottom = p[u - strideA2];
-            float p_top = p[u + strideA2];
-
-            /* finite difference estimate of pressure gradient */
-            float dvel[3];
-            dvel[0] = p_right - p_left;
-            dvel[1] = p_up - p_down;
-            dvel[2] = p_top - p_bottom;
-            mul_v3_fl(dvel, -0.5f * inv_flowfac);
-
-            /* pressure gradient describes velocity delta */
-            add_v3_v3v3(vert->velocity_smooth, vert->velocity, dvel);
-          }
-          else {
-            zero_v3(vert->velocity_smooth);
+              /* pressure gradient describes velocity delta */
+              add_v3_v3v3(vert->velocity_smooth, vert->velocity, dvel);
+            }
+            else {
+              zero_v3(vert->velocity_smooth);
+            }
           }
         }
       }
-    }
+    });
 
 #if 0
     {
@@ -1017,8 +1180,8 @@ bool SIM_hair_volume_solve_divergence(HairGrid *grid,
   }
 
   /* Clear result in case of error */
-  for (i = 0, vert = grid->verts; i < num_cells; i++, vert++) {
-    zero_v3(vert->velocity_smooth);
+  for (int i = 0; i < num_cells; i++) {
+    zero_v3(grid->verts[i].velocity_smooth);
   }
 
   return false;
@@ -1141,7 +1304,7 @@ HairGrid *SIM_hair_volume_create_vertex_grid(float cellsize,
   }
   size = hair_grid_size(res);
 
-  grid = MEM_cnew<HairGrid>("hair grid");
+  grid = MEM_new<HairGrid>("hair grid");
   grid->res[0] = res[0];
   grid->res[1] = res[1];
   grid->res[2] = res[2];
@@ -1160,7 +1323,7 @@ void SIM_hair_volume_free_vertex_grid(HairGrid *grid)
     if (grid->verts) {
       MEM_freeN(grid->verts);
     }
-    MEM_freeN(grid);
+    MEM_delete(grid);
   }
 }
 
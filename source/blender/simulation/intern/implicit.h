@@ -223,6 +223,8 @@ void SIM_hair_volume_grid_geometry(
 
 void SIM_hair_volume_grid_clear(struct HairGrid *grid);
 void SIM_hair_volume_add_vertex(struct HairGrid *grid, const float x[3], const float v[3]);
+/* Segments are buffered and added to the grid in parallel by
+ * #SIM_hair_volume_normalize_vertex_grid. */
 void SIM_hair_volume_add_segment(struct HairGrid *grid,
                                  const float x1[3],
                                  const float v1[3],
@@ -16,6 +16,11 @@
 #  include "BLI_math_matrix.h"
 #  include "BLI_math_vector.h"
 
+#  include "BLI_array.hh"
+#  include "BLI_math_matrix_types.hh"
+#  include "BLI_offset_indices.hh"
+#  include "BLI_task.hh"
+
 #  include "BKE_cloth.hh"
 
 #  include "SIM_mass_spring.h"
@@ -811,101 +816,6 @@ static int cg_filtered(lfVector *ldV, fmatrix3x3 *lA, lfVector *lB, lfVector *z,
 }
 #  endif
 
-static int cg_filtered(lfVector *ldV,
-                       fmatrix3x3 *lA,
-                       lfVector *lB,
-                       lfVector *z,
-                       fmatrix3x3 *S,
-                       ImplicitSolverResult *result)
-{
-  /* Solves for unknown X in equation AX=B */
-  uint conjgrad_loopcount = 0, conjgrad_looplimit = 100;
-  float conjgrad_epsilon = 0.01f;
-
-  uint numverts = lA[0].vcount;
-  lfVector *fB = create_lfvector(numverts);
-  lfVector *AdV = create_lfvector(numverts);
-  lfVector *r = create_lfvector(numverts);
-  lfVector *c = create_lfvector(numverts);
-  lfVector *q = create_lfvector(numverts);
-  lfVector *s = create_lfvector(numverts);
-  float bnorm2, delta_new, delta_old, delta_target, alpha;
-
-  cp_lfvector(ldV, z, numverts);
-
-  /* d0 = filter(B)^T * P * filter(B) */
-  cp_lfvector(fB, lB, numverts);
-  filter(fB, S);
-  bnorm2 = dot_lfvector(fB, fB, numverts);
-  delta_target = conjgrad_epsilon * conjgrad_epsilon * bnorm2;
-
-  /* r = filter(B - A * dV) */
-  mul_bfmatrix_lfvector(AdV, lA, ldV);
-  sub_lfvector_lfvector(r, lB, AdV, numverts);
-  filter(r, S);
-
-  /* c = filter(P^-1 * r) */
-  cp_lfvector(c, r, numverts);
-  filter(c, S);
-
-  /* delta = r^T * c */
-  delta_new = dot_lfvector(r, c, numverts);
-
-#  ifdef IMPLICIT_PRINT_SOLVER_INPUT_OUTPUT
-  printf("==== A ====\n");
-  print_bfmatrix(lA);
-  printf("==== z ====\n");
-  print_lvector(z, numverts);
-  printf("==== B ====\n");
-  print_lvector(lB, numverts);
-  printf("==== S ====\n");
-  print_bfmatrix(S);
-#  endif
-
-  while (delta_new > delta_target && conjgrad_loopcount < conjgrad_looplimit) {
-    mul_bfmatrix_lfvector(q, lA, c);
-    filter(q, S);
-
-    alpha = delta_new / dot_lfvector(c, q, numverts);
-
-    add_lfvector_lfvectorS(ldV, ldV, c, alpha, numverts);
-
-    add_lfvector_lfvectorS(r, r, q, -alpha, numverts);
-
-    /* s = P^-1 * r */
-    cp_lfvector(s, r, numverts);
-    delta_old = delta_new;
-    delta_new = dot_lfvector(r, s, numverts);
-
-    add_lfvector_lfvectorS(c, s, c, delta_new / delta_old, numverts);
-    filter(c, S);
-
-    conjgrad_loopcount++;
-  }
-
-#  ifdef IMPLICIT_PRINT_SOLVER_INPUT_OUTPUT
-  printf("==== dV ====\n");
-  print_lvector(ldV, numverts);
-  printf("========\n");
-#  endif
-
-  del_lfvector(fB);
-  del_lfvector(AdV);
-  del_lfvector(r);
-  del_lfvector(c);
-  del_lfvector(q);
-  del_lfvector(s);
-  // printf("W/O conjgrad_loopcount: %d\n", conjgrad_loopcount);
-
-  result->status = conjgrad_loopcount < conjgrad_looplimit ? SIM_SOLVER_SUCCESS :
-                                                             SIM_SOLVER_NO_CONVERGENCE;
-  result->iterations = conjgrad_loopcount;
-  result->error = bnorm2 > 0.0f ? sqrtf(delta_new / bnorm2) : 0.0f;
-
-  /* True means we reached desired accuracy in given time - ie stable. */
-  return conjgrad_loopcount < conjgrad_looplimit;
-}
-
 #  if 0
 /* block diagonalizer */
 DO_INLINE void BuildPPinv(fmatrix3x3 *lA, fmatrix3x3 *P, fmatrix3x3 *Pinv)
@@ -1112,6 +1022,250 @@ static int cg_filtered_pre(lfVector *dv,
 }
 #  endif
 
+/* -------------------------------------------------------------------- */
+/** \name Block Compressed Sparse Row Solver
+ *
+ * The #fmatrix3x3 storage only keeps the lower triangle of the symmetric system matrix, in the
+ * order springs were added, so multiplying it with a vector writes to arbitrary rows and can't be
+ * split over threads without races. For the solve the matrix is converted to block CSR with both
+ * triangles stored, so every row can be computed independently.
+ *
+ * Dot products are reduced in chunks of a fixed size and then summed in order, so the result
+ * doesn't depend on the number of threads and simulations stay reproducible.
+ * \{ */
+
+struct BlockCSRMatrix {
+  blender::Array<int> row_offsets;
+  blender::Array<int> columns;
+  /** Blocks are stored row-major, like #fmatrix3x3.m. */
+  blender::Array<blender::float3x3> blocks;
+};
+
+/** Number of vector elements per task and per partial dot product sum. */
+static constexpr int BCSR_GRAIN_SIZE = 1024;
+
+/**
+ * Convert the first \a blocks_num blocks of a #fmatrix3x3 matrix into \a csr.
+ * Off-diagonal blocks are added to both their row and their column.
+ */
+static void bcsr_from_bfmatrix(BlockCSRMatrix &csr, const fmatrix3x3 *from, const int blocks_num)
+{
+  using namespace blender;
+  const int rows_num = from[0].vcount;
+
+  csr.row_offsets.reinitialize(rows_num + 1);
+  csr.row_offsets.fill(0);
+  for (int i = 0; i < blocks_num; i++) {
+    csr.row_offsets[from[i].r]++;
+    if (i >= rows_num) {
+      csr.row_offsets[from[i].c]++;
+    }
+  }
+  const OffsetIndices<int> rows = offset_indices::accumulate_counts_to_offsets(csr.row_offsets);
+
+  csr.columns.reinitialize(rows.total_size());
+  csr.blocks.reinitialize(rows.total_size());
+  Array<int> row_fill(rows_num);
+  for (const int row : rows.index_range()) {
+    row_fill[row] = rows[row].start();
+  }
+  for (int i = 0; i < blocks_num; i++) {
+    const int r = from[i].r;
+    const int c = from[i].c;
+    const int index = row_fill[r]++;
+    csr.columns[index] = c;
+    copy_m3_m3(csr.blocks[index].ptr(), from[i].m);
+    if (i >= rows_num) {
+      /* The upper triangle uses the transposed block. */
+      const int index_transposed = row_fill[c]++;
+      csr.columns[index_transposed] = r;
+      transpose_m3_m3(csr.blocks[index_transposed].ptr(), from[i].m);
+    }
+  }
+}
+
+/** `to = A * from` */
+static void bcsr_mul_lfvector(lfVector *to, const BlockCSRMatrix &A, const lfVector *from)
+{
+  using namespace blender;
+  const OffsetIndices<int> rows(A.row_offsets);
+  threading::parallel_for(rows.index_range(), BCSR_GRAIN_SIZE, [&](const IndexRange range) {
+    for (const int row : range) {
+      float sum[3] = {0.0f, 0.0f, 0.0f};
+      for (const int i : rows[row]) {
+        muladd_fmatrix_fvector(sum, A.blocks[i].ptr(), from[A.columns[i]]);
+      }
+      copy_v3_v3(to[row], sum);
+    }
+  });
+}
+
+/** Inverse of the diagonal blocks of \a A, used as block Jacobi preconditioner. */
+static void bcsr_block_jacobi_inverse(blender::MutableSpan<blender::float3x3> r_inverse,
+                                      const fmatrix3x3 *A)
+{
+  using namespace blender;
+  threading::parallel_for(r_inverse.index_range(), BCSR_GRAIN_SIZE, [&](const IndexRange range) {
+    for (const int i : range) {
+      if (!invert_m3_m3(r_inverse[i].ptr(), A[i].m)) {
+        /* Fall back to no preconditioning for singular blocks. */
+        unit_m3(r_inverse[i].ptr());
+      }
+    }
+  });
+}
+
+/** `to = P^-1 * from` for a block diagonal P^-1. */
+static void block_diagonal_mul_lfvector(lfVector *to,
+                                        const blender::Span<blender::float3x3> blocks,
+                                        const lfVector *from)
+{
+  using namespace blender;
+  threading::parallel_for(blocks.index_range(), BCSR_GRAIN_SIZE, [&](const IndexRange range) {
+    for (const int i : range) {
+      zero_v3(to[i]);
+      muladd_fmatrix_fvector(to[i], blocks[i].ptr(), from[i]);
+    }
+  });
+}
+
+static void filter_parallel(lfVector *V, const fmatrix3x3 *S)
+{
+  using namespace blender;
+  threading::parallel_for(IndexRange(S[0].vcount), BCSR_GRAIN_SIZE, [&](const IndexRange range) {
+    for (const int i : range) {
+      mul_m3_v3(S[i].m, V[S[i].r]);
+    }
+  });
+}
+
+static float dot_lfvector_parallel(const lfVector *a, const lfVector *b, const uint verts)
+{
+  using namespace blender;
+  const int chunks_num = divide_ceil_u(verts, BCSR_GRAIN_SIZE);
+  Array<double, 64> partial_sums(chunks_num);
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+    for (const int chunk : chunks) {
+      const IndexRange chunk_range = IndexRange(chunk * BCSR_GRAIN_SIZE, BCSR_GRAIN_SIZE)
+                                         .intersect(IndexRange(verts));
+      double sum = 0.0;
+      for (const int i : chunk_range) {
+        sum += dot_v3v3(a[i], b[i]);
+      }
+      partial_sums[chunk] = sum;
+    }
+  });
+  double sum = 0.0;
+  for (const double partial_sum : partial_sums) {
+    sum += partial_sum;
+  }
+  return float(sum);
+}
+
+/** `to = a + b * bS` */
+static void add_lfvector_lfvectorS_parallel(
+    lfVector *to, const lfVector *a, const lfVector *b, const float bS, const uint verts)
+{
+  using namespace blender;
+  threading::parallel_for(IndexRange(verts), BCSR_GRAIN_SIZE, [&](const IndexRange range) {
+    for (const int i : range) {
+      madd_v3_v3v3fl(to[i], a[i], b[i], bS);
+    }
+  });
+}
+
+/**
+ * Filtered conjugate gradient solver, using the block CSR matrix, parallel vector operations and a
+ * block Jacobi preconditioner. The preconditioned residual is filtered as well, so the effective
+ * preconditioner `S * P^-1 * S` stays symmetric in the constrained sub-space.
+ */
+static int cg_filtered_bcsr(lfVector *ldV,
+                            fmatrix3x3 *lA,
+                            const int blocks_num,
+                            lfVector *lB,
+                            lfVector *z,
+                            fmatrix3x3 *S,
+                            ImplicitSolverResult *result)
+{
+  using namespace blender;
+  /* Solves for unknown X in equation AX=B */
+  uint conjgrad_loopcount = 0, conjgrad_looplimit = 100;
+  float conjgrad_epsilon = 0.01f;
+
+  uint numverts = lA[0].vcount;
+  BlockCSRMatrix A;
+  bcsr_from_bfmatrix(A, lA, blocks_num);
+  Array<float3x3> Pinv(numverts);
+  bcsr_block_jacobi_inverse(Pinv, lA);
+
+  lfVector *fB = create_lfvector(numverts);
+  lfVector *AdV = create_lfvector(numverts);
+  lfVector *r = create_lfvector(numverts);
+  lfVector *c = create_lfvector(numverts);
+  lfVector *q = create_lfvector(numverts);
+  lfVector *s = create_lfvector(numverts);
+  float bnorm2, delta_new, delta_old, delta_target, alpha;
+
+  cp_lfvector(ldV, z, numverts);
+
+  /* d0 = filter(B)^T * P^-1 * filter(B) */
+  cp_lfvector(fB, lB, numverts);
+  filter_parallel(fB, S);
+  block_diagonal_mul_lfvector(s, Pinv, fB);
+  bnorm2 = dot_lfvector_parallel(fB, s, numverts);
+  delta_target = conjgrad_epsilon * conjgrad_epsilon * bnorm2;
+
+  /* r = filter(B - A * dV) */
+  bcsr_mul_lfvector(AdV, A, ldV);
+  add_lfvector_lfvectorS_parallel(r, lB, AdV, -1.0f, numverts);
+  filter_parallel(r, S);
+
+  /* c = filter(P^-1 * r) */
+  block_diagonal_mul_lfvector(c, Pinv, r);
+  filter_parallel(c, S);
+
+  /* delta = r^T * c */
+  delta_new = dot_lfvector_parallel(r, c, numverts);
+
+  while (delta_new > delta_target && conjgrad_loopcount < conjgrad_looplimit) {
+    bcsr_mul_lfvector(q, A, c);
+    filter_parallel(q, S);
+
+    alpha = delta_new / dot_lfvector_parallel(c, q, numverts);
+
+    add_lfvector_lfvectorS_parallel(ldV, ldV, c, alpha, numverts);
+
+    add_lfvector_lfvectorS_parallel(r, r, q, -alpha, numverts);
+
+    /* s = P^-1 * r */
+    block_diagonal_mul_lfvector(s, Pinv, r);
+    delta_old = delta_new;
+    delta_new = dot_lfvector_parallel(r, s, numverts);
+
+    add_lfvector_lfvectorS_parallel(c, s, c, delta_new / delta_old, numverts);
+    filter_parallel(c, S);
+
+    conjgrad_loopcount++;
+  }
+
+  del_lfvector(fB);
+  del_lfvector(AdV);
+  del_lfvector(r);
+  del_lfvector(c);
+  del_lfvector(q);
+  del_lfvector(s);
+
+  result->status = conjgrad_loopcount < conjgrad_looplimit ? SIM_SOLVER_SUCCESS :
+                                                             SIM_SOLVER_NO_CONVERGENCE;
+  result->iterations = conjgrad_loopcount;
+  result->error = bnorm2 > 0.0f ? sqrtf(delta_new / bnorm2) : 0.0f;
+
+  /* True means we reached desired accuracy in given time - ie stable. */
+  return conjgrad_loopcount < conjgrad_looplimit;
+}
+
+/** \} */
+
 bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSolverResult *result)
 {
   uint numverts = data->dFdV[0].vcount;
@@ -1132,7 +1286,13 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 #  endif
 
   /* Conjugate gradient algorithm to solve Ax=b. */
-  cg_filtered(data->dV, data->A, data->B, data->z, data->S, result);
+  cg_filtered_bcsr(data->dV,
+                   data->A,
+                   data->M[0].vcount + data->num_blocks,
+                   data->B,
+                   data->z,
+                   data->S,
+                   result);
 
   // cg_filtered_pre(id->dV, id->A, id->B, id->z, id->S, id->P, id->Pinv, id->bigI);
 
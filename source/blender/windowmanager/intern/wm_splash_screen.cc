@@ -165,7 +165,7 @@ static ImBuf *wm_block_splash_image(int width, int *r_height)
     ibuf->planes = 32; /* The image might not have an alpha channel. */
     height = (width * ibuf->y) / ibuf->x;
     if (width != ibuf->x || height != ibuf->y) {
-      IMB_scale(ibuf, width, height, IMBScaleFilter::Box, false);
+      IMB_scale(ibuf, width, height, IMBScaleFilter::Box);
     }
 
     wm_block_splash_image_roundcorners_add(ibuf);
@@ -221,7 +221,7 @@ static ImBuf *wm_block_splash_banner_image(int *r_width,
       height = max_height;
     }
     if (width != ibuf->x || height != ibuf->y) {
-      IMB_scale(ibuf, width, height, IMBScaleFilter::Box, false);
+      IMB_scale(ibuf, width, height, IMBScaleFilter::Box);
     }
   }
 
@@ -0,0 +1,257 @@
+# SPDX-FileCopyrightText: 2025 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+
+def prepare_compositor_scene(width: int, height: int):
+    """
+    Setup an empty scene that is composited on the CPU, with a color grid
+    image as the input of the compositor.
+    """
+    import bpy
+
+    scene = bpy.context.scene
+    for ob in list(bpy.data.objects):
+        bpy.data.objects.remove(ob)
+
+    scene.render.engine = 'BLENDER_WORKBENCH'
+    scene.render.resolution_x = width
+    scene.render.resolution_y = height
+    scene.render.resolution_percentage = 100
+    scene.render.compositor_device = 'CPU'
+    scene.use_nodes = True
+
+    tree = scene.node_tree
+    tree.nodes.clear()
+
+    image = bpy.data.images.new("Grid", width, height, float_buffer=True)
+    image.generated_type = 'COLOR_GRID'
+    image_node = tree.nodes.new("CompositorNodeImage")
+    image_node.image = image
+
+    # Circular in focus region in the middle of the image, out of focus around it.
+    mask_node = tree.nodes.new("CompositorNodeEllipseMask")
+    mask_node.mask_width = 0.5
+    mask_node.mask_height = 0.5
+    invert_node = tree.nodes.new("CompositorNodeInvert")
+    tree.links.new(mask_node.outputs["Mask"], invert_node.inputs["Color"])
+
+    composite_node = tree.nodes.new("CompositorNodeComposite")
+
+    return tree, image_node, invert_node, composite_node
+
+
+def _add_defocus_node(args: dict):
+    import bpy
+
+    tree, image_node, mask_node, composite_node = prepare_compositor_scene(args['width'], args['height'])
+
+    if args['node'] == 'DEFOCUS':
+        blur_node = tree.nodes.new("CompositorNodeDefocus")
+        blur_node.use_zbuffer = False
+        blur_node.blur_max = args['radius']
+        blur_node.z_scale = args['radius']
+        tree.links.new(image_node.outputs["Image"], blur_node.inputs["Image"])
+        tree.links.new(mask_node.outputs["Color"], blur_node.inputs["Z"])
+    else:
+        blur_node = tree.nodes.new("CompositorNodeBokehBlur")
+        blur_node.use_variable_size = True
+        blur_node.blur_max = args['radius']
+        bokeh_node = tree.nodes.new("CompositorNodeBokehImage")
+        # The size is relative to one percent of the largest image dimension.
+        size_node = tree.nodes.new("CompositorNodeMath")
+        size_node.operation = 'MULTIPLY'
+        size_node.inputs[1].default_value = args['radius'] / (max(args['width'], args['height']) / 100.0)
+        tree.links.new(mask_node.outputs["Color"], size_node.inputs[0])
+        tree.links.new(image_node.outputs["Image"], blur_node.inputs["Image"])
+        tree.links.new(bokeh_node.outputs["Image"], blur_node.inputs["Bokeh"])
+        tree.links.new(size_node.outputs["Value"], blur_node.inputs["Size"])
+
+    tree.links.new(blur_node.outputs["Image"], composite_node.inputs["Image"])
+
+
+def _run_defocus(args: dict):
+    import bpy
+    import time
+
+    _add_defocus_node(args)
+
+    # Warm up to load the image and compile the node tree.
+    bpy.ops.render.render()
+
+    start_time = time.time()
+    for _ in range(args['num_renders']):
+        bpy.ops.render.render()
+    elapsed_time = time.time() - start_time
+
+    result = {'time': elapsed_time / args['num_renders']}
+    return result
+
+
+def _run_defocus_quality(args: dict):
+    import bpy
+    import numpy
+    import os
+
+    _add_defocus_node(args)
+
+    scene = bpy.context.scene
+    scene.render.image_settings.file_format = 'OPEN_EXR'
+    scene.render.image_settings.color_depth = '32'
+
+    # Render with the layered bokeh blur and with the direct accumulation of the pixels, which the
+    # layered bokeh blur approximates. See layered_bokeh_blur_disable_debug_value.
+    pixels = []
+    for debug_value in (0, 7080):
+        bpy.app.debug_value = debug_value
+        bpy.ops.render.render()
+
+        filepath = os.path.join(args['directory'], "defocus_{}.exr".format(debug_value))
+        bpy.data.images['Render Result'].save_render(filepath)
+        image = bpy.data.images.load(filepath)
+        image_pixels = numpy.empty(len(image.pixels), dtype=numpy.float32)
+        image.pixels.foreach_get(image_pixels)
+        pixels.append(image_pixels)
+        bpy.data.images.remove(image)
+    bpy.app.debug_value = 0
+
+    error = numpy.abs(pixels[0] - pixels[1])
+    return {'max_error': float(error.max()), 'mean_error': float(error.mean())}
+
+
+class DefocusTest(api.Test):
+    def __init__(self, node: str, radius: int, num_renders: int):
+        self.node = node
+        self.radius = radius
+        self.num_renders = num_renders
+
+    def name(self):
+        return "{}_4k_radius_{}".format(self.node.lower(), self.radius)
+
+    def category(self):
+        return "compositor"
+
+    def run(self, env, _device_id):
+        args = {
+            "node": self.node,
+            "width": 3840,
+            "height": 2160,
+            "radius": self.radius,
+            "num_renders": self.num_renders,
+        }
+        result, _ = env.run_in_blender(_run_defocus, args)
+
+        # Radii for which the layered bokeh blur is used, whose result is compared against the
+        # direct accumulation of the pixels. The errors are in the scene linear color space. A lower
+        # resolution is used, since the direct accumulation is slow for large radii.
+        if self.radius >= 24:
+            import tempfile
+
+            with tempfile.TemporaryDirectory() as directory:
+                args["width"] = 1920
+                args["height"] = 1080
+                args["directory"] = directory
+                quality, _ = env.run_in_blender(_run_defocus_quality, args)
+            result.update(quality)
+
+        return result
+
+
+def _write_multilayer_exr(args: dict):
+    import bpy
+    import os
+
+    tree, _, invert_node, composite_node = prepare_compositor_scene(args['width'], args['height'])
+    tree.links.new(invert_node.outputs["Color"], composite_node.inputs["Image"])
+
+    # Single channel passes to limit the memory needed to write the file.
+    value_node = tree.nodes.new("CompositorNodeRGBToBW")
+    tree.links.new(invert_node.outputs["Color"], value_node.inputs["Image"])
+
+    file_output_node = tree.nodes.new("CompositorNodeOutputFile")
+    file_output_node.format.file_format = 'OPEN_EXR_MULTILAYER'
+    file_output_node.base_path = os.path.join(args['directory'], "passes_")
+    file_output_node.layer_slots.clear()
+    for i in range(args['num_passes']):
+        file_output_node.layer_slots.new("Pass{}".format(i))
+        tree.links.new(value_node.outputs["Val"], file_output_node.inputs[i])
+
+    bpy.ops.render.render()
+
+    return os.path.join(args['directory'], "passes_{:04d}.exr".format(bpy.context.scene.frame_current))
+
+
+def _run_multilayer_exr(args: dict):
+    import bpy
+    import time
+
+    tree, _, _, composite_node = prepare_compositor_scene(args['width'], args['height'])
+
+    # Only read two of the passes of the file.
+    image = bpy.data.images.load(args['filepath'])
+    image_node = tree.nodes.new("CompositorNodeImage")
+    image_node.image = image
+    mix_node = tree.nodes.new("CompositorNodeMixRGB")
+    tree.links.new(image_node.outputs["Pass0"], mix_node.inputs[1])
+    tree.links.new(image_node.outputs["Pass{}".format(args['num_passes'] - 1)], mix_node.inputs[2])
+    tree.links.new(mix_node.outputs["Image"], composite_node.inputs["Image"])
+
+    # Reload the image before every render, such that its passes are read from the file again.
+    elapsed_time = 0.0
+    for _ in range(args['num_renders']):
+        image.reload()
+        start_time = time.time()
+        bpy.ops.render.render()
+        elapsed_time += time.time() - start_time
+
+    result = {'time': elapsed_time / args['num_renders']}
+
+    try:
+        import resource
+        # Kilobytes on Linux.
+        result['peak_memory'] = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss * 1024
+    except ImportError:
+        pass
+
+    return result
+
+
+class MultilayerEXRTest(api.Test):
+    def __init__(self, num_passes: int, num_renders: int):
+        self.num_passes = num_passes
+        self.num_renders = num_renders
+
+    def name(self):
+        return "multilayer_exr_4k_{}_passes".format(self.num_passes)
+
+    def category(self):
+        return "compositor"
+
+    def run(self, env, _device_id):
+        import tempfile
+
+        with tempfile.TemporaryDirectory() as directory:
+            args = {
+                "width": 3840,
+                "height": 2160,
+                "num_passes": self.num_passes,
+                "directory": directory,
+            }
+            filepath, _ = env.run_in_blender(_write_multilayer_exr, args)
+
+            args["filepath"] = filepath
+            args["num_renders"] = self.num_renders
+            result, _ = env.run_in_blender(_run_multilayer_exr, args)
+
+        return result
+
+
+def generate(env):
+    # Radii below and above the radius starting from which the CPU compositor convolves the
+    # quantized radius layers in the frequency domain.
+    return [DefocusTest(node, radius, 3)
+            for node in ('DEFOCUS', 'BOKEH_BLUR')
+            for radius in (16, 32, 64, 128)] + \
+        [MultilayerEXRTest(40, 3)]
@@ -16,6 +16,7 @@ def _run(args):
     scene.render.filepath = args['render_filepath']
     scene.render.image_settings.file_format = 'PNG'
     scene.cycles.device = 'CPU' if device_type == 'CPU' else 'GPU'
+    scene.cycles.debug_use_cpu_wavefront = args['use_wavefront']
 
     if scene.cycles.use_adaptive_sampling:
         # Render samples specified in file, no other way to measure
@@ -52,6 +53,8 @@ def _run(args):
 
 
 class CyclesTest(api.Test):
+    use_wavefront = False
+
     def __init__(self, filepath):
         self.filepath = filepath
 
@@ -70,6 +73,7 @@ class CyclesTest(api.Test):
         device_index = int(tokens[1]) if len(tokens) > 1 else 0
         args = {'device_type': device_type,
                 'device_index': device_index,
+                'use_wavefront': self.use_wavefront,
                 'render_filepath': str(env.log_file.parent / (env.log_file.stem + '.png'))}
 
         _, lines = env.run_in_blender(_run, args, ['--debug-cycles', '--verbose', '2', self.filepath])
@@ -107,6 +111,21 @@ class CyclesTest(api.Test):
         return {'time': time, 'peak_memory': memory}
 
 
+class CyclesWavefrontTest(CyclesTest):
+    """
+    Same scenes rendered with the CPU wavefront scheduling, to compare against the megakernel.
+    """
+    use_wavefront = True
+
+    def name(self):
+        return self.filepath.stem + "_wavefront"
+
+    def use_device(self):
+        # Wavefront scheduling only exists on the CPU device.
+        return False
+
+
 def generate(env):
     filepaths = env.find_blend_files('cycles/*')
-    return [CyclesTest(filepath) for filepath in filepaths]
+    return [CyclesTest(filepath) for filepath in filepaths] + \
+        [CyclesWavefrontTest(filepath) for filepath in filepaths]
@@ -0,0 +1,157 @@
+# SPDX-FileCopyrightText: 2025 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+
+def prepare_cloth_scene(resolution: int, use_self_collision: bool):
+    """
+    Create a subdivided plane falling onto a sphere, a standard setup for cloth
+    solver benchmarks.
+    """
+    import bpy
+
+    for ob in list(bpy.data.objects):
+        bpy.data.objects.remove(ob)
+
+    bpy.ops.mesh.primitive_grid_add(
+        x_subdivisions=resolution,
+        y_subdivisions=resolution,
+        size=2.0,
+        location=(0.0, 0.0, 1.0))
+    cloth = bpy.context.object
+    md = cloth.modifiers.new("Cloth", 'CLOTH')
+    md.settings.quality = 5
+    md.collision_settings.use_collision = True
+    md.collision_settings.use_self_collision = use_self_collision
+
+    bpy.ops.mesh.primitive_uv_sphere_add(radius=0.6, location=(0.0, 0.0, 0.0))
+    collider = bpy.context.object
+    collider.modifiers.new("Collision", 'COLLISION')
+
+    return md
+
+
+def _run_cloth(args: dict):
+    import bpy
+    import time
+
+    md = prepare_cloth_scene(args['resolution'], args['use_self_collision'])
+    scene = bpy.context.scene
+    num_frames = args['num_frames']
+    scene.frame_start = 1
+    scene.frame_end = num_frames
+    md.point_cache.frame_start = 1
+    md.point_cache.frame_end = num_frames
+
+    scene.frame_set(1)
+    start_time = time.time()
+    for frame in range(2, num_frames + 1):
+        scene.frame_set(frame)
+    elapsed_time = time.time() - start_time
+
+    result = {'time': elapsed_time / (num_frames - 1)}
+    return result
+
+
+class ClothTest(api.Test):
+    def __init__(self, resolution: int, num_frames: int, use_self_collision: bool):
+        self.resolution = resolution
+        self.num_frames = num_frames
+        self.use_self_collision = use_self_collision
+
+    def name(self):
+        if self.use_self_collision:
+            return "cloth_grid_{}_self_collision".format(self.resolution)
+        return "cloth_grid_{}".format(self.resolution)
+
+    def category(self):
+        return "physics"
+
+    def run(self, env, _device_id):
+        args = {
+            "resolution": self.resolution,
+            "num_frames": self.num_frames,
+            "use_self_collision": self.use_self_collision,
+        }
+        result, _ = env.run_in_blender(_run_cloth, args)
+        return result
+
+
+def prepare_hair_scene(num_strands: int):
+    """
+    Create a sphere with dynamic hair, using the hair volume grid for
+    internal friction and density preservation.
+    """
+    import bpy
+
+    for ob in list(bpy.data.objects):
+        bpy.data.objects.remove(ob)
+
+    bpy.ops.mesh.primitive_uv_sphere_add(radius=1.0, location=(0.0, 0.0, 0.0))
+    ob = bpy.context.object
+    md = ob.modifiers.new("Hair", 'PARTICLE_SYSTEM')
+    psys = md.particle_system
+    psys.settings.type = 'HAIR'
+    psys.settings.count = num_strands
+    psys.settings.hair_step = 8
+    psys.settings.hair_length = 1.0
+
+    psys.use_hair_dynamics = True
+    cloth_settings = psys.cloth.settings
+    cloth_settings.internal_friction = 0.5
+    cloth_settings.density_strength = 0.5
+    cloth_settings.voxel_cell_size = 0.05
+
+    return psys
+
+
+def _run_hair(args: dict):
+    import bpy
+    import time
+
+    psys = prepare_hair_scene(args['num_strands'])
+    scene = bpy.context.scene
+    num_frames = args['num_frames']
+    scene.frame_start = 1
+    scene.frame_end = num_frames
+    psys.point_cache.frame_start = 1
+    psys.point_cache.frame_end = num_frames
+
+    scene.frame_set(1)
+    start_time = time.time()
+    for frame in range(2, num_frames + 1):
+        scene.frame_set(frame)
+    elapsed_time = time.time() - start_time
+
+    result = {'time': elapsed_time / (num_frames - 1)}
+    return result
+
+
+class HairTest(api.Test):
+    def __init__(self, num_strands: int, num_frames: int):
+        self.num_strands = num_strands
+        self.num_frames = num_frames
+
+    def name(self):
+        return "hair_dynamics_{}".format(self.num_strands)
+
+    def category(self):
+        return "physics"
+
+    def run(self, env, _device_id):
+        args = {
+            "num_strands": self.num_strands,
+            "num_frames": self.num_frames,
+        }
+        result, _ = env.run_in_blender(_run_hair, args)
+        return result
+
+
+def generate(env):
+    tests = [ClothTest(resolution, 30, use_self_collision)
+             for resolution in (100, 250)
+             for use_self_collision in (False, True)]
+    tests += [HairTest(num_strands, 20) for num_strands in (1000, 10000)]
+    return tests
@@ -10,6 +10,7 @@ import pathlib
 class SculptMode(enum.IntEnum):
     MESH = 1
     MULTIRES = 2
+    DYNTOPO = 3
 
 
 def set_view3d_context_override(context_override):
@@ -57,6 +58,8 @@ def prepare_sculpt_scene(context: any, mode: SculptMode):
 
     if mode == SculptMode.MULTIRES:
         size = 150
+    elif mode == SculptMode.DYNTOPO:
+        size = 500
     else:
         size = 1500
 
@@ -82,6 +85,8 @@ def prepare_sculpt_scene(context: any, mode: SculptMode):
 
     if mode == SculptMode.MULTIRES:
         bpy.ops.object.subdivision_set(level=3)
+    elif mode == SculptMode.DYNTOPO:
+        bpy.ops.sculpt.dynamic_topology_toggle()
 
 
 def generate_stroke(context):
@@ -173,4 +178,11 @@ class SculptBrushTest(api.Test):
 
 def generate(env):
     filepaths = env.find_blend_files('sculpt/*')
-    return [SculptBrushTest(filepath, mode) for filepath in filepaths for mode in SculptMode]
+    tests = []
+    for filepath in filepaths:
+        for mode in SculptMode:
+            # Dynamic topology strokes are slow, only run them for the files meant for it.
+            if mode == SculptMode.DYNTOPO and "dyntopo" not in filepath.stem:
+                continue
+            tests.append(SculptBrushTest(filepath, mode))
+    return tests